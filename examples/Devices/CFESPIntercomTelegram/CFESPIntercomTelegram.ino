@@ -1,5 +1,7 @@
 #include <ESP8266HTTPClient.h>
 #include <Logger.h>
+#include <CFLog.h>
+#include <CFWatchdog.h>
 #include <CFWiFiManagerHelper.h>
 
 WiFiClientSecure wifiClient;
@@ -31,6 +33,9 @@ void setup() {
   Serial.begin(115200);
   Logger::setLogLevel(Logger::VERBOSE);  // VERBOSE, NOTICE, WARNING, ERROR, FATAL, SILENT.
 
+  // Record blocking sections, to know what was running if the device is reset.
+  CFWatchdog::begin();
+
   // Config WiFiManager.
   _cfWiFiManager.setCustomParameters(_params, CF_WM_MAX_PARAMS_QTY);
   _cfWiFiManager.setOnSaveParametersCallback(onSaveParametersCallback);
@@ -41,6 +46,7 @@ void setup() {
 }
 
 void loop() {
+  CFWatchdog::loop();
   _cfWiFiManager.loop();
   if (millis() < lastRead || millis() - lastRead > READ_DELAY) {
     lastRead = millis();
@@ -51,13 +57,16 @@ void loop() {
         Logger::notice("Voltage change indentified. Sending notification.");
         wifiClient.setInsecure();
         https.begin(wifiClient, webhookURL);
-        int httpCode = https.GET();
+        int httpCode;
+        {
+          CF_WATCHDOG_SECTION("https_get");
+          httpCode = https.GET();
+        }
         if (httpCode == HTTP_CODE_OK) {
-          String payload = https.getString();
           Logger::notice("A notification has been sent.");
-          Logger::notice("[HTTPS] Received payload telegram: " + payload);
+          CF_LOG_NOTICE("[HTTPS] Received payload telegram: %s", https.getString().c_str());  // Only read if it's logged.
         } else {
-          Logger::notice("Sending notification has failed. Error: " + String(httpCode) + " (" + webhookURL + ")");
+          CF_LOG_NOTICE("Sending notification has failed. Error: %d (%s)", httpCode, webhookURL);
         }
         https.end();
       }
@@ -22,7 +22,10 @@
  */
 
 // Libraries.
+#include <CFDeviceState.h>        // CF Device State.
+#include <CFJsonArena.h>          // CF JSON Arena.
 #include <CFThingsBoardHelper.h>  // CF ThingsBoard Helper.
+#include <CFWatchdog.h>           // CF Watchdog.
 #include <CFWiFiManagerHelper.h>  // CF WiFiManager Helper.
 #include <Logger.h>               // Logger.
 #include <fauxmoESP.h>            // Alexa FauxmoESP.
@@ -36,10 +39,11 @@ CFWiFiManagerHelper _cfWiFiManager(3000);                   // CF WiFiManager He
 CFThingsBoardHelper _cfThingsBoard(APP_CODE, APP_VERSION);  // CF WiFiManager Helper.
 
 // WiFiManager parameters.
-#define CF_WM_MAX_PARAMS_QTY 3
+#define CF_WM_MAX_PARAMS_QTY 4
 WiFiManagerParameter _params[] = {{"p_device_name", "Device Name", _cfWiFiManager.getDefaultSSID().c_str(), 50},
                                   {"p_server_url", "Server URL", "", 50},
-                                  {"p_server_token", "Token", "", 50}};
+                                  {"p_server_token", "Token", "", 50},
+                                  {"p_state_api_key", "Local API Key", "", 50}};
 
 // Alexa FauxmoESP.
 fauxmoESP _fauxmo;
@@ -47,13 +51,14 @@ fauxmoESP _fauxmo;
 // Device pins.
 #define PIN_RELAY 0  // ESP-01 GPIO0.
 
-// Device attributes.
-bool _value = false;
+// Device state, synced to the relay, ThingsBoard and Alexa.
+CFDeviceState _state;
+int _value = _state.addBool("value", false, CFDeviceState::SINK_LOCAL | CFDeviceState::SINK_TELEMETRY | CFDeviceState::SINK_ALEXA);
 
 void setup() {
   // Config relay pin as output.
   pinMode(PIN_RELAY, OUTPUT);
-  updateRelay(_value);
+  updateRelay(_state.getBool(_value));
 
   // Setup Serial.
   Serial.begin(115200);
@@ -61,10 +66,22 @@ void setup() {
   // Setup logger.
   Logger::setLogLevel(Logger::NOTICE);  // VERBOSE, NOTICE, WARNING, ERROR, FATAL, SILENT.
 
+  // Record blocking sections, the last boot report is sent to ThingsBoard.
+  CFWatchdog::begin();
+
   // Config WiFiManager.
   _cfWiFiManager.setCustomParameters(_params, CF_WM_MAX_PARAMS_QTY);
   _cfWiFiManager.setOnSaveParametersCallback(onSaveParametersCallback);
   _cfWiFiManager.setOnConfigModeCallback(onConfigModeCallback);
+
+  // Serve state, telemetry, attributes and metrics on the custom port (http://<ip>:3000/api/...).
+  _cfWiFiManager.setDeviceState(&_state);
+  _cfWiFiManager.addRESTResource("telemetry", [](JsonObject data) { _cfThingsBoard.getTelemetry(data); });
+  _cfWiFiManager.addRESTResource("attributes", [](JsonObject data) { _cfThingsBoard.getAttributes(data); });
+  _cfWiFiManager.addRESTResource("metrics", [](JsonObject data) {
+    _cfThingsBoard.getMetrics(data);
+    CFJsonArena::getReport(data);
+  });
   _cfWiFiManager.begin();
 
   // Call the callback once to update the first time.
@@ -73,6 +90,9 @@ void setup() {
   // Config ThingsBoard.
   _cfThingsBoard.setLocalIP(_cfWiFiManager.getLocalIP());
   _cfThingsBoard.setOnThingsBoardConnectCallback(onThingsBoardConnectCallback);
+  _cfThingsBoard.setTransport(CFMQTTClient::QUEUED);  // Never wait for the network in loop().
+  _cfThingsBoard.setPersistentSession(true);          // Keep subscriptions across reconnections.
+  _cfThingsBoard.setTelemetryDeadband("value", 1, 0, 600000);  // Send relay changes right away, otherwise every 10 minutes.
 
   Logger::notice(_cfWiFiManager.getParameter("p_device_name").c_str());  // REMOVE
 
@@ -84,12 +104,14 @@ void setup() {
   _fauxmo.onSetState([](unsigned char device_id, const char* device_name, bool state, unsigned char value) {
     onAlexaStatusChangeCallback(device_id, device_name, state, value);
   });
+
+  // Log the JSON memory each helper needed to boot.
+  CFJsonArena::logReport();
 }
 
 void loop() {
-  // Add a telemetry data to be sent to ThingsBoard.
-  _cfThingsBoard.setTelemetryValue("value", _value);
-
+  CFWatchdog::loop();     // Do watchdog loop.
+  syncState();            // Push state changes to the relay, ThingsBoard and Alexa.
   _cfWiFiManager.loop();  // Do WiFiManager loop.
   _cfThingsBoard.loop();  // Do ThingsBoard loop.
   _fauxmo.handle();       // Do Alexa FauxmoESP loop.
@@ -109,12 +131,34 @@ void onSaveParametersCallback() {
   Logger::notice("On save parameters callback called.");
   _cfThingsBoard.setServerURL(_cfWiFiManager.getParameter("p_server_url"));
   _cfThingsBoard.setToken(_cfWiFiManager.getParameter("p_server_token"));
+  _cfWiFiManager.setStateApiKey(_cfWiFiManager.getParameter("p_state_api_key"));  // Allows switching the relay at /api/state, empty to keep it read-only.
   _cfThingsBoard.setAttributeValue("attr_device_name", _cfWiFiManager.getParameter("p_device_name"));
 }
 
-void updateRelay(bool value) {
-  _value = value;
+/**
+ * Push state changes to where they are needed. Each one only gets what changed since it last did.
+ */
+void syncState() {
+  // Relay.
+  if (_state.isDirty(_value, CFDeviceState::SINK_LOCAL)) {
+    updateRelay(_state.getBool(_value));
+    _state.clear(_value, CFDeviceState::SINK_LOCAL);
+  }
+
+  // ThingsBoard telemetry.
+  StaticJsonDocument<64> changes;
+  if (_state.pull(CFDeviceState::SINK_TELEMETRY, changes.to<JsonObject>()) > 0) {
+    _cfThingsBoard.setTelemetryValues(changes.as<JsonObjectConst>());
+  }
+
+  // Alexa.
+  if (_state.isDirty(_value, CFDeviceState::SINK_ALEXA)) {
+    _fauxmo.setState(_cfWiFiManager.getParameter("p_device_name").c_str(), _state.getBool(_value), 254);
+    _state.clear(_value, CFDeviceState::SINK_ALEXA);
+  }
+}
 
+void updateRelay(bool value) {
   // Normally Open configuration, send LOW signal to let current flow.
   digitalWrite(PIN_RELAY, value ? LOW : HIGH);
 
@@ -128,12 +172,8 @@ void updateRelay(bool value) {
 void onAlexaStatusChangeCallback(unsigned char device_id, const char* device_name, bool state, unsigned char value) {
   Serial.printf("[NOTICE] Device #%d (%s) state: %s value: %d\n", device_id, device_name, state ? "ON" : "OFF", value);
 
-  // Update value.
-  updateRelay(state);
-
-  // Update value on ThingsBoard.
-  _cfThingsBoard.setTelemetryValue("value", state);
-  _cfThingsBoard.sendData();
+  // Update value, Alexa already knows it.
+  _state.setBool(_value, state, CFDeviceState::SINK_ALEXA);
 }
 
 /**
@@ -141,7 +181,7 @@ void onAlexaStatusChangeCallback(unsigned char device_id, const char* device_nam
  */
 RPC_Response getValueRPCCallback(const RPC_Data& data) {
   // Return value.
-  return RPC_Response(NULL, _value);
+  return RPC_Response(NULL, _state.getBool(_value));
 }
 
 /**
@@ -150,11 +190,8 @@ RPC_Response getValueRPCCallback(const RPC_Data& data) {
 RPC_Response setValueRPCCallback(const RPC_Data& data) {
   bool value = data["value"];
 
-  // Update value.
-  updateRelay(value);
-
-  // Update Alexa.
-  _fauxmo.setState(_cfWiFiManager.getParameter("p_device_name").c_str(), value, 254);
+  // Update value, the relay, ThingsBoard and Alexa get it on the next sync.
+  _state.setBool(_value, value);
 
   // Return value.
   return RPC_Response(NULL, value);
@@ -0,0 +1,50 @@
+/**
+ * CF DHT Array Example.
+ *
+ * An example of using the CF DHT array with several sensors sharing the same reset pin.
+ * The snapshot can be sent to ThingsBoard in one message with CFThingsBoardHelper::setTelemetryValues.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+// Include the sensor library.
+#include <CFDHTArray.h>   // CF DHT array.
+#include <CFDHTHelper.h>  // CF DHT sensor.
+#include <Logger.h>       // Logger.
+
+// DHT Pins.
+#define PIN_DHT_RESET D8  // (GPIO15 / D8 - NodeMCU) DHT Pin VCC shared by all sensors (Workaround for DHT reading failure).
+
+// Create sensor objects, without reset pin.
+#define DHT_SENSORS_QTY 3
+CFDHTHelper _sensors[] = {{DHT22, D5},   // (GPIO14 / D5 - NodeMCU) DHT Pin Data.
+                          {DHT22, D6},   // (GPIO12 / D6 - NodeMCU) DHT Pin Data.
+                          {DHT22, D7}};  // (GPIO13 / D7 - NodeMCU) DHT Pin Data.
+CFDHTArray dhtArray(_sensors, DHT_SENSORS_QTY, PIN_DHT_RESET);
+
+void setup() {
+  // Start serial.
+  Serial.begin(115200);
+
+  // Setup logger.
+  Logger::setLogLevel(Logger::NOTICE);  // VERBOSE, NOTICE, WARNING, ERROR, FATAL, SILENT.
+
+  // Config DHT array.
+  dhtArray.begin();
+  dhtArray.setReadingInterval(6000);  // Each sensor is read every 6 seconds, one sensor every 2 seconds.
+}
+
+void loop() {
+  dhtArray.loop();  // Do DHT array loop.
+
+  // Print read values.
+  StaticJsonDocument<512> snapshot;
+  dhtArray.getSnapshot(snapshot.to<JsonObject>());
+  serializeJson(snapshot, Serial);
+  Serial.println();
+
+  // Delay.
+  delay(1000);
+}
@@ -10,6 +10,7 @@
 
 // Include the sensor library.
 #include <CFDHTHelper.h>  // CF soil moisture sensor.
+#include <CFLog.h>        // CF Log.
 #include <Logger.h>       // Logger.
 
 // DHT Pins.
@@ -37,13 +38,21 @@ void loop() {
 
   // Print read values.
   if (dht.isRead()) {
-    Logger::notice("Humidity: " + String(dht.getHumidity()) +
-                   "%  Temperature: " + String(dht.getTemperatureC()) +
-                   "ºC " + String(dht.getTemperatureF()) +
-                   "ºF  Heat Index: " + String(dht.getHeatIndexC()) +
-                   "ºC " + String(dht.getHeatIndexF()) + "ºF");
+    CF_LOG_NOTICE("Humidity: %.1f%%  Temperature: %.1fºC %.1fºF  Heat Index: %.1fºC %.1fºF",
+                  dht.getHumidity(), dht.getTemperatureC(), dht.getTemperatureF(),
+                  dht.getHeatIndexC(), dht.getHeatIndexF());
   } else {
-    Logger::notice("Error reading values.");
+    CF_LOG_NOTICE("Error reading values. Failures: %lu Resets: %lu Mean recovery time: %lums",
+                  dht.getFailuresQty(), dht.getResetsQty(), dht.getMeanRecoveryTime());
+  }
+
+  // Print aggregates of the last minute, ready to be sent with CFThingsBoardHelper::setTelemetryValues.
+  if (dht.getTemperatureStats()->available()) {
+    StaticJsonDocument<256> aggregates;
+    dht.getTemperatureStats()->getSnapshot(aggregates.to<JsonObject>(), "temperature");
+    dht.getHumidityStats()->getSnapshot(aggregates.as<JsonObject>(), "humidity");
+    serializeJson(aggregates, Serial);
+    Serial.println();
   }
 
   // Delay.
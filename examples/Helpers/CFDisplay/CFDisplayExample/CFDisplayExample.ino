@@ -0,0 +1,52 @@
+/**
+ * CF Display Example.
+ *
+ * An example of using the CF display with a geometry known at compile time.
+ *
+ * The frame buffer is in the RAM reported at build time. The draw and send times are printed
+ * to compare with CFDisplayHelper on the same display.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+// Include the display library.
+#include <CFDisplay.h>  // CF Display.
+#include <CFLog.h>      // CF Log.
+#include <Logger.h>     // Logger.
+
+// Display address.
+#define DISPLAY_ADDRESS 0x3C  // SSD1306 I2C address (SDA D2 / SCL D1 - NodeMCU).
+
+// Create a display object.
+CFDisplay<128, 64> display(DISPLAY_ADDRESS);  // CF display 128x64.
+
+void setup() {
+  // Start serial.
+  Serial.begin(115200);
+
+  // Setup logger.
+  Logger::setLogLevel(Logger::NOTICE);  // VERBOSE, NOTICE, WARNING, ERROR, FATAL, SILENT.
+
+  // Config display.
+  display.begin();
+}
+
+void loop() {
+  // Draw.
+  unsigned long start = micros();
+  display.clearDisplay();
+  display.setCursor(0, 0);
+  display.printf("Uptime: %lus", millis() / 1000);
+  display.drawRect(0, 16, 128, 48, SSD1306_WHITE);
+  display.fillCircle(64, 40, (millis() / 100) % 20 + 1, SSD1306_INVERSE);
+  unsigned long drawTime = micros() - start;
+
+  // Send.
+  display.display();
+  CF_LOG_NOTICE("Draw time: %lu us  Frame time: %lu us", drawTime, display.getFrameTime());
+
+  // Delay.
+  delay(1000);
+}
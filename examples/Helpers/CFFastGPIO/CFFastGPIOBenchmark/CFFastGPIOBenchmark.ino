@@ -0,0 +1,80 @@
+/**
+ * CF Fast GPIO Benchmark.
+ *
+ * Prints the cost of a GPIO read and write through the Arduino core, CFFastGPIO and CFFastPin,
+ * in CPU cycles (80 or 160 per microsecond) and nanoseconds.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+// Include the GPIO library.
+#include <CFFastGPIO.h>  // CF Fast GPIO.
+
+// Benchmark pins.
+#define PIN_OUTPUT 5  // (GPIO5 / D1 - NodeMCU) Output pin, leave it unconnected.
+#define PIN_INPUT 4   // (GPIO4 / D2 - NodeMCU) Input pin.
+
+// Operations per measure.
+#define OPS_QTY 10000
+
+// Create the pins.
+CFFastGPIO _output(PIN_OUTPUT);     // Output pin given at run time.
+CFFastGPIO _input(PIN_INPUT);       // Input pin given at run time.
+CFFastPin<PIN_OUTPUT> _fastOutput;  // Output pin known at compile time.
+CFFastPin<PIN_INPUT> _fastInput;    // Input pin known at compile time.
+volatile bool _sink;                // Keeps the reads from being optimized away.
+
+void setup() {
+  // Start serial.
+  Serial.begin(115200);
+
+  // Config pins.
+  _output.setMode(OUTPUT);
+  _input.setMode(INPUT);
+}
+
+void loop() {
+  uint32_t start;
+
+  Serial.println("Operation               cycles/op   ns/op");
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < OPS_QTY; i++) digitalWrite(PIN_OUTPUT, i & 1);
+  printCost("digitalWrite", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < OPS_QTY; i++) _output.write(i & 1);
+  printCost("CFFastGPIO::write", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < OPS_QTY; i++) _fastOutput.write(i & 1);
+  printCost("CFFastPin::write", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < OPS_QTY; i++) _sink = digitalRead(PIN_INPUT);
+  printCost("digitalRead", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < OPS_QTY; i++) _sink = _input.read();
+  printCost("CFFastGPIO::read", ESP.getCycleCount() - start);
+
+  start = ESP.getCycleCount();
+  for (int i = 0; i < OPS_QTY; i++) _sink = _fastInput.read();
+  printCost("CFFastPin::read", ESP.getCycleCount() - start);
+
+  Serial.println();
+  delay(5000);
+}
+
+/**
+ * Print the cost of an operation.
+ *
+ * @param name Operation name.
+ * @param cycles Cycles spent on OPS_QTY operations.
+ */
+void printCost(const char *name, uint32_t cycles) {
+  Serial.printf("%-22s  %9.1f  %6.1f\n", name, (float)cycles / OPS_QTY,
+                (float)cycles * 1000 / ESP.getCpuFreqMHz() / OPS_QTY);
+}
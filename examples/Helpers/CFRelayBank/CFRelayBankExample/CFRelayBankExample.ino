@@ -0,0 +1,110 @@
+/**
+ * CF Relay Bank Example.
+ *
+ * A 16 channels relay board driven by two 74HC595 and controlled from ThingsBoard. Any number of
+ * channels changed by an RPC are written together with a single latch update on the next loop.
+ *
+ * RPC requests:
+ *    - getRelays: returns [true, false, ...].
+ *    - setRelays: {"0": true, "3": false, "5": 500} sets channels 0 and 3 and pulses channel 5 for 500 ms.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0.0
+ * @since   Oct, 2026
+ */
+
+// Libraries.
+#include <CFRPCRouter.h>          // CF RPC Router.
+#include <CFRelayBankHelper.h>    // CF Relay Bank Helper.
+#include <CFThingsBoardHelper.h>  // CF ThingsBoard Helper.
+#include <CFWiFiManagerHelper.h>  // CF WiFiManager Helper.
+#include <Logger.h>               // Logger.
+
+// Software info.
+#define APP_CODE "cf-iot-relay-bank-example"  // App code.
+#define APP_VERSION "1.0.0"                   // App version.
+
+// 74HC595 pins.
+#define PIN_DATA D7   // (GPIO13 / D7 - NodeMCU) 74HC595 DS.
+#define PIN_CLOCK D5  // (GPIO14 / D5 - NodeMCU) 74HC595 SHCP.
+#define PIN_LATCH D6  // (GPIO12 / D6 - NodeMCU) 74HC595 STCP.
+
+// CF Helpers.
+CFWiFiManagerHelper _cfWiFiManager(3000);                         // CF WiFiManager Helper.
+CFThingsBoardHelper _cfThingsBoard(APP_CODE, APP_VERSION);        // CF ThingsBoard Helper.
+CFRPCRouter _cfRPCRouter;                                         // CF RPC Router.
+CFRelayBankHelper _cfRelays(PIN_DATA, PIN_CLOCK, PIN_LATCH, 16);  // CF Relay Bank Helper.
+
+// For relays wired to GPIOs, each channel is written with a single register write.
+// const uint8_t _relayPins[] = {D1, D2, D5, D6};
+// CFRelayBankHelper _cfRelays(_relayPins, 4);
+
+// WiFiManager parameters.
+#define CF_WM_MAX_PARAMS_QTY 3
+WiFiManagerParameter _params[] = {{"p_device_name", "Device Name", _cfWiFiManager.getDefaultSSID().c_str(), 50},
+                                  {"p_server_url", "Server URL", "", 50},
+                                  {"p_server_token", "Token", "", 50}};
+
+void setup() {
+  // Config relays, all of them off.
+  _cfRelays.setActiveLow(true);  // Most relay modules are on with LOW.
+  _cfRelays.begin();
+
+  // Setup Serial.
+  Serial.begin(115200);
+
+  // Setup logger.
+  Logger::setLogLevel(Logger::NOTICE);  // VERBOSE, NOTICE, WARNING, ERROR, FATAL, SILENT.
+
+  // Config WiFiManager.
+  _cfWiFiManager.setCustomParameters(_params, CF_WM_MAX_PARAMS_QTY);
+  _cfWiFiManager.setOnSaveParametersCallback(onSaveParametersCallback);
+  _cfWiFiManager.setOnConfigModeCallback(onConfigModeCallback);
+  _cfWiFiManager.addRESTResource("metrics", [](JsonObject data) {
+    _cfThingsBoard.getMetrics(data);
+    _cfRelays.getMetrics(data);
+  });
+  _cfWiFiManager.begin();
+
+  // Call the callback once to update the first time.
+  onSaveParametersCallback();
+
+  // Config RPC router.
+  _cfRPCRouter.addRoute("getRelays", [](JsonVariantConst params, JsonVariant response) { _cfRelays.getRPC(params, response); });
+  _cfRPCRouter.addRoute("setRelays", [](JsonVariantConst params, JsonVariant response) { _cfRelays.setRPC(params, response); });
+  _cfRPCRouter.begin();
+
+  // Config ThingsBoard.
+  _cfThingsBoard.setLocalIP(_cfWiFiManager.getLocalIP());
+  _cfThingsBoard.setOnThingsBoardConnectCallback(onThingsBoardConnectCallback);
+}
+
+void loop() {
+  _cfWiFiManager.loop();  // Do WiFiManager loop.
+  _cfThingsBoard.loop();  // Do ThingsBoard loop.
+  _cfRelays.loop();       // Do relays loop, after everything that may change them.
+}
+
+/**
+ * Callback to be called when Wi-Fi config mode is called.
+ */
+void onConfigModeCallback() {
+  Logger::notice("On config mode callback called.");
+}
+
+/**
+ * Callback to update parameters when they have been modified.
+ */
+void onSaveParametersCallback() {
+  Logger::notice("On save parameters callback called.");
+  _cfThingsBoard.setServerURL(_cfWiFiManager.getParameter("p_server_url"));
+  _cfThingsBoard.setToken(_cfWiFiManager.getParameter("p_server_token"));
+  _cfThingsBoard.setAttributeValue("attr_device_name", _cfWiFiManager.getParameter("p_device_name"));
+}
+
+/**
+ * Callback to subscribe to ThingsBoard RPC.
+ */
+void onThingsBoardConnectCallback() {
+  _cfThingsBoard.RPCSubscribe(_cfRPCRouter);
+}
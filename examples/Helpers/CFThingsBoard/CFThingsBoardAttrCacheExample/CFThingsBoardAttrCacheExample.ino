@@ -0,0 +1,86 @@
+/**
+ * CF ThingsBoard usage example with shared attributes cached in flash.
+ *
+ * The last shared attributes received are applied at boot, before Wi-Fi connects. Add a shared
+ * attribute "attr_version" to the device and bump it whenever the others change, so a reconnection
+ * only checks it instead of fetching them all.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0.0
+ * @since   Oct, 2026
+ */
+
+// Libraries.
+#include <CFAttributeCache.h>     // CF Attribute Cache.
+#include <CFThingsBoardHelper.h>  // CF ThingsBoard Helper.
+#include <CFWiFiManagerHelper.h>  // CF WiFiManager Helper.
+#include <Logger.h>               // Logger.
+
+// Software info.
+#define APP_CODE "cf-iot-thingsboard-attr-cache-example"  // App code.
+#define APP_VERSION "1.0.0"                               // App version.
+
+// CF Helpers.
+CFWiFiManagerHelper _cfWiFiManager(3000);                   // CF WiFiManager Helper.
+CFThingsBoardHelper _cfThingsBoard(APP_CODE, APP_VERSION);  // CF ThingsBoard Helper.
+CFAttributeCache _cfAttributeCache;                         // CF Attribute Cache.
+
+// Values set by shared attributes.
+int _sendInterval = 60;  // Telemetry interval in seconds, "attr_send_interval".
+
+// WiFiManager parameters.
+#define CF_WM_MAX_PARAMS_QTY 3
+WiFiManagerParameter _params[] = {{"p_device_name", "Device Name", _cfWiFiManager.getDefaultSSID().c_str(), 50},
+                                  {"p_server_url", "Server URL", "", 50},
+                                  {"p_server_token", "Token", "", 50}};
+
+void setup() {
+  // Setup Serial.
+  Serial.begin(115200);
+
+  // Setup logger.
+  Logger::setLogLevel(Logger::NOTICE);  // VERBOSE, NOTICE, WARNING, ERROR, FATAL, SILENT.
+
+  // Apply the cached shared attributes before anything else.
+  _cfAttributeCache.begin(onAttributesCallback);
+
+  // Config WiFiManager.
+  _cfWiFiManager.setCustomParameters(_params, CF_WM_MAX_PARAMS_QTY);
+  _cfWiFiManager.setOnSaveParametersCallback(onSaveParametersCallback);
+  _cfWiFiManager.begin();
+
+  // Call the callback once to update the first time.
+  onSaveParametersCallback();
+
+  // Config ThingsBoard.
+  _cfThingsBoard.setLocalIP(_cfWiFiManager.getLocalIP());
+  _cfThingsBoard.setAttributeCache(&_cfAttributeCache);
+}
+
+void loop() {
+  // Add a telemetry data to be sent to ThingsBoard.
+  _cfThingsBoard.setTelemetryValue("send_interval", _sendInterval);
+
+  _cfWiFiManager.loop();  // Do WiFiManager loop.
+  _cfThingsBoard.loop();  // Do ThingsBoard loop.
+}
+
+/**
+ * Callback to update parameters when they have been modified.
+ */
+void onSaveParametersCallback() {
+  Logger::notice("On save parameters callback called.");
+  _cfThingsBoard.setServerURL(_cfWiFiManager.getParameter("p_server_url"));
+  _cfThingsBoard.setToken(_cfWiFiManager.getParameter("p_server_token"));
+  _cfThingsBoard.setAttributeValue("attr_device_name", _cfWiFiManager.getParameter("p_device_name"));
+}
+
+/**
+ * Callback called with the cached shared attributes at boot and with every change received.
+ */
+void onAttributesCallback(JsonObjectConst attributes) {
+  Logger::notice("Shared attributes applied.");
+  if (attributes.containsKey("attr_send_interval")) {
+    _sendInterval = attributes["attr_send_interval"];
+  }
+}
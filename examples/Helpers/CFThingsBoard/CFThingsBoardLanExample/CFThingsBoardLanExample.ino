@@ -0,0 +1,73 @@
+/**
+ * CF ThingsBoard LAN broadcast example.
+ *
+ * Telemetry sent to ThingsBoard is also broadcast to the local network over UDP multicast
+ * (239.255.67.70:47808), see CFLanPublisher.h for the frame format.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0.0
+ * @since   Oct, 2026
+ */
+
+// Libraries.
+#include <CFLanPublisher.h>       // CF LAN Publisher.
+#include <CFThingsBoardHelper.h>  // CF ThingsBoard Helper.
+#include <CFWiFiManagerHelper.h>  // CF WiFiManager Helper.
+#include <Logger.h>               // Logger.
+
+// Software info.
+#define APP_CODE "cf-iot-thingsboard-lan-example"  // App code.
+#define APP_VERSION "1.0.0"                        // App version.
+
+// CF Helpers.
+CFWiFiManagerHelper _cfWiFiManager(3000);                   // CF WiFiManager Helper.
+CFThingsBoardHelper _cfThingsBoard(APP_CODE, APP_VERSION);  // CF ThingsBoard Helper.
+CFLanPublisher _cfLanPublisher;                             // CF LAN Publisher.
+
+// WiFiManager parameters.
+#define CF_WM_MAX_PARAMS_QTY 3
+WiFiManagerParameter _params[] = {{"p_device_name", "Device Name", _cfWiFiManager.getDefaultSSID().c_str(), 50},
+                                  {"p_server_url", "Server URL", "", 50},
+                                  {"p_server_token", "Token", "", 50}};
+
+void setup() {
+  // Setup Serial.
+  Serial.begin(115200);
+
+  // Setup logger.
+  Logger::setLogLevel(Logger::NOTICE);  // VERBOSE, NOTICE, WARNING, ERROR, FATAL, SILENT.
+
+  // Config WiFiManager.
+  _cfWiFiManager.setCustomParameters(_params, CF_WM_MAX_PARAMS_QTY);
+  _cfWiFiManager.setOnSaveParametersCallback(onSaveParametersCallback);
+  _cfWiFiManager.begin();
+
+  // Call the callback once to update the first time.
+  onSaveParametersCallback();
+
+  // Config LAN publisher.
+  _cfLanPublisher.begin();
+
+  // Config ThingsBoard.
+  _cfThingsBoard.setLocalIP(_cfWiFiManager.getLocalIP());
+  _cfThingsBoard.setLanPublisher(&_cfLanPublisher);
+  _cfThingsBoard.setTelemetryDeadband("test", 1000, 0, 0);  // Send changes of at least 1 second right away.
+}
+
+void loop() {
+  // Add a telemetry data to be sent to ThingsBoard and the local network.
+  _cfThingsBoard.setTelemetryValue("test", millis());
+
+  _cfWiFiManager.loop();  // Do WiFiManager loop.
+  _cfThingsBoard.loop();  // Do ThingsBoard loop.
+}
+
+/**
+ * Callback to update parameters when they have been modified.
+ */
+void onSaveParametersCallback() {
+  Logger::notice("On save parameters callback called.");
+  _cfThingsBoard.setServerURL(_cfWiFiManager.getParameter("p_server_url"));
+  _cfThingsBoard.setToken(_cfWiFiManager.getParameter("p_server_token"));
+  _cfThingsBoard.setAttributeValue("attr_device_name", _cfWiFiManager.getParameter("p_device_name"));
+}
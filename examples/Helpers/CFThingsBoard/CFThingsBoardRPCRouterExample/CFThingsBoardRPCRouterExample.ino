@@ -0,0 +1,137 @@
+/**
+ * CF ThingsBoard usage example with RPC router.
+ *
+ * The router dispatches RPC requests through a perfect hash of the method names, so it's the way to go
+ * for devices with many RPC methods.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0.0
+ * @since   Oct, 2026
+ */
+
+// Libraries.
+#include <CFRPCRouter.h>          // CF RPC Router.
+#include <CFThingsBoardHelper.h>  // CF ThingsBoard Helper.
+#include <CFWiFiManagerHelper.h>  // CF WiFiManager Helper.
+#include <Logger.h>               // Logger.
+
+// Software info.
+#define APP_CODE "cf-iot-thingsboard-rpc-router-example"  // App code.
+#define APP_VERSION "1.0.0"                               // App version.
+
+// CF Helpers.
+CFWiFiManagerHelper _cfWiFiManager(3000);                   // CF WiFiManager Helper.
+CFThingsBoardHelper _cfThingsBoard(APP_CODE, APP_VERSION);  // CF WiFiManager Helper.
+CFRPCRouter _cfRPCRouter;                                   // CF RPC Router.
+
+// WiFiManager parameters.
+#define CF_WM_MAX_PARAMS_QTY 3
+WiFiManagerParameter _params[] = {{"p_device_name", "Device Name", _cfWiFiManager.getDefaultSSID().c_str(), 50},
+                                  {"p_server_url", "Server URL", "", 50},
+                                  {"p_server_token", "Token", "", 50}};
+
+// Device attributes.
+#define RELAYS_QTY 4
+bool _relays[RELAYS_QTY] = {false};
+
+void setup() {
+  // Setup Serial.
+  Serial.begin(115200);
+
+  // Setup logger.
+  Logger::setLogLevel(Logger::NOTICE);  // VERBOSE, NOTICE, WARNING, ERROR, FATAL, SILENT.
+
+  // Config WiFiManager.
+  _cfWiFiManager.setCustomParameters(_params, CF_WM_MAX_PARAMS_QTY);
+  _cfWiFiManager.setOnSaveParametersCallback(onSaveParametersCallback);
+  _cfWiFiManager.setOnConfigModeCallback(onConfigModeCallback);
+  _cfWiFiManager.begin();
+
+  // Call the callback once to update the first time.
+  onSaveParametersCallback();
+
+  // Config RPC router.
+  _cfRPCRouter.addRoute("getValue", getValueRPCHandler);
+  _cfRPCRouter.addRoute("setValue", setValueRPCHandler);
+  _cfRPCRouter.addRoute("getRelays", getRelaysRPCHandler);
+  _cfRPCRouter.addRoute("setRelays", setRelaysRPCHandler);
+  _cfRPCRouter.begin();
+
+  // Config ThingsBoard.
+  _cfThingsBoard.setLocalIP(_cfWiFiManager.getLocalIP());
+  _cfThingsBoard.setOnThingsBoardConnectCallback(onThingsBoardConnectCallback);
+}
+
+void loop() {
+  _cfWiFiManager.loop();  // Do WiFiManager loop.
+  _cfThingsBoard.loop();  // Do ThingsBoard loop.
+}
+
+/**
+ * Callback to be called when Wi-Fi config mode is called.
+ */
+void onConfigModeCallback() {
+  Logger::notice("On config mode callback called.");
+}
+
+/**
+ * Callback to update parameters when they have been modified.
+ */
+void onSaveParametersCallback() {
+  Logger::notice("On save parameters callback called.");
+  _cfThingsBoard.setServerURL(_cfWiFiManager.getParameter("p_server_url"));
+  _cfThingsBoard.setToken(_cfWiFiManager.getParameter("p_server_token"));
+  _cfThingsBoard.setAttributeValue("attr_device_name", _cfWiFiManager.getParameter("p_device_name"));
+}
+
+/**
+ * Handler to be called when receive getValue RPC call from ThingsBoard.
+ * Params: {"relay": 0}.
+ */
+void getValueRPCHandler(JsonVariantConst params, JsonVariant response) {
+  int relay = params["relay"] | 0;
+  if (relay >= 0 && relay < RELAYS_QTY) {
+    response.set(_relays[relay]);
+  }
+}
+
+/**
+ * Handler to be called when receive setValue RPC call from ThingsBoard.
+ * Params: {"relay": 0, "value": true}.
+ */
+void setValueRPCHandler(JsonVariantConst params, JsonVariant response) {
+  int relay = params["relay"] | 0;
+  if (relay >= 0 && relay < RELAYS_QTY) {
+    _relays[relay] = params["value"];
+    response.set(_relays[relay]);
+  }
+}
+
+/**
+ * Handler to be called when receive getRelays RPC call from ThingsBoard.
+ */
+void getRelaysRPCHandler(JsonVariantConst params, JsonVariant response) {
+  for (int i = 0; i < RELAYS_QTY; i++) {
+    response.add(_relays[i]);
+  }
+}
+
+/**
+ * Handler to be called when receive setRelays RPC call from ThingsBoard.
+ * Params: [true, false, ...].
+ */
+void setRelaysRPCHandler(JsonVariantConst params, JsonVariant response) {
+  int i = 0;
+  for (JsonVariantConst value : params.as<JsonArrayConst>()) {
+    if (i >= RELAYS_QTY) break;
+    _relays[i++] = value;
+  }
+  getRelaysRPCHandler(params, response);
+}
+
+/**
+ * Callback to subscribe to ThingsBoard RPC.
+ */
+void onThingsBoardConnectCallback() {
+  _cfThingsBoard.RPCSubscribe(_cfRPCRouter);
+}
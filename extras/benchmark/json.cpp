@@ -0,0 +1,373 @@
+/**
+ * json.cpp
+ *
+ * Host benchmark of the JSON paths that run on every submission and on every settings change, in the
+ * style of Google Benchmark: time and CPU per operation, plus the bytes and allocations it takes from
+ * the heap (every malloc is counted by the host core).
+ *   - serialize_json: serializeJson of a telemetry document, as CFThingsBoardHelper sends it;
+ *   - thingsboard_loop: a CFThingsBoardHelper::loop() that sends telemetry and the attributes, for
+ *     several attribute quantities, so the cost of the _attributes iteration is the slope;
+ *   - wifimanager_begin: CFWiFiManagerHelper::begin() with and without a parameters file, the
+ *     difference is _loadParameters;
+ *   - wifimanager_set_parameter: CFWiFiManagerHelper::setParameter(), that runs _saveParameters.
+ * ThingsBoard talks to a sink on a localhost socket, drained outside the timed part, as the portal
+ * files are kept in memory.
+ *
+ *   ./json [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>]
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <Arduino.h>              // Arduino library.
+#include <CFThingsBoardHelper.h>  // CF ThingsBoard.
+#include <CFWiFiManagerHelper.h>  // CF Wi-Fi Manager.
+#include <arpa/inet.h>            // Addresses.
+#include <chrono>                 // Wall time.
+#include <cstdio>                 // Output.
+#include <ctime>                  // CPU time.
+#include <fcntl.h>                // Non-blocking sockets.
+#include <functional>             // Benchmarks.
+#include <netinet/in.h>           // Internet sockets.
+#include <sys/socket.h>           // Sockets.
+#include <unistd.h>               // Close.
+#include <vector>                 // Buffers.
+
+#define TB_SEND_TIME 60000  // CFThingsBoardHelper time between submissions (ms).
+
+/**
+ * Running benchmark: iterations, and time and heap spent on them, not counting the paused parts.
+ */
+class State {
+ public:
+  explicit State(uint64_t iterations) : _iterations(iterations) {}
+
+  bool keepRunning() {
+    if (_done == 0) resumeTiming();
+    if (_done++ < _iterations) return true;
+    pauseTiming();
+    return false;
+  }
+  void pauseTiming() {
+    _wallTime += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - _wallStart).count();
+    _cpuTime += _cpu() - _cpuStart;
+    _allocatedBytes += ArduinoHost::getAllocatedBytes() - _bytesStart;
+    _allocationsQty += ArduinoHost::getAllocationsQty() - _allocationsStart;
+  }
+  void resumeTiming() {
+    _bytesStart = ArduinoHost::getAllocatedBytes();
+    _allocationsStart = ArduinoHost::getAllocationsQty();
+    _cpuStart = _cpu();
+    _wallStart = std::chrono::steady_clock::now();
+  }
+  uint64_t getIterations() const { return _iterations; }
+  double getWallTime() const { return _wallTime; }
+  double getCPUTime() const { return _cpuTime; }
+  uint64_t getAllocatedBytes() const { return _allocatedBytes; }
+  uint64_t getAllocationsQty() const { return _allocationsQty; }
+
+ private:
+  uint64_t _iterations;                              // Iterations to run.
+  uint64_t _done = 0;                                // Iterations started.
+  std::chrono::steady_clock::time_point _wallStart;  // Wall clock when timing resumed.
+  double _cpuStart = 0;                              // CPU clock when timing resumed (ns).
+  uint64_t _bytesStart = 0;                          // Bytes allocated when timing resumed.
+  uint64_t _allocationsStart = 0;                    // Allocations when timing resumed.
+  double _wallTime = 0;                              // Wall time (ns).
+  double _cpuTime = 0;                               // CPU time (ns).
+  uint64_t _allocatedBytes = 0;                      // Bytes allocated.
+  uint64_t _allocationsQty = 0;                      // Allocations.
+
+  static double _cpu() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+  }
+};
+
+/**
+ * Result of a benchmark, per iteration.
+ */
+struct Result {
+  double wallTime;     // Wall time (ns).
+  double cpuTime;      // CPU time (ns).
+  double bytes;        // Bytes allocated.
+  double allocations;  // Allocations.
+};
+
+static const char *filter = "";  // Benchmarks whose name has it are run.
+static double minTime = 0.5;     // Min time of the timed part (s).
+
+/**
+ * Keep a value from being optimized away.
+ */
+template <typename T>
+static void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Run a benchmark as Google Benchmark does: iterations grow until the timed part lasts the min time.
+ */
+static bool run(const char *name, std::function<void(State &)> benchmark, Result *result = NULL) {
+  if (!strstr(name, filter)) return false;
+  uint64_t iterations = 1;
+  while (true) {
+    State state(iterations);
+    benchmark(state);
+    double seconds = state.getWallTime() / 1e9;
+    if (seconds >= minTime || iterations >= 1000000000) {
+      Result r = {state.getWallTime() / iterations, state.getCPUTime() / iterations,
+                  (double)state.getAllocatedBytes() / iterations, (double)state.getAllocationsQty() / iterations};
+      printf("%-44s %10.0f ns %10.0f ns %10llu bytes_per_op=%-8.1f allocs_per_op=%.2f\n", name, r.wallTime,
+             r.cpuTime, (unsigned long long)iterations, r.bytes, r.allocations);
+      if (result) *result = r;
+      return true;
+    }
+    double multiplier = seconds > 0 ? minTime * 1.4 / seconds : 10;
+    iterations = (uint64_t)(iterations * min(max(multiplier, 2.0), 10.0));
+  }
+}
+
+/**
+ * Print the cost per unit of a benchmark run for several sizes, as Google Benchmark complexity rows.
+ */
+static void slope(const char *name, const char *unit, double n1, const Result &r1, double n2, const Result &r2) {
+  double n = n2 - n1;
+  printf("%-44s %10.0f ns %10.0f ns %10s bytes_per_op=%-8.1f allocs_per_op=%.2f (per %s)\n", name,
+         (r2.wallTime - r1.wallTime) / n, (r2.cpuTime - r1.cpuTime) / n, "", (r2.bytes - r1.bytes) / n,
+         (r2.allocations - r1.allocations) / n, unit);
+}
+
+/**
+ * ThingsBoard sink on a localhost socket, polled from the system task of the board. It answers CONNECT,
+ * SUBSCRIBE and PINGREQ and drops everything else.
+ */
+class Sink {
+ public:
+  uint16_t port = 0;  // Port listened.
+
+  bool begin() {
+    _listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (_listener < 0 || bind(_listener, (sockaddr *)&address, length) != 0 || listen(_listener, 4) != 0 ||
+        getsockname(_listener, (sockaddr *)&address, &length) != 0) {
+      return false;
+    }
+    fcntl(_listener, F_SETFL, O_NONBLOCK);
+    port = ntohs(address.sin_port);
+    return true;
+  }
+
+  void poll() {
+    if (_client < 0) {
+      _client = accept(_listener, NULL, NULL);
+      if (_client < 0) return;
+      fcntl(_client, F_SETFL, O_NONBLOCK);
+      _rx.clear();
+    }
+    uint8_t buffer[1024];
+    ssize_t length;
+    while ((length = recv(_client, buffer, sizeof(buffer), 0)) > 0) _rx.insert(_rx.end(), buffer, buffer + length);
+    if (length == 0) {
+      close(_client);
+      _client = -1;
+      return;
+    }
+    size_t position = 0;
+    while (true) {
+      // Fixed header: type and remaining length.
+      size_t remaining = 0, header = 1;
+      uint8_t shift = 0;
+      bool complete = false;
+      while (position + header < _rx.size() && !complete) {
+        remaining |= (size_t)(_rx[position + header] & 0x7F) << shift;
+        shift += 7;
+        complete = !(_rx[position + header++] & 0x80);
+      }
+      if (!complete || _rx.size() - position < header + remaining) break;
+      uint8_t type = _rx[position] >> 4;
+      const uint8_t *body = _rx.data() + position + header;
+      if (type == 1) {  // CONNECT.
+        uint8_t connack[] = {0x20, 0x02, 0x00, 0x00};
+        send(_client, connack, sizeof(connack), MSG_NOSIGNAL);
+      } else if (type == 8) {  // SUBSCRIBE.
+        uint8_t suback[] = {0x90, 0x03, body[0], body[1], 0x00};
+        send(_client, suback, sizeof(suback), MSG_NOSIGNAL);
+      } else if (type == 12) {  // PINGREQ.
+        uint8_t pingresp[] = {0xD0, 0x00};
+        send(_client, pingresp, sizeof(pingresp), MSG_NOSIGNAL);
+      }
+      position += header + remaining;
+    }
+    _rx.erase(_rx.begin(), _rx.begin() + position);
+  }
+
+ private:
+  int _listener = -1;        // Listening socket.
+  int _client = -1;          // Device socket, -1 if it isn't connected.
+  std::vector<uint8_t> _rx;  // Bytes received and not handled.
+};
+
+static Sink sink;
+
+/**
+ * Fill a telemetry document with DHT readings, as CFDHTArray sends them.
+ */
+static void fillTelemetry(JsonObject telemetry, int valuesQty) {
+  static const char *names[] = {"temperature", "humidity", "heat_index", "dew_point"};
+  char key[24];
+  for (int i = 0; i < valuesQty; i++) {
+    snprintf(key, sizeof(key), "%s_%d", names[i % 4], i / 4 + 1);
+    telemetry[key] = 21.5f + i * 1.25f;
+  }
+}
+
+/**
+ * serializeJson of a telemetry document into the payload buffer.
+ */
+static void serializeTelemetry(State &state, int valuesQty) {
+  DynamicJsonDocument telemetry(CF_TB_TELEMETRY_SIZE);
+  fillTelemetry(telemetry.to<JsonObject>(), valuesQty);
+  char payload[CF_TB_PAYLOAD_SIZE];
+  while (state.keepRunning()) {
+    size_t length = serializeJson(telemetry, payload);
+    doNotOptimize(length);
+    doNotOptimize(payload);
+  }
+}
+
+/**
+ * CFThingsBoardHelper::loop() on every submission: telemetry, then every attribute. The loop that
+ * reads the answer to the keep alive ping and the wait for the next submission aren't timed.
+ */
+static void thingsBoardLoop(State &state, int attributesQty) {
+  CFThingsBoardHelper *thingsBoard = new CFThingsBoardHelper("benchmark", "1.0");
+  thingsBoard->setServerURL("127.0.0.1");
+  thingsBoard->setServerPort(sink.port);
+  thingsBoard->setToken("benchmark");
+  DynamicJsonDocument telemetry(CF_TB_TELEMETRY_SIZE);
+  fillTelemetry(telemetry.to<JsonObject>(), 4);
+  thingsBoard->setTelemetryValues(telemetry.as<JsonObjectConst>());
+  char key[24];
+  for (int i = 0; i < attributesQty; i++) {
+    snprintf(key, sizeof(key), "attribute_%d", i);
+    if (i % 2 == 0) thingsBoard->setAttributeValue(key, i);
+    else thingsBoard->setAttributeValue(key, String("value ") + i);
+  }
+  for (int i = 0; i < 10 && !thingsBoard->isConnected(); i++) {
+    thingsBoard->loop();
+    delay(1);
+  }
+  if (!thingsBoard->isConnected()) {
+    printf("ThingsBoard didn't connect to the sink.\n");
+    exit(1);
+  }
+
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    delay(1);
+    thingsBoard->loop();
+    delay(TB_SEND_TIME);
+    state.resumeTiming();
+    thingsBoard->loop();
+  }
+  delete thingsBoard;
+}
+
+// Portal parameters.
+static WiFiManagerParameter parameters[] = {{"p_device_name", "Device Name", "benchmark", 50},
+                                            {"p_tb_server", "ThingsBoard Server", "thingsboard.cloud", 50},
+                                            {"p_tb_port", "ThingsBoard Port", "1883", 6},
+                                            {"p_tb_token", "ThingsBoard Token", "A1_TEST_TOKEN_0123456789", 32},
+                                            {"p_relay_1", "Relay 1", "Pump", 20},
+                                            {"p_relay_2", "Relay 2", "Fan", 20},
+                                            {"p_relay_3", "Relay 3", "Light", 20},
+                                            {"p_relay_4", "Relay 4", "Heater", 20}};
+
+/**
+ * CFWiFiManagerHelper::begin(), with the parameters file or without it.
+ */
+static void wifiManagerBegin(State &state, int parametersQty, bool withFile) {
+  CFWiFiManagerHelper *wifiManager = new CFWiFiManagerHelper();
+  wifiManager->setCustomParameters(parameters, parametersQty);
+  SPIFFS.format();
+  if (withFile) wifiManager->setParameter(parameters[0].getID(), "benchmark");
+  while (state.keepRunning()) {
+    wifiManager->begin();
+  }
+  delete wifiManager;
+}
+
+/**
+ * CFWiFiManagerHelper::setParameter(), that saves every parameter to the file.
+ */
+static void wifiManagerSetParameter(State &state, int parametersQty) {
+  CFWiFiManagerHelper *wifiManager = new CFWiFiManagerHelper();
+  wifiManager->setCustomParameters(parameters, parametersQty);
+  SPIFFS.format();
+  uint64_t i = 0;
+  while (state.keepRunning()) {
+    wifiManager->setParameter(parameters[parametersQty - 1].getID(), (i++ % 2) ? "Heater" : "Light");
+  }
+  delete wifiManager;
+}
+
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--benchmark_filter=", 19) == 0) {
+      filter = argv[i] + 19;
+    } else if (strncmp(argv[i], "--benchmark_min_time=", 21) == 0) {
+      minTime = atof(argv[i] + 21);
+    } else {
+      printf("Usage: json [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>]\n");
+      return 1;
+    }
+  }
+
+  // Quiet library, the board Serial is discarded.
+  Logger::setLogLevel(Logger::ERROR);
+  ArduinoHost::setSerialOutput(NULL);
+  if (!sink.begin()) {
+    printf("Could not listen on localhost.\n");
+    return 1;
+  }
+  ArduinoHost::setSystemTask([]() { sink.poll(); });
+
+  printf("%-44s %13s %13s %10s\n", "Benchmark", "Time", "CPU", "Iterations");
+  printf("%s\n", std::string(120, '-').c_str());
+  char name[64];
+  for (int valuesQty : {4, 8, 16}) {
+    snprintf(name, sizeof(name), "serialize_json/telemetry/%d", valuesQty);
+    run(name, [valuesQty](State &state) { serializeTelemetry(state, valuesQty); });
+  }
+
+  const int attributesQty[] = {0, 4, 8, 16};
+  Result attributes[4];
+  bool attributesRun = true;
+  for (int i = 0; i < 4; i++) {
+    int qty = attributesQty[i];
+    snprintf(name, sizeof(name), "thingsboard_loop/attributes/%d", qty);
+    attributesRun &= run(name, [qty](State &state) { thingsBoardLoop(state, qty); }, &attributes[i]);
+  }
+  if (attributesRun) slope("thingsboard_loop/attributes_slope", "attribute", 0, attributes[0], 16, attributes[3]);
+
+  for (int parametersQty : {4, 8}) {
+    Result withFile, withoutFile;
+    snprintf(name, sizeof(name), "wifimanager_begin/no_file/%d", parametersQty);
+    bool beginRun = run(name, [parametersQty](State &state) { wifiManagerBegin(state, parametersQty, false); }, &withoutFile);
+    snprintf(name, sizeof(name), "wifimanager_begin/file/%d", parametersQty);
+    beginRun &= run(name, [parametersQty](State &state) { wifiManagerBegin(state, parametersQty, true); }, &withFile);
+    snprintf(name, sizeof(name), "wifimanager_begin/load_parameters/%d", parametersQty);
+    if (beginRun) slope(name, "load", 0, withoutFile, 1, withFile);
+  }
+  for (int parametersQty : {4, 8}) {
+    snprintf(name, sizeof(name), "wifimanager_set_parameter/%d", parametersQty);
+    run(name, [parametersQty](State &state) { wifiManagerSetParameter(state, parametersQty); });
+  }
+  return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * payload_codec.cpp
+ *
+ * Host benchmark of CFPayloadCodec: time to encode and bytes per sample, JSON against MessagePack,
+ * for the payloads the helpers actually send (DHT readings and aggregates, relay bank states).
+ *
+ * CFPayloadCodec only depends on ArduinoJson, so it's built straight from the library sources:
+ *
+ *   g++ -std=c++11 -O2 -I src -I <ArduinoJson>/src extras/benchmark/payload_codec.cpp \
+ *       src/CFPayloadCodec.cpp -o payload_codec && ./payload_codec [iterations]
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFPayloadCodec.h>  // CF Payload Codec.
+#include <chrono>            // Clock.
+#include <cstdio>            // Output.
+#include <cstdlib>           // Arguments.
+
+#define PAYLOAD_SIZE 256  // Default CF_TB_PAYLOAD_SIZE, samples over it are dropped on the device.
+
+typedef void (*Builder)(JsonObject sample, unsigned long i);  // Fill a sample, i makes values move.
+
+/**
+ * One DHT reading, as CFDHTArray::getSnapshot writes it.
+ */
+void buildDHT(JsonObject sample, unsigned long i) {
+  sample["temperature_1"] = 21.5f + (i % 40) / 10.0f;
+  sample["humidity_1"] = 48.0f + (i % 90) / 10.0f;
+  sample["heat_index_1"] = 21.3f + (i % 45) / 10.0f;
+}
+
+/**
+ * Four DHT readings.
+ */
+void buildDHTArray(JsonObject sample, unsigned long i) {
+  char key[24];
+  for (int s = 1; s <= 4; s++) {
+    sprintf(key, "temperature_%d", s);
+    sample[key] = 20.0f + s + (i % 40) / 10.0f;
+    sprintf(key, "humidity_%d", s);
+    sample[key] = 45.0f + s + (i % 90) / 10.0f;
+    sprintf(key, "heat_index_%d", s);
+    sample[key] = 19.8f + s + (i % 45) / 10.0f;
+  }
+}
+
+/**
+ * Aggregates of a minute of temperature and humidity, as CFRollingStats::getSnapshot writes them.
+ */
+void buildDHTStats(JsonObject sample, unsigned long i) {
+  sample["temperature_mean"] = 22.4f + (i % 40) / 10.0f;
+  sample["temperature_min"] = 21.9f + (i % 40) / 10.0f;
+  sample["temperature_max"] = 23.1f + (i % 40) / 10.0f;
+  sample["temperature_variance"] = 0.12f + (i % 10) / 100.0f;
+  sample["humidity_mean"] = 51.2f + (i % 90) / 10.0f;
+  sample["humidity_min"] = 49.8f + (i % 90) / 10.0f;
+  sample["humidity_max"] = 52.6f + (i % 90) / 10.0f;
+  sample["humidity_variance"] = 0.84f + (i % 10) / 100.0f;
+}
+
+/**
+ * An 8 channel relay bank: the state of every channel and the bit mask.
+ */
+void buildRelayBank(JsonObject sample, unsigned long i) {
+  char key[12];
+  uint8_t state = i * 37;
+  for (int c = 0; c < 8; c++) {
+    sprintf(key, "relay_%d", c);
+    sample[key] = (state >> c & 1) == 1;
+  }
+  sample["relays_state"] = state;
+}
+
+/**
+ * Check that a payload decodes back to the values of a sample, as floats since that's what they were.
+ */
+bool isRoundTrip(JsonDocument &doc, const uint8_t *payload, size_t length, JsonDocument &decoded) {
+  if (CFPayloadCodec::decode(payload, length, decoded) || decoded.size() != doc.size()) return false;
+  for (JsonPair p : doc.as<JsonObject>()) {
+    if (decoded[p.key()].as<float>() != p.value().as<float>()) return false;
+  }
+  return true;
+}
+
+/**
+ * Encode a sample over and over, and print time and size.
+ */
+void run(const char *name, Builder build, unsigned long iterations) {
+  StaticJsonDocument<1024> doc;
+  StaticJsonDocument<1024> decoded;
+  uint8_t payload[1024];
+  CFPayloadCodec::Encoding encodings[] = {CFPayloadCodec::JSON, CFPayloadCodec::MSGPACK};
+  const char *encodingNames[] = {"json", "msgpack"};
+  unsigned long jsonBytes = 0;
+
+  for (int e = 0; e < 2; e++) {
+    unsigned long long bytes = 0;
+    unsigned long long nanos = 0;
+    size_t values = 0;
+    size_t maxLength = 0;
+    for (unsigned long i = 0; i < iterations; i++) {
+      doc.clear();
+      build(doc.to<JsonObject>(), i);
+      values = doc.size();
+      auto start = std::chrono::steady_clock::now();
+      size_t length = CFPayloadCodec::encode(doc, payload, sizeof(payload), encodings[e]);
+      nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+      if (length == 0) {
+        printf("%-14s %-8s doesn't fit in %u bytes\n", name, encodingNames[e], (unsigned)sizeof(payload));
+        return;
+      }
+      bytes += length;
+      if (length > maxLength) maxLength = length;
+
+      // Every payload must come back as the values it was encoded from.
+      if (i == 0 && !isRoundTrip(doc, payload, length, decoded)) {
+        printf("%-14s %-8s round trip failed\n", name, encodingNames[e]);
+        exit(1);
+      }
+    }
+    double bytesPerSample = (double)bytes / iterations;
+    if (e == 0) jsonBytes = bytes;
+    printf("%-14s %-8s %8.1f ns/op %7.1f bytes/sample %5.1f bytes/value %5.0f%% %s\n", name, encodingNames[e],
+           (double)nanos / iterations, bytesPerSample, bytesPerSample / values, 100.0 * bytes / jsonBytes,
+           maxLength < PAYLOAD_SIZE ? "fits" : "too big");
+  }
+}
+
+int main(int argc, char **argv) {
+  unsigned long iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+  printf("%lu iterations, size relative to JSON, fits if every sample is under %d bytes.\n", iterations, PAYLOAD_SIZE);
+  run("dht", buildDHT, iterations);
+  run("dht_array_4", buildDHTArray, iterations);
+  run("dht_stats", buildDHTStats, iterations);
+  run("relay_bank_8", buildRelayBank, iterations);
+  return 0;
+}
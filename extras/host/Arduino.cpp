@@ -0,0 +1,290 @@
+/**
+ * Arduino.cpp
+ *
+ * Host stand-in for the Arduino core, so the library sources build with g++ for the programs in
+ * extras. Only what the library uses is here.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <Arduino.h>  // Arduino library.
+#include <malloc.h>   // Allocation sizes.
+
+// Allocator of the C library, under the counting one below (glibc).
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+}
+
+ArduinoHost::Board ArduinoHost::_defaultBoard;
+ArduinoHost::Board *ArduinoHost::_board = &ArduinoHost::_defaultBoard;
+std::function<void()> ArduinoHost::_systemTask;
+FILE *ArduinoHost::_serialOutput = stdout;
+size_t ArduinoHost::_heapUsed = 0;
+size_t ArduinoHost::_heapPeak = 0;
+uint64_t ArduinoHost::_allocationsQty = 0;
+uint64_t ArduinoHost::_allocatedBytes = 0;
+
+const String emptyString;
+HardwareSerial Serial;
+EspClass ESP;
+
+/**
+ * Run the sketch on a board, from now on the core reads and writes its clock, pins and memory.
+ *
+ * @param board Board, NULL for the default one.
+ */
+void ArduinoHost::select(Board *board) {
+  _board = board ? board : &_defaultBoard;
+}
+
+/**
+ * Get the board the sketch runs on.
+ */
+ArduinoHost::Board *ArduinoHost::getBoard() {
+  return _board;
+}
+
+/**
+ * Get virtual time of the board.
+ *
+ * @returns Time since boot in microseconds, it never wraps.
+ */
+uint64_t ArduinoHost::getTime() {
+  return _board->time;
+}
+
+/**
+ * Move the board clock forward.
+ *
+ * @param us Microseconds.
+ */
+void ArduinoHost::advance(uint64_t us) {
+  _board->time += us;
+}
+
+/**
+ * Define the task run on yield() and delay(), where a program plays what's around the board.
+ *
+ * @param task Task, empty for none.
+ */
+void ArduinoHost::setSystemTask(std::function<void()> task) {
+  _systemTask = task;
+}
+
+/**
+ * Run the system task. Nothing is done if it's the task that yields on this board.
+ */
+void ArduinoHost::runSystemTask() {
+  Board *board = _board;
+  if (!_systemTask || board->inSystemTask) return;
+  board->inSystemTask = true;
+  _systemTask();
+  board->inSystemTask = false;
+}
+
+/**
+ * Drive a pin from outside the board, e.g. a sensor or a module wired to it.
+ *
+ * @param pin Pin.
+ * @param level HIGH or LOW.
+ */
+void ArduinoHost::setPin(uint8_t pin, uint8_t level) {
+  if (pin < ARDUINO_HOST_PINS) _board->levels[pin] = level;
+}
+
+/**
+ * Get a pin level.
+ *
+ * @param pin Pin.
+ * @returns HIGH or LOW, LOW for pins that don't exist.
+ */
+uint8_t ArduinoHost::getPin(uint8_t pin) {
+  return pin < ARDUINO_HOST_PINS ? _board->levels[pin] : LOW;
+}
+
+/**
+ * Define where Serial writes.
+ *
+ * @param output Output, NULL to discard it.
+ */
+void ArduinoHost::setSerialOutput(FILE *output) {
+  _serialOutput = output;
+}
+
+/**
+ * Get where Serial writes.
+ */
+FILE *ArduinoHost::getSerialOutput() {
+  return _serialOutput;
+}
+
+/**
+ * Get bytes allocated and not freed, as the allocator rounds them.
+ */
+size_t ArduinoHost::getHeapUsed() {
+  return _heapUsed;
+}
+
+/**
+ * Get max bytes allocated at once.
+ */
+size_t ArduinoHost::getHeapPeak() {
+  return _heapPeak;
+}
+
+/**
+ * Start the peak over from the current use, to measure the peak of a section.
+ */
+void ArduinoHost::resetHeapPeak() {
+  _heapPeak = _heapUsed;
+}
+
+/**
+ * Get allocations made since the start.
+ */
+uint64_t ArduinoHost::getAllocationsQty() {
+  return _allocationsQty;
+}
+
+/**
+ * Get bytes allocated in total since the start.
+ */
+uint64_t ArduinoHost::getAllocatedBytes() {
+  return _allocatedBytes;
+}
+
+/**
+ * Count an allocation.
+ *
+ * @param size Bytes.
+ */
+void ArduinoHost::countAllocation(size_t size) {
+  _heapUsed += size;
+  if (_heapUsed > _heapPeak) _heapPeak = _heapUsed;
+  _allocationsQty++;
+  _allocatedBytes += size;
+}
+
+/**
+ * Count a release.
+ *
+ * @param size Bytes.
+ */
+void ArduinoHost::countRelease(size_t size) {
+  _heapUsed -= size;
+}
+
+// Counting allocator, every malloc of the program goes through it.
+extern "C" {
+void *malloc(size_t size) {
+  void *ptr = __libc_malloc(size);
+  if (ptr) ArduinoHost::countAllocation(malloc_usable_size(ptr));
+  return ptr;
+}
+
+void *calloc(size_t count, size_t size) {
+  void *ptr = __libc_calloc(count, size);
+  if (ptr) ArduinoHost::countAllocation(malloc_usable_size(ptr));
+  return ptr;
+}
+
+void *realloc(void *ptr, size_t size) {
+  size_t previous = ptr ? malloc_usable_size(ptr) : 0;
+  void *moved = __libc_realloc(ptr, size);
+  if (moved || size == 0) {
+    ArduinoHost::countRelease(previous);
+    if (moved) ArduinoHost::countAllocation(malloc_usable_size(moved));
+  }
+  return moved;
+}
+
+void free(void *ptr) {
+  if (ptr) ArduinoHost::countRelease(malloc_usable_size(ptr));
+  __libc_free(ptr);
+}
+}
+
+uint32_t millis() {
+  return (uint32_t)(ArduinoHost::getTime() / 1000);
+}
+
+uint32_t micros() {
+  return (uint32_t)ArduinoHost::getTime();
+}
+
+void delay(unsigned long ms) {
+  ArduinoHost::advance((uint64_t)ms * 1000);
+  ArduinoHost::runSystemTask();
+}
+
+void delayMicroseconds(unsigned int us) {
+  ArduinoHost::advance(us);
+}
+
+void yield() {
+  ArduinoHost::runSystemTask();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= ARDUINO_HOST_PINS) return;
+  ArduinoHost::getBoard()->modes[pin] = mode;
+  if (mode == INPUT_PULLUP) ArduinoHost::getBoard()->levels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin >= ARDUINO_HOST_PINS) return;
+  ArduinoHost::Board *board = ArduinoHost::getBoard();
+  board->levels[pin] = value ? HIGH : LOW;
+  if (board->onPinWrite) board->onPinWrite(pin, board->levels[pin]);
+}
+
+int digitalRead(uint8_t pin) {
+  return ArduinoHost::getPin(pin);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  FILE *output = ArduinoHost::getSerialOutput();
+  return output ? fwrite(buffer, 1, size, output) : size;
+}
+
+uint32_t EspClass::getChipId() {
+  return ArduinoHost::getBoard()->chipId;
+}
+
+uint32_t EspClass::getFreeHeap() {
+  static size_t start = ArduinoHost::getHeapUsed();
+  size_t used = ArduinoHost::getHeapUsed() > start ? ArduinoHost::getHeapUsed() - start : 0;
+  return used < ARDUINO_HOST_HEAP_SIZE ? ARDUINO_HOST_HEAP_SIZE - used : 0;
+}
+
+String EspClass::getResetReason() {
+  return ArduinoHost::getBoard()->resetReason;
+}
+
+/**
+ * Ask for a restart. The sketch keeps running, the program restarts the board when it sees the flag.
+ */
+void EspClass::restart() {
+  ArduinoHost::getBoard()->restartRequested = true;
+}
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size) {
+  if (offset * 4 + size > sizeof(ArduinoHost::getBoard()->rtcMemory)) return false;
+  memcpy(data, (uint8_t *)ArduinoHost::getBoard()->rtcMemory + offset * 4, size);
+  return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size) {
+  if (offset * 4 + size > sizeof(ArduinoHost::getBoard()->rtcMemory)) return false;
+  memcpy((uint8_t *)ArduinoHost::getBoard()->rtcMemory + offset * 4, data, size);
+  return true;
+}
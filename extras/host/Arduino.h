@@ -0,0 +1,420 @@
+/**
+ * Arduino.h
+ *
+ * Host stand-in for the Arduino core, so the library sources build with g++ for the programs in
+ * extras. Only what the library uses is here.
+ *
+ * Time is virtual: each simulated board (ArduinoHost::Board) has its own clock, that only moves when
+ * the program advances it or the sketch calls delay(). millis() and micros() are 32 bits wide as on
+ * the ESP8266, so they wrap after 49.7 days and 71.6 minutes like the real ones. yield() and delay()
+ * run the system task, where programs play the network or the devices around the board, as the ESP
+ * SDK runs its own tasks there. The task may switch to another board and come back later (e.g. each
+ * board in its own coroutine), it's kept from running inside itself per board.
+ *
+ * Every malloc of the program is counted, so programs can tell the heap a helper takes and whether
+ * it grows. ESP.getFreeHeap() is ARDUINO_HOST_HEAP_SIZE less what was allocated since it was first
+ * called. A board also keeps its Wi-Fi state and the files in its flash.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <algorithm>   // min and max.
+#include <cmath>       // Math.
+#include <cstdarg>     // Variadic formatting.
+#include <cstdint>     // Integer types.
+#include <cstdio>      // Formatting.
+#include <cstdlib>     // Conversions.
+#include <cstring>     // C strings.
+#include <functional>  // Hooks.
+#include <map>         // Files.
+#include <math.h>      // isnan and NAN, as the core has them.
+#include <string>      // String storage.
+#include <strings.h>   // Case-insensitive compare.
+
+#ifndef ARDUINO_HOST_HEAP_SIZE
+#define ARDUINO_HOST_HEAP_SIZE 51200  // Free heap of a sketch at boot on an ESP8266.
+#endif
+
+#define ARDUINO_HOST_PINS 17  // GPIO 0 to 16.
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x00
+#define OUTPUT 0x01
+#define INPUT_PULLUP 0x02
+
+// Flash strings are plain strings on the host.
+class __FlashStringHelper;
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strcmp_P strcmp
+#define memcpy_P memcpy
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+
+template <typename T, typename L, typename H>
+T constrain(T value, L low, H high) {
+  return value < low ? low : (value > high ? high : value);
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// Time, 32 bits wide as on the ESP8266.
+uint32_t millis();
+uint32_t micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// GPIO.
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+class StringSumHelper;
+
+class String {
+ private:
+  std::string _value;  // Characters.
+
+ public:
+  String() {}
+  String(const char *value) : _value(value ? value : "") {}
+  String(const char *value, size_t length) : _value(value, length) {}
+  String(const __FlashStringHelper *value) : _value(reinterpret_cast<const char *>(value)) {}
+  String(char value) : _value(1, value) {}
+  String(int value, unsigned char base = 10) { _fromLong(value, base); }
+  String(unsigned int value, unsigned char base = 10) { _fromUnsigned(value, base); }
+  String(long value, unsigned char base = 10) { _fromLong(value, base); }
+  String(unsigned long value, unsigned char base = 10) { _fromUnsigned(value, base); }
+  String(float value, unsigned char decimals = 2) { _fromDouble(value, decimals); }
+  String(double value, unsigned char decimals = 2) { _fromDouble(value, decimals); }
+
+  const char *c_str() const { return _value.c_str(); }
+  unsigned int length() const { return _value.length(); }
+  bool isEmpty() const { return _value.empty(); }
+  bool reserve(unsigned int size) {
+    _value.reserve(size);
+    return true;
+  }
+
+  bool concat(const String &value) {
+    _value += value._value;
+    return true;
+  }
+  bool concat(const char *value) {
+    if (value) _value += value;
+    return value != NULL;
+  }
+  bool concat(const char *value, unsigned int length) {
+    _value.append(value, length);
+    return true;
+  }
+  bool concat(char value) {
+    _value += value;
+    return true;
+  }
+  template <typename T>
+  bool concat(T value) {
+    return concat(String(value));
+  }
+  template <typename T>
+  String &operator+=(const T &value) {
+    concat(value);
+    return *this;
+  }
+
+  char charAt(unsigned int index) const { return index < _value.length() ? _value[index] : 0; }
+  void setCharAt(unsigned int index, char c) {
+    if (index < _value.length()) _value[index] = c;
+  }
+  char operator[](unsigned int index) const { return charAt(index); }
+  char &operator[](unsigned int index) { return _value[index]; }
+
+  bool equals(const String &value) const { return _value == value._value; }
+  bool equals(const char *value) const { return _value == (value ? value : ""); }
+  bool equalsIgnoreCase(const String &value) const { return strcasecmp(c_str(), value.c_str()) == 0; }
+  bool operator==(const String &value) const { return equals(value); }
+  bool operator==(const char *value) const { return equals(value); }
+  bool operator!=(const String &value) const { return !equals(value); }
+  bool operator!=(const char *value) const { return !equals(value); }
+  bool operator<(const String &value) const { return _value < value._value; }
+  bool startsWith(const String &prefix) const { return _value.compare(0, prefix.length(), prefix._value) == 0; }
+  bool endsWith(const String &suffix) const {
+    return _value.length() >= suffix.length() && _value.compare(_value.length() - suffix.length(), suffix.length(), suffix._value) == 0;
+  }
+
+  int indexOf(char c, unsigned int from = 0) const { return _position(_value.find(c, from)); }
+  int indexOf(const String &value, unsigned int from = 0) const { return _position(_value.find(value._value, from)); }
+  int lastIndexOf(char c) const { return _position(_value.rfind(c)); }
+  int lastIndexOf(const String &value) const { return _position(_value.rfind(value._value)); }
+  String substring(unsigned int from) const { return from < _value.length() ? String(_value.c_str() + from) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _value.length()) return String();
+    return String(_value.c_str() + from, std::min((size_t)to, _value.length()) - from);
+  }
+
+  void replace(const String &find, const String &replacement) {
+    if (find.length() == 0) return;
+    for (size_t i = _value.find(find._value); i != std::string::npos; i = _value.find(find._value, i + replacement.length())) {
+      _value.replace(i, find.length(), replacement._value);
+    }
+  }
+  void remove(unsigned int index) {
+    if (index < _value.length()) _value.erase(index);
+  }
+  void remove(unsigned int index, unsigned int count) {
+    if (index < _value.length()) _value.erase(index, count);
+  }
+  void trim() {
+    size_t begin = _value.find_first_not_of(" \t\r\n");
+    size_t end = _value.find_last_not_of(" \t\r\n");
+    _value = begin == std::string::npos ? "" : _value.substr(begin, end - begin + 1);
+  }
+  void toLowerCase() {
+    for (char &c : _value) c = tolower(c);
+  }
+  void toUpperCase() {
+    for (char &c : _value) c = toupper(c);
+  }
+
+  long toInt() const { return atol(c_str()); }
+  float toFloat() const { return atof(c_str()); }
+  double toDouble() const { return atof(c_str()); }
+  void toCharArray(char *buffer, unsigned int size) const { getBytes((unsigned char *)buffer, size); }
+  void getBytes(unsigned char *buffer, unsigned int size) const {
+    if (size == 0) return;
+    size_t length = std::min((size_t)size - 1, _value.length());
+    memcpy(buffer, _value.c_str(), length);
+    buffer[length] = 0;
+  }
+
+  friend StringSumHelper operator+(const String &left, const String &right);
+
+ private:
+  static int _position(size_t position) { return position == std::string::npos ? -1 : (int)position; }
+  void _fromLong(long value, unsigned char base) {
+    if (value < 0 && base == 10) {
+      _fromUnsigned(-(unsigned long)value, base);
+      _value.insert(0, 1, '-');
+    } else {
+      _fromUnsigned((unsigned long)value, base);
+    }
+  }
+  void _fromUnsigned(unsigned long value, unsigned char base) {
+    do {
+      _value.insert(0, 1, "0123456789abcdefghijklmnopqrstuvwxyz"[value % base]);
+      value /= base;
+    } while (value > 0);
+  }
+  void _fromDouble(double value, unsigned char decimals) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    _value = buffer;
+  }
+};
+
+class StringSumHelper : public String {
+ public:
+  StringSumHelper(const String &value) : String(value) {}
+};
+
+inline StringSumHelper operator+(const String &left, const String &right) {
+  StringSumHelper sum(left);
+  sum.concat(right);
+  return sum;
+}
+
+inline bool operator==(const char *left, const String &right) {
+  return right == left;
+}
+
+extern const String emptyString;
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t written = 0;
+    while (written < size && write(buffer[written])) written++;
+    return written;
+  }
+  size_t write(const char *value) { return value ? write((const uint8_t *)value, strlen(value)) : 0; }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const String &value) { return write((const uint8_t *)value.c_str(), value.length()); }
+  size_t print(const char *value) { return write(value); }
+  size_t print(const __FlashStringHelper *value) { return write(reinterpret_cast<const char *>(value)); }
+  size_t print(char value) { return write((uint8_t)value); }
+  size_t print(int value, int base = 10) { return print(String(value, base)); }
+  size_t print(unsigned int value, int base = 10) { return print(String(value, base)); }
+  size_t print(long value, int base = 10) { return print(String(value, base)); }
+  size_t print(unsigned long value, int base = 10) { return print(String(value, base)); }
+  size_t print(double value, int decimals = 2) { return print(String(value, decimals)); }
+  size_t println() { return write("\r\n"); }
+  template <typename T>
+  size_t println(const T &value) { return print(value) + println(); }
+  template <typename T>
+  size_t println(const T &value, int format) { return print(value, format) + println(); }
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return write((const uint8_t *)buffer, std::min((size_t)std::max(length, 0), sizeof(buffer) - 1));
+  }
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  void setTimeout(unsigned long timeout) { (void)timeout; }
+  size_t readBytes(char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+      int c = read();
+      if (c < 0) break;
+      buffer[count++] = (char)c;
+    }
+    return count;
+  }
+  size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+};
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+class IPAddress {
+ private:
+  uint8_t _bytes[4];  // Address, first byte first.
+
+ public:
+  IPAddress() : _bytes{0, 0, 0, 0} {}
+  IPAddress(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) : _bytes{b0, b1, b2, b3} {}
+  IPAddress(uint32_t address) { memcpy(_bytes, &address, 4); }
+  operator uint32_t() const {
+    uint32_t address;
+    memcpy(&address, _bytes, 4);
+    return address;
+  }
+  uint8_t operator[](int index) const { return _bytes[index]; }
+  uint8_t &operator[](int index) { return _bytes[index]; }
+  bool isSet() const { return (uint32_t)(*this) != 0; }
+  bool fromString(const char *address) {
+    unsigned b[4];
+    if (sscanf(address, "%u.%u.%u.%u", &b[0], &b[1], &b[2], &b[3]) != 4) return false;
+    for (int i = 0; i < 4; i++) _bytes[i] = b[i];
+    return true;
+  }
+  String toString() const {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+    return String(buffer);
+  }
+};
+
+class EspClass {
+ public:
+  uint32_t getChipId();
+  uint32_t getFreeHeap();
+  uint8_t getHeapFragmentation() { return 0; }
+  uint32_t getFreeSketchSpace() { return 1044480; }
+  String getResetReason();
+  void restart();
+  bool rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size);
+  bool rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size);
+};
+
+extern EspClass ESP;
+
+class ArduinoHost {
+ public:
+  // A simulated board: what the sketch sees through the core.
+  struct Board {
+    uint64_t time = 0;                                          // Virtual time since boot (us).
+    uint8_t levels[ARDUINO_HOST_PINS] = {0};                    // Pin levels.
+    uint8_t modes[ARDUINO_HOST_PINS] = {0};                     // Pin modes.
+    uint32_t chipId = 0x00C0FFEE;                               // Chip id.
+    uint32_t rtcMemory[128] = {0};                              // RTC user memory, it survives restarts.
+    const char *resetReason = "Power On";                       // Reason of the last reset.
+    bool restartRequested = false;                              // Flag that indicates ESP.restart() was called.
+    bool wifiConnected = true;                                  // Flag that indicates Wi-Fi is connected.
+    IPAddress localIP = IPAddress(127, 0, 0, 1);                // Local IP.
+    std::map<std::string, std::string> files;                   // Files in flash, by path.
+    std::function<void(uint8_t pin, uint8_t level)> onPinWrite;  // Called when the sketch writes a pin.
+    bool inSystemTask = false;                                  // Flag that keeps the system task from running inside itself.
+  };
+
+ private:
+  static Board _defaultBoard;                // Board used until one is selected.
+  static Board *_board;                      // Board the sketch runs on.
+  static std::function<void()> _systemTask;  // Task run on yield() and delay().
+  static FILE *_serialOutput;                // Where Serial writes, NULL to discard.
+
+  // Heap.
+  static size_t _heapUsed;           // Bytes allocated and not freed.
+  static size_t _heapPeak;           // Max bytes allocated at once.
+  static uint64_t _allocationsQty;   // Allocations made.
+  static uint64_t _allocatedBytes;   // Bytes allocated in total.
+
+ public:
+  static void select(Board *board);                          // Run the sketch on a board.
+  static Board *getBoard();                                  // Get the board the sketch runs on.
+  static uint64_t getTime();                                 // Get virtual time of the board (us).
+  static void advance(uint64_t us);                          // Move the board clock forward.
+  static void setSystemTask(std::function<void()> task);     // Define the task run on yield() and delay().
+  static void runSystemTask();                               // Run the system task, unless it's running.
+  static void setPin(uint8_t pin, uint8_t level);            // Drive a pin from outside the board.
+  static uint8_t getPin(uint8_t pin);                        // Get a pin level.
+  static void setSerialOutput(FILE *output);                 // Define where Serial writes, NULL to discard.
+  static FILE *getSerialOutput();                            // Get where Serial writes.
+  static size_t getHeapUsed();                               // Get bytes allocated and not freed.
+  static size_t getHeapPeak();                               // Get max bytes allocated at once.
+  static void resetHeapPeak();                               // Start the peak over from the current use.
+  static uint64_t getAllocationsQty();                       // Get allocations made.
+  static uint64_t getAllocatedBytes();                       // Get bytes allocated in total.
+  static void countAllocation(size_t size);                  // Count an allocation, called by malloc.
+  static void countRelease(size_t size);                     // Count a release, called by free.
+};
+
+#endif
@@ -0,0 +1,13 @@
+/**
+ * DHT.cpp
+ *
+ * Host stand-in for the Adafruit DHT library.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <DHT.h>  // DHT.
+
+DHT::Model DHT::_model;
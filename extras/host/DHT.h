@@ -0,0 +1,72 @@
+/**
+ * DHT.h
+ *
+ * Host stand-in for the Adafruit DHT library. There is no sensor on the host: readings come from the
+ * sensor model the program sets, which is called with the data pin on the board the sketch runs on.
+ * As the library does, a reading is kept for 2 seconds and temperature and humidity share it, and a
+ * failed reading gives NaN.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef DHT_h
+#define DHT_h
+
+#include <Arduino.h>  // Arduino library.
+
+#define DHT11 11  // DHT 11.
+#define DHT12 12  // DHT 12.
+#define DHT21 21  // DHT 21 (AM2301).
+#define DHT22 22  // DHT 22 (AM2302).
+
+class DHT {
+ public:
+  // Sensor model: fills temperature (C) and humidity (%) of the sensor on a pin, false if it fails.
+  using Model = std::function<bool(uint8_t pin, float &temperature, float &humidity)>;
+
+ private:
+  static Model _model;     // Sensor model, shared by every board.
+  uint8_t _pin;            // Data pin.
+  uint8_t _type;           // Sensor type.
+  uint32_t _lastReadTime;  // Last time the sensor was read.
+  bool _lastResult;        // Result of the last reading.
+  float _temperature;      // Temperature of the last reading (C).
+  float _humidity;         // Humidity of the last reading.
+
+  // Read the sensor, unless it was read less than 2 seconds ago.
+  bool _read(bool force) {
+    uint32_t now = millis();
+    if (!force && _lastReadTime != 0 && now - _lastReadTime < 2000) return _lastResult;
+    _lastReadTime = now == 0 ? 1 : now;
+    _lastResult = _model && _model(_pin, _temperature, _humidity);
+    return _lastResult;
+  }
+
+ public:
+  DHT(uint8_t pin, uint8_t type, uint8_t count = 6) : _pin(pin),
+                                                      _type(type),
+                                                      _lastReadTime(0),
+                                                      _lastResult(false),
+                                                      _temperature(NAN),
+                                                      _humidity(NAN) {
+    (void)count;
+  }
+  void begin(uint8_t usec = 55) {
+    (void)usec;
+    _lastReadTime = 0;
+  }
+  float readTemperature(bool S = false, bool force = false) {
+    if (!_read(force)) return NAN;
+    return S ? convertCtoF(_temperature) : _temperature;
+  }
+  float readHumidity(bool force = false) { return _read(force) ? _humidity : NAN; }
+  float convertCtoF(float c) { return c * 1.8 + 32; }
+  float convertFtoC(float f) { return (f - 32) * 0.55555; }
+  uint8_t getType() const { return _type; }
+
+  static void setModel(Model model) { _model = model; }  // Define the sensor model, empty for none.
+};
+
+#endif
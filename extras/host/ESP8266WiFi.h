@@ -0,0 +1,48 @@
+/**
+ * ESP8266WiFi.h
+ *
+ * Host stand-in for the ESP8266 Wi-Fi library, the state is kept by the board.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef ESP8266WiFi_h
+#define ESP8266WiFi_h
+
+#include <Arduino.h>     // Arduino library.
+#include <WiFiClient.h>  // Wi-Fi client.
+
+// Modes.
+enum WiFiMode_t {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+};
+
+// Status.
+enum wl_status_t {
+  WL_IDLE_STATUS = 0,
+  WL_CONNECTED = 3,
+  WL_DISCONNECTED = 6
+};
+
+class ESP8266WiFiClass {
+ public:
+  bool mode(WiFiMode_t mode) {
+    (void)mode;
+    return true;
+  }
+  wl_status_t status() { return isConnected() ? WL_CONNECTED : WL_DISCONNECTED; }
+  bool isConnected() { return ArduinoHost::getBoard()->wifiConnected; }
+  IPAddress localIP() { return isConnected() ? ArduinoHost::getBoard()->localIP : IPAddress(); }
+  IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+  String SSID() { return isConnected() ? "host" : ""; }
+  int32_t RSSI() { return isConnected() ? -60 : 31; }
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
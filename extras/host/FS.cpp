@@ -0,0 +1,13 @@
+/**
+ * FS.cpp
+ *
+ * Host stand-in for the ESP8266 file system.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <FS.h>  // File system.
+
+fs::FS SPIFFS;
@@ -0,0 +1,78 @@
+/**
+ * FS.h
+ *
+ * Host stand-in for the ESP8266 file system. Files are kept in memory, in the flash of the board, so
+ * each simulated board has its own and they survive restarts.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef FS_h
+#define FS_h
+
+#include <Arduino.h>  // Arduino library.
+
+namespace fs {
+
+class File : public Stream {
+ private:
+  std::string *_data;  // File contents, in the board flash. NULL if it isn't open.
+  size_t _position;    // Read position.
+  bool _writable;      // Flag that indicates it was opened to write.
+
+ public:
+  File() : _data(NULL), _position(0), _writable(false) {}
+  File(std::string *data, bool writable) : _data(data), _position(0), _writable(writable) {}
+
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t *buf, size_t size) override {
+    if (!_data || !_writable) return 0;
+    _data->append((const char *)buf, size);
+    return size;
+  }
+  int available() override { return _data && !_writable ? _data->size() - _position : 0; }
+  int read() override { return available() > 0 ? (uint8_t)(*_data)[_position++] : -1; }
+  int peek() override { return available() > 0 ? (uint8_t)(*_data)[_position] : -1; }
+  size_t read(uint8_t *buf, size_t size) {
+    size = min(size, (size_t)available());
+    if (size > 0) memcpy(buf, _data->data() + _position, size);
+    _position += size;
+    return size;
+  }
+  size_t size() const { return _data ? _data->size() : 0; }
+  void close() { _data = NULL; }
+  operator bool() const { return _data != NULL; }
+  using Print::write;
+};
+
+class FS {
+ public:
+  bool begin() { return true; }
+  void end() {}
+  bool format() {
+    ArduinoHost::getBoard()->files.clear();
+    return true;
+  }
+  bool exists(const char *path) { return ArduinoHost::getBoard()->files.count(path) > 0; }
+  bool exists(const String &path) { return exists(path.c_str()); }
+  bool remove(const char *path) { return ArduinoHost::getBoard()->files.erase(path) > 0; }
+  bool remove(const String &path) { return remove(path.c_str()); }
+  File open(const char *path, const char *mode) {
+    std::map<std::string, std::string> &files = ArduinoHost::getBoard()->files;
+    if (mode[0] == 'r') return exists(path) ? File(&files[path], false) : File();
+    std::string *data = &files[path];
+    if (mode[0] == 'w') data->clear();
+    return File(data, true);
+  }
+  File open(const String &path, const char *mode) { return open(path.c_str(), mode); }
+};
+
+}  // namespace fs
+
+using fs::File;
+
+extern fs::FS SPIFFS;
+
+#endif
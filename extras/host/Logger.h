@@ -0,0 +1,47 @@
+/**
+ * Logger.h
+ *
+ * Host stand-in for the Logger library, messages go to stderr.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef Logger_h
+#define Logger_h
+
+#include <Arduino.h>  // Arduino library.
+
+class Logger {
+ public:
+  // Levels.
+  enum Level {
+    VERBOSE = 0,
+    NOTICE,
+    WARNING,
+    ERROR,
+    FATAL,
+    SILENT
+  };
+
+ private:
+  static Level &_level() {
+    static Level level = NOTICE;
+    return level;
+  }
+  static void _log(Level level, const char *tag, const char *message) {
+    if (level >= _level()) fprintf(stderr, "[%s] %s\n", tag, message);
+  }
+
+ public:
+  static void setLogLevel(Level level) { _level() = level; }
+  static Level getLogLevel() { return _level(); }
+  static void verbose(const char *message) { _log(VERBOSE, "VERBOSE", message); }
+  static void notice(const char *message) { _log(NOTICE, "NOTICE", message); }
+  static void warning(const char *message) { _log(WARNING, "WARNING", message); }
+  static void error(const char *message) { _log(ERROR, "ERROR", message); }
+  static void fatal(const char *message) { _log(FATAL, "FATAL", message); }
+};
+
+#endif
@@ -0,0 +1,391 @@
+/**
+ * ThingsBoard.h
+ *
+ * Host stand-in for the ThingsBoard Arduino SDK, with the same MQTT client behaviour underneath:
+ * packets are written whole through the Client in a single write, CONNECT waits for CONNACK for up to
+ * CF_HOST_TB_SOCKET_TIMEOUT, keep alive pings go out from loop() and the connection is dropped when
+ * one isn't answered, and messages over PayloadSize are refused. Times are 32 bits wide, as millis().
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef ThingsBoard_h
+#define ThingsBoard_h
+
+#include <Arduino.h>      // Arduino library.
+#include <ArduinoJson.h>  // Arduino JSON.
+#include <Client.h>       // Arduino client.
+#include <type_traits>    // Type traits.
+
+#ifndef CF_HOST_TB_KEEPALIVE
+#define CF_HOST_TB_KEEPALIVE 15  // Keep alive (s), as PubSubClient.
+#endif
+
+#ifndef CF_HOST_TB_SOCKET_TIMEOUT
+#define CF_HOST_TB_SOCKET_TIMEOUT 15  // Time to wait for CONNACK (s), as PubSubClient.
+#endif
+
+// Value of a telemetry key, an attribute or a RPC response.
+class Telemetry {
+ private:
+  enum Type { NONE, BOOL, INT, FLOAT, STRING };
+  const char *_key;  // Key, NULL for a bare value.
+  Type _type;        // Value type.
+  bool _bool;        // Bool value.
+  long _int;         // Integer value.
+  double _float;     // Floating point value.
+  const char *_str;  // String value.
+
+ public:
+  Telemetry() : _key(NULL), _type(NONE), _bool(false), _int(0), _float(0), _str(NULL) {}
+  Telemetry(const char *key, bool value) : Telemetry() {
+    _key = key;
+    _type = BOOL;
+    _bool = value;
+  }
+  template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+  Telemetry(const char *key, T value) : Telemetry() {
+    _key = key;
+    _type = INT;
+    _int = value;
+  }
+  template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+  Telemetry(const char *key, T value) : Telemetry() {
+    _key = key;
+    _type = FLOAT;
+    _float = value;
+  }
+  Telemetry(const char *key, const char *value) : Telemetry() {
+    _key = key;
+    _type = STRING;
+    _str = value;
+  }
+
+  // Write the value, under its key if it has one.
+  void serializeKeyval(JsonVariant variant) const {
+    if (!_key) {
+      _set(variant);
+      return;
+    }
+    JsonObject object = variant.is<JsonObject>() ? variant.as<JsonObject>() : variant.to<JsonObject>();
+    _set(object[_key]);
+  }
+
+ private:
+  template <typename T>
+  void _set(T target) const {
+    switch (_type) {
+      case BOOL:
+        target.set(_bool);
+        break;
+      case INT:
+        target.set(_int);
+        break;
+      case FLOAT:
+        target.set(_float);
+        break;
+      case STRING:
+        target.set(_str);
+        break;
+      default:
+        break;
+    }
+  }
+};
+
+using RPC_Response = Telemetry;
+using RPC_Data = JsonVariant;
+using Shared_Attribute_Data = JsonObject;
+
+class RPC_Callback {
+ public:
+  using processFn = RPC_Response (*)(const RPC_Data &data);
+  const char *m_name;  // Method.
+  processFn m_cb;      // Handler.
+  RPC_Callback() : m_name(NULL), m_cb(NULL) {}
+  RPC_Callback(const char *methodName, processFn cb) : m_name(methodName), m_cb(cb) {}
+};
+
+class Shared_Attribute_Callback {
+ public:
+  using processFn = void (*)(const Shared_Attribute_Data &data);
+  processFn m_cb;  // Handler.
+  Shared_Attribute_Callback() : m_cb(NULL) {}
+  Shared_Attribute_Callback(processFn cb) : m_cb(cb) {}
+};
+
+template <size_t PayloadSize = 64, size_t MaxFieldsAmt = 8>
+class ThingsBoardSized {
+ private:
+  Client &_client;                                              // Network client.
+  uint8_t _buffer[PayloadSize];                                 // Packet being written or read.
+  bool _connected;                                              // Flag that indicates CONNACK accepted the connection.
+  bool _pingOutstanding;                                        // Flag that indicates a ping wasn't answered yet.
+  uint32_t _tLastIn;                                            // Last time something was read.
+  uint32_t _tLastOut;                                           // Last time something was written.
+  uint16_t _packetId;                                           // Last packet identifier.
+  RPC_Callback _rpcCallbacks[MaxFieldsAmt];                     // RPC handlers.
+  size_t _rpcCallbacksQty;                                      // RPC handlers quantity.
+  Shared_Attribute_Callback _attributeCallbacks[MaxFieldsAmt];  // Shared attribute handlers.
+  size_t _attributeCallbacksQty;                                // Shared attribute handlers quantity.
+
+  // Write a fixed header for a packet with the remaining length, returns its length.
+  static size_t _header(uint8_t *buffer, uint8_t type, size_t remaining) {
+    size_t length = 0;
+    buffer[length++] = type;
+    do {
+      uint8_t digit = remaining % 128;
+      remaining /= 128;
+      buffer[length++] = digit | (remaining > 0 ? 0x80 : 0);
+    } while (remaining > 0);
+    return length;
+  }
+
+  // Write a length-prefixed string, returns its length.
+  static size_t _string(uint8_t *buffer, const char *value, size_t length) {
+    buffer[0] = length >> 8;
+    buffer[1] = length & 0xFF;
+    memcpy(buffer + 2, value, length);
+    return length + 2;
+  }
+
+  // Write a packet made of a type and a body, in a single write.
+  bool _write(uint8_t type, const uint8_t *body, size_t length) {
+    uint8_t header[5];
+    size_t headerLength = _header(header, type, length);
+    if (headerLength + length > PayloadSize) return false;
+    if (length > 0) memmove(_buffer + headerLength, body, length);
+    memcpy(_buffer, header, headerLength);
+    bool sent = _client.write(_buffer, headerLength + length) == headerLength + length;
+    if (sent) _tLastOut = millis();
+    return sent;
+  }
+
+  // Read a whole packet into the buffer, returns its length or 0.
+  size_t _read() {
+    int type = _client.read();
+    if (type < 0) return 0;
+    size_t remaining = 0;
+    size_t length = 0;
+    uint8_t header[5] = {(uint8_t)type};
+    for (int shift = 0; shift < 28; shift += 7) {
+      int digit = _client.read();
+      if (digit < 0) return 0;
+      header[++length] = digit;
+      remaining |= (size_t)(digit & 0x7F) << shift;
+      if (!(digit & 0x80)) break;
+    }
+    length++;
+    if (length + remaining > PayloadSize) {
+      // Too long for the buffer, it's read and dropped.
+      for (size_t i = 0; i < remaining; i++) _client.read();
+      return 0;
+    }
+    memcpy(_buffer, header, length);
+    while (remaining > 0) {
+      int read = _client.read(_buffer + length, remaining);
+      if (read <= 0) return 0;
+      length += read;
+      remaining -= read;
+    }
+    _tLastIn = millis();
+    return length;
+  }
+
+  // Handle a message.
+  void _handlePublish(const char *topic, const char *payload, size_t length) {
+    DynamicJsonDocument doc(2 * PayloadSize);
+    if (deserializeJson(doc, payload, length)) return;
+
+    if (strncmp(topic, "v1/devices/me/rpc/request/", 26) == 0) {
+      const char *method = doc["method"];
+      if (!method) return;
+      for (size_t i = 0; i < _rpcCallbacksQty; i++) {
+        if (strcmp(_rpcCallbacks[i].m_name, method) != 0) continue;
+        RPC_Response response = _rpcCallbacks[i].m_cb(doc["params"].template as<JsonVariant>());
+        DynamicJsonDocument result(PayloadSize);
+        response.serializeKeyval(result.template to<JsonVariant>());
+        char serializedJson[PayloadSize];
+        serializeJson(result, serializedJson, sizeof(serializedJson));
+        char responseTopic[64];
+        snprintf(responseTopic, sizeof(responseTopic), "v1/devices/me/rpc/response/%s", topic + 26);
+        publish(responseTopic, serializedJson);
+        return;
+      }
+    } else if (strcmp(topic, "v1/devices/me/attributes") == 0 || strncmp(topic, "v1/devices/me/attributes/response/", 34) == 0) {
+      JsonObject data = doc.containsKey("shared") ? doc["shared"].template as<JsonObject>() : doc.template as<JsonObject>();
+      for (size_t i = 0; i < _attributeCallbacksQty; i++) _attributeCallbacks[i].m_cb(data);
+    }
+  }
+
+  bool _subscribe(const char *topic) {
+    uint8_t body[PayloadSize];
+    size_t length = strlen(topic);
+    if (length + 5 > sizeof(body)) return false;
+    _packetId++;
+    body[0] = _packetId >> 8;
+    body[1] = _packetId & 0xFF;
+    size_t bodyLength = 2 + _string(body + 2, topic, length);
+    body[bodyLength++] = 0;  // QoS 0.
+    return _write(0x82, body, bodyLength);
+  }
+
+ public:
+  ThingsBoardSized(Client &client) : _client(client),
+                                     _connected(false),
+                                     _pingOutstanding(false),
+                                     _tLastIn(0),
+                                     _tLastOut(0),
+                                     _packetId(0),
+                                     _rpcCallbacksQty(0),
+                                     _attributeCallbacksQty(0) {
+  }
+
+  bool connect(const char *host, const char *access_token = "provision", int port = 1883, const char *client_id = "TbDev", const char *password = NULL) {
+    _connected = false;
+    if (!_client.connect(host, port)) return false;
+
+    uint8_t body[PayloadSize];
+    size_t length = _string(body, "MQTT", 4);
+    body[length++] = 4;                                         // MQTT 3.1.1.
+    body[length++] = 0x02 | 0x80 | (password ? 0x40 : 0x00);  // Clean session, user name, password.
+    body[length++] = CF_HOST_TB_KEEPALIVE >> 8;
+    body[length++] = CF_HOST_TB_KEEPALIVE & 0xFF;
+    if (length + strlen(client_id) + strlen(access_token) + (password ? strlen(password) + 2 : 0) + 4 > sizeof(body)) return false;
+    length += _string(body + length, client_id, strlen(client_id));
+    length += _string(body + length, access_token, strlen(access_token));
+    if (password) length += _string(body + length, password, strlen(password));
+    if (!_write(0x10, body, length)) {
+      _client.stop();
+      return false;
+    }
+
+    // Wait for CONNACK, giving the network its time.
+    uint32_t start = millis();
+    while (!_client.available()) {
+      if (millis() - start >= CF_HOST_TB_SOCKET_TIMEOUT * 1000UL || !_client.connected()) {
+        _client.stop();
+        return false;
+      }
+      delay(1);
+    }
+    size_t read = _read();
+    if (read != 4 || _buffer[0] != 0x20 || _buffer[3] != 0) {
+      _client.stop();
+      return false;
+    }
+    _connected = true;
+    _pingOutstanding = false;
+    _tLastIn = _tLastOut = millis();
+    return true;
+  }
+
+  void disconnect() {
+    if (_connected) {
+      uint8_t packet[2] = {0xE0, 0x00};
+      _client.write(packet, 2);
+    }
+    _connected = false;
+    _client.stop();
+  }
+
+  bool connected() {
+    if (_connected && !_client.connected()) {
+      _connected = false;
+      _client.stop();
+    }
+    return _connected;
+  }
+
+  bool loop() {
+    if (!connected()) return false;
+
+    // Keep alive.
+    uint32_t now = millis();
+    if (now - _tLastIn > CF_HOST_TB_KEEPALIVE * 1000UL || now - _tLastOut > CF_HOST_TB_KEEPALIVE * 1000UL) {
+      if (_pingOutstanding) {
+        _connected = false;
+        _client.stop();
+        return false;
+      }
+      if (!_write(0xC0, NULL, 0)) return false;
+      _tLastIn = now;
+      _pingOutstanding = true;
+    }
+
+    while (_client.available()) {
+      size_t length = _read();
+      if (length == 0) break;
+      uint8_t type = _buffer[0] & 0xF0;
+      if (type == 0xD0) {
+        _pingOutstanding = false;
+      } else if (type == 0xC0) {
+        _write(0xD0, NULL, 0);
+      } else if (type == 0x30) {
+        // Remaining length, topic and payload of a QoS 0 message.
+        size_t offset = 1;
+        while (_buffer[offset] & 0x80) offset++;
+        offset++;
+        size_t topicLength = (_buffer[offset] << 8) | _buffer[offset + 1];
+        char topic[128];
+        if (topicLength >= sizeof(topic) || offset + 2 + topicLength > length) continue;
+        memcpy(topic, _buffer + offset + 2, topicLength);
+        topic[topicLength] = 0;
+        size_t payload = offset + 2 + topicLength;
+        _handlePublish(topic, (const char *)_buffer + payload, length - payload);
+      }
+    }
+    return true;
+  }
+
+  bool publish(const char *topic, const char *payload) {
+    if (!connected()) return false;
+    size_t topicLength = strlen(topic);
+    size_t payloadLength = strlen(payload);
+    uint8_t body[PayloadSize];
+    if (topicLength + payloadLength + 2 > sizeof(body)) return false;
+    size_t length = _string(body, topic, topicLength);
+    memcpy(body + length, payload, payloadLength);
+    return _write(0x30, body, length + payloadLength);
+  }
+
+  bool sendTelemetryJson(const char *json) { return publish("v1/devices/me/telemetry", json); }
+  bool sendAttributeJSON(const char *json) { return publish("v1/devices/me/attributes", json); }
+
+  template <typename T>
+  bool sendTelemetryValue(const char *topic, const char *key, T value) {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1)> doc;
+    Telemetry(key, value).serializeKeyval(doc.template to<JsonVariant>());
+    char serializedJson[PayloadSize];
+    if (measureJson(doc) >= sizeof(serializedJson)) return false;
+    serializeJson(doc, serializedJson, sizeof(serializedJson));
+    return publish(topic, serializedJson);
+  }
+  bool sendTelemetryInt(const char *key, int value) { return sendTelemetryValue("v1/devices/me/telemetry", key, value); }
+  bool sendTelemetryBool(const char *key, bool value) { return sendTelemetryValue("v1/devices/me/telemetry", key, value); }
+  bool sendTelemetryFloat(const char *key, float value) { return sendTelemetryValue("v1/devices/me/telemetry", key, value); }
+  bool sendAttributeInt(const char *key, int value) { return sendTelemetryValue("v1/devices/me/attributes", key, value); }
+  bool sendAttributeBool(const char *key, bool value) { return sendTelemetryValue("v1/devices/me/attributes", key, value); }
+  bool sendAttributeFloat(const char *key, float value) { return sendTelemetryValue("v1/devices/me/attributes", key, value); }
+  bool sendAttributeString(const char *key, const char *value) { return sendTelemetryValue("v1/devices/me/attributes", key, value); }
+
+  bool RPC_Subscribe(const RPC_Callback *callbacks, size_t callbacks_size) {
+    if (callbacks_size > MaxFieldsAmt || !_subscribe("v1/devices/me/rpc/request/+")) return false;
+    for (size_t i = 0; i < callbacks_size; i++) _rpcCallbacks[i] = callbacks[i];
+    _rpcCallbacksQty = callbacks_size;
+    return true;
+  }
+
+  bool Shared_Attributes_Subscribe(const Shared_Attribute_Callback *callbacks, size_t callbacks_size) {
+    if (callbacks_size > MaxFieldsAmt || !_subscribe("v1/devices/me/attributes")) return false;
+    for (size_t i = 0; i < callbacks_size; i++) _attributeCallbacks[i] = callbacks[i];
+    _attributeCallbacksQty = callbacks_size;
+    return true;
+  }
+};
+
+using ThingsBoard = ThingsBoardSized<>;
+
+#endif
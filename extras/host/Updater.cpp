@@ -0,0 +1,13 @@
+/**
+ * Updater.cpp
+ *
+ * Host stand-in for the ESP8266 Updater.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <Updater.h>  // ESP8266 Updater.
+
+UpdaterClass Update;
@@ -0,0 +1,67 @@
+/**
+ * Updater.h
+ *
+ * Host stand-in for the ESP8266 Updater. Nothing is flashed: the image is taken and counted, and the
+ * MD5 given is only checked to be one.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef Updater_h
+#define Updater_h
+
+#include <Arduino.h>  // Arduino library.
+
+#define U_FLASH 0  // Sketch image.
+#define U_FS 100   // File system image.
+
+class UpdaterClass {
+ private:
+  bool _running;    // Flag that indicates an update was begun.
+  size_t _size;     // Max image size.
+  size_t _written;  // Bytes written.
+  String _md5;      // Expected MD5.
+  String _error;    // Last error, empty for none.
+
+ public:
+  UpdaterClass() : _running(false), _size(0), _written(0) {}
+  bool begin(size_t size, int command = U_FLASH) {
+    (void)command;
+    _running = size > 0;
+    _size = size;
+    _written = 0;
+    _md5 = "";
+    _error = _running ? "" : "Not enough space";
+    return _running;
+  }
+  bool setMD5(const char *md5) {
+    if (strlen(md5) != 32) return false;
+    _md5 = md5;
+    return true;
+  }
+  size_t write(uint8_t *data, size_t length) {
+    (void)data;
+    if (!_running || _written + length > _size) {
+      _error = "Not enough space";
+      return 0;
+    }
+    _written += length;
+    return length;
+  }
+  bool end(bool evenIfRemaining = false) {
+    (void)evenIfRemaining;
+    if (!_running) return false;
+    _running = false;
+    return _written > 0;
+  }
+  bool isRunning() { return _running; }
+  size_t progress() { return _written; }
+  String md5String() { return _md5; }
+  String getErrorString() { return _error; }
+};
+
+extern UpdaterClass Update;
+
+#endif
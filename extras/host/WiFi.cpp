@@ -0,0 +1,57 @@
+/**
+ * WiFi.cpp
+ *
+ * Host stand-in for the ESP8266 Wi-Fi library.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <ESP8266WiFi.h>  // ESP8266 Wi-Fi.
+#include <WiFiUdp.h>      // Wi-Fi UDP.
+#include <netinet/in.h>   // Internet sockets.
+#include <sys/socket.h>   // Sockets.
+#include <unistd.h>       // Close.
+
+ESP8266WiFiClass WiFi;
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+  if (!WiFi.isConnected()) return 0;
+  if (_fd < 0) _fd = socket(AF_INET, SOCK_DGRAM, 0);
+  _ip = ip;
+  _port = port;
+  _packet.clear();
+  _writing = _fd >= 0;
+  return _writing;
+}
+
+int WiFiUDP::beginPacketMulticast(IPAddress group, uint16_t port, IPAddress localIP, int ttl) {
+  (void)localIP;
+  if (!beginPacket(group, port)) return 0;
+  unsigned char hops = ttl;
+  setsockopt(_fd, IPPROTO_IP, IP_MULTICAST_TTL, &hops, sizeof(hops));
+  return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t *buf, size_t size) {
+  if (!_writing) return 0;
+  _packet.insert(_packet.end(), buf, buf + size);
+  return size;
+}
+
+int WiFiUDP::endPacket() {
+  if (!_writing) return 0;
+  _writing = false;
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(_port);
+  address.sin_addr.s_addr = (uint32_t)_ip;
+  return sendto(_fd, _packet.data(), _packet.size(), 0, (sockaddr *)&address, sizeof(address)) == (ssize_t)_packet.size();
+}
+
+void WiFiUDP::stop() {
+  if (_fd >= 0) close(_fd);
+  _fd = -1;
+  _writing = false;
+}
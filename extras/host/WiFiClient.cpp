@@ -0,0 +1,157 @@
+/**
+ * WiFiClient.cpp
+ *
+ * Host stand-in for the ESP8266 Wi-Fi client, on a TCP socket of the host.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <WiFiClient.h>     // Wi-Fi client.
+#include <arpa/inet.h>      // Addresses.
+#include <cerrno>           // Errors.
+#include <fcntl.h>          // Non-blocking sockets.
+#include <linux/sockios.h>  // Send queue.
+#include <netdb.h>          // Host names.
+#include <netinet/in.h>     // Internet sockets.
+#include <netinet/tcp.h>    // No delay.
+#include <poll.h>           // Connection wait.
+#include <sys/ioctl.h>      // Queue sizes.
+#include <sys/socket.h>     // Sockets.
+#include <unistd.h>         // Close.
+
+WiFiClient::Socket::~Socket() {
+  if (fd >= 0) close(fd);
+}
+
+/**
+ * Take a connected socket.
+ *
+ * @param fd Socket, it's made non-blocking and closed with the last copy.
+ */
+WiFiClient::WiFiClient(int fd) : _socket(new Socket{fd, false}) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  setNoDelay(true);
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+  return connect(ip.toString().c_str(), port);
+}
+
+int WiFiClient::connect(const char *host, uint16_t port) {
+  stop();
+  if (!ArduinoHost::getBoard()->wifiConnected) return 0;
+
+  addrinfo hints = {};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *address;
+  char service[8];
+  snprintf(service, sizeof(service), "%u", port);
+  if (getaddrinfo(host, service, &hints, &address) != 0) return 0;
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd >= 0) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  bool connected = fd >= 0 && ::connect(fd, address->ai_addr, address->ai_addrlen) == 0;
+  freeaddrinfo(address);
+  if (!connected && fd >= 0 && errno == EINPROGRESS) {
+    // Wait for the handshake as the board does, letting the system run.
+    uint32_t start = millis();
+    for (;;) {
+      pollfd writable = {fd, POLLOUT, 0};
+      if (poll(&writable, 1, 0) > 0) {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        connected = getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0;
+        break;
+      }
+      if (millis() - start >= ARDUINO_HOST_CONNECT_TIMEOUT) break;
+      delay(1);
+    }
+  }
+  if (!connected) {
+    if (fd >= 0) close(fd);
+    return 0;
+  }
+  _socket = std::make_shared<Socket>();
+  _socket->fd = fd;
+  _socket->closed = false;
+  setNoDelay(true);
+  return 1;
+}
+
+size_t WiFiClient::write(uint8_t b) {
+  return write(&b, 1);
+}
+
+size_t WiFiClient::write(const uint8_t *buf, size_t size) {
+  if (!connected() || size == 0) return 0;
+  ssize_t sent = send(_socket->fd, buf, size, MSG_NOSIGNAL);
+  if (sent < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) _socket->closed = true;
+    return 0;
+  }
+  return sent;
+}
+
+/**
+ * Bytes the send buffer has room for.
+ */
+int WiFiClient::availableForWrite() {
+  if (!connected()) return 0;
+  int size = 0;
+  socklen_t length = sizeof(size);
+  int queued = 0;
+  if (getsockopt(_socket->fd, SOL_SOCKET, SO_SNDBUF, &size, &length) != 0 || ioctl(_socket->fd, SIOCOUTQ, &queued) != 0) return 0;
+  // The kernel doubles the size asked for, half of it is bookkeeping.
+  return max(size / 2 - queued, 0);
+}
+
+int WiFiClient::available() {
+  if (!_socket || _socket->fd < 0) return 0;
+  int count = 0;
+  if (ioctl(_socket->fd, FIONREAD, &count) != 0) return 0;
+  if (count == 0 && !_socket->closed) {
+    // Nothing to read: tell if the peer is gone.
+    uint8_t b;
+    ssize_t result = recv(_socket->fd, &b, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (result == 0 || (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) _socket->closed = true;
+  }
+  return count;
+}
+
+int WiFiClient::read() {
+  uint8_t b;
+  return read(&b, 1) == 1 ? b : -1;
+}
+
+int WiFiClient::read(uint8_t *buf, size_t size) {
+  if (!_socket || _socket->fd < 0) return -1;
+  ssize_t result = recv(_socket->fd, buf, size, MSG_DONTWAIT);
+  if (result == 0 || (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) _socket->closed = true;
+  return result > 0 ? result : -1;
+}
+
+int WiFiClient::peek() {
+  uint8_t b;
+  if (!_socket || _socket->fd < 0 || recv(_socket->fd, &b, 1, MSG_PEEK | MSG_DONTWAIT) != 1) return -1;
+  return b;
+}
+
+void WiFiClient::stop() {
+  _socket.reset();
+}
+
+/**
+ * True while the connection is open, or the peer closed it but there is still data to read.
+ */
+uint8_t WiFiClient::connected() {
+  if (!_socket || _socket->fd < 0) return 0;
+  if (!ArduinoHost::getBoard()->wifiConnected) _socket->closed = true;
+  return !_socket->closed || available() > 0;
+}
+
+void WiFiClient::setNoDelay(bool noDelay) {
+  int value = noDelay;
+  if (_socket) setsockopt(_socket->fd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+}
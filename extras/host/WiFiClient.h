@@ -0,0 +1,61 @@
+/**
+ * WiFiClient.h
+ *
+ * Host stand-in for the ESP8266 Wi-Fi client, on a TCP socket of the host.
+ *
+ * Connecting waits as on the board, running delay() until the handshake is done or
+ * ARDUINO_HOST_CONNECT_TIMEOUT goes by, so the program keeps running meanwhile. The rest never waits:
+ * write() takes what the socket send buffer has room for, as availableForWrite() tells. Copies share
+ * the connection, as they do on the board. Nothing connects while the board Wi-Fi is down. Nagle is
+ * off: virtual time runs far ahead of the real one, and small packets would wait hours of it for the
+ * ACK of the last one.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef WiFiClient_h
+#define WiFiClient_h
+
+#include <Arduino.h>  // Arduino library.
+#include <Client.h>   // Arduino client.
+#include <memory>     // Shared connection.
+
+#ifndef ARDUINO_HOST_CONNECT_TIMEOUT
+#define ARDUINO_HOST_CONNECT_TIMEOUT 5000  // Time to wait for a connection (ms), as the ESP8266 core.
+#endif
+
+class WiFiClient : public Client {
+ private:
+  // Connection shared by the copies.
+  struct Socket {
+    int fd;       // Socket, -1 once closed.
+    bool closed;  // Flag that indicates the peer closed it.
+    ~Socket();
+  };
+  std::shared_ptr<Socket> _socket;  // Connection.
+
+ public:
+  WiFiClient() {}
+  WiFiClient(int fd);  // Take a connected socket, e.g. accepted by a program.
+
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(const char *host, uint16_t port) override;
+  size_t write(uint8_t b) override;
+  size_t write(const uint8_t *buf, size_t size) override;
+  int availableForWrite() override;
+  int available() override;
+  int read() override;
+  int read(uint8_t *buf, size_t size) override;
+  int peek() override;
+  void flush() override {}
+  void stop() override;
+  uint8_t connected() override;
+  operator bool() override { return connected(); }
+  void setNoDelay(bool noDelay);
+  int getFD() const { return _socket ? _socket->fd : -1; }
+  using Print::write;
+};
+
+#endif
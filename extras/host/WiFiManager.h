@@ -0,0 +1,192 @@
+/**
+ * WiFiManager.h
+ *
+ * Host stand-in for WiFiManager. The board Wi-Fi is taken as it is, there is no portal: autoConnect()
+ * succeeds if the board is connected and goes to config mode otherwise, and the web server only keeps
+ * the routes, so they can be called by hand.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef WiFiManager_h
+#define WiFiManager_h
+
+#include <Arduino.h>      // Arduino library.
+#include <ESP8266WiFi.h>  // ESP8266 Wi-Fi.
+#include <FS.h>           // File system, the web server brings it in.
+#include <WiFiUdp.h>      // Wi-Fi UDP.
+#include <memory>         // Web server.
+#include <vector>         // Routes and menu.
+
+// HTTP methods.
+enum HTTPMethod {
+  HTTP_ANY,
+  HTTP_GET,
+  HTTP_POST
+};
+
+// Upload status.
+enum HTTPUploadStatus {
+  UPLOAD_FILE_START,
+  UPLOAD_FILE_WRITE,
+  UPLOAD_FILE_END,
+  UPLOAD_FILE_ABORTED
+};
+
+struct HTTPUpload {
+  HTTPUploadStatus status;  // Status.
+  String filename;          // File name.
+  size_t totalSize;         // Bytes uploaded.
+  size_t currentSize;       // Bytes in the buffer.
+  uint8_t buf[2048];        // Buffer.
+};
+
+class ESP8266WebServer {
+ public:
+  using THandlerFunction = std::function<void()>;
+
+  // Request and response, to call the routes by hand.
+  HTTPMethod requestMethod = HTTP_GET;                    // Method.
+  std::vector<std::pair<String, String>> requestArgs;     // Arguments.
+  std::vector<std::pair<String, String>> requestHeaders;  // Headers.
+  HTTPUpload requestUpload = {};                          // Upload.
+  int responseCode = 0;                                   // Last response code.
+  String responseContent;                                 // Last response content.
+
+  explicit ESP8266WebServer(int port = 80) : _port(port) {}
+  void on(const String &uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+  void on(const String &uri, HTTPMethod method, THandlerFunction handler, THandlerFunction upload = nullptr) {
+    _routes.push_back({uri, method, handler, upload});
+  }
+  void collectHeaders(const char *headers[], size_t size) { (void)headers, (void)size; }
+  bool handle(HTTPMethod method, const String &uri) {
+    for (const Route &route : _routes) {
+      if (route.uri != uri || (route.method != HTTP_ANY && route.method != method)) continue;
+      requestMethod = method;
+      if (route.upload) route.upload();
+      route.handler();
+      return true;
+    }
+    return false;
+  }
+  HTTPMethod method() { return requestMethod; }
+  int args() { return requestArgs.size(); }
+  const String &argName(int i) { return requestArgs[i].first; }
+  const String &arg(int i) { return requestArgs[i].second; }
+  String arg(const String &name) {
+    for (const std::pair<String, String> &arg : requestArgs) {
+      if (arg.first == name) return arg.second;
+    }
+    return "";
+  }
+  String header(const String &name) {
+    for (const std::pair<String, String> &header : requestHeaders) {
+      if (header.first == name) return header.second;
+    }
+    return "";
+  }
+  HTTPUpload &upload() { return requestUpload; }
+  WiFiClient &client() { return _client; }
+  void setContentLength(size_t length) { (void)length; }
+  void send(int code, const char *contentType, const String &content) {
+    (void)contentType;
+    responseCode = code;
+    responseContent = content;
+  }
+  void send_P(int code, PGM_P contentType, PGM_P content) { send(code, contentType, String(content)); }
+  int getPort() const { return _port; }
+
+ private:
+  struct Route {
+    String uri;                // URI.
+    HTTPMethod method;         // Method.
+    THandlerFunction handler;  // Handler.
+    THandlerFunction upload;   // Upload handler.
+  };
+  int _port;                   // Port.
+  std::vector<Route> _routes;  // Routes.
+  WiFiClient _client;          // Client, not connected.
+};
+
+class WiFiManagerParameter {
+ private:
+  const char *_id;     // Id.
+  const char *_label;  // Label.
+  char *_value;        // Value.
+  int _length;         // Max value length.
+
+ public:
+  WiFiManagerParameter() : _id(NULL), _label(NULL), _value(NULL), _length(0) {}
+  WiFiManagerParameter(const char *id, const char *label, const char *defaultValue, int length)
+      : _id(id), _label(label), _value(NULL), _length(0) {
+    setValue(defaultValue, length);
+  }
+  WiFiManagerParameter(const WiFiManagerParameter &) = delete;
+  WiFiManagerParameter &operator=(const WiFiManagerParameter &) = delete;
+  ~WiFiManagerParameter() { delete[] _value; }
+  const char *getID() const { return _id; }
+  const char *getLabel() const { return _label; }
+  const char *getValue() const { return _value; }
+  int getValueLength() const { return _length; }
+  void setValue(const char *value, int length) {
+    if (!_value || length != _length) {
+      delete[] _value;
+      _length = length;
+      _value = new char[_length + 1];
+    }
+    memset(_value, 0, _length + 1);
+    if (value) strncpy(_value, value, _length);
+  }
+};
+
+class WiFiManager {
+ public:
+  std::unique_ptr<ESP8266WebServer> server;  // Web server, created when the portal starts.
+
+  String getDefaultAPName() {
+    char name[16];
+    snprintf(name, sizeof(name), "ESP_%06X", ESP.getChipId());
+    return name;
+  }
+  void setAPCallback(std::function<void(WiFiManager *)> callback) { _apCallback = callback; }
+  void setSaveParamsCallback(std::function<void()> callback) { _saveParamsCallback = callback; }
+  void setWebServerCallback(std::function<void()> callback) { _webServerCallback = callback; }
+  void setMenu(std::vector<const char *> &menu) { (void)menu; }
+  void setCustomMenuHTML(const char *html) { (void)html; }
+  void setConfigPortalTimeout(unsigned long seconds) { (void)seconds; }
+  void setClass(String name) { (void)name; }
+  void setHttpPort(uint16_t port) { _httpPort = port; }
+  bool addParameter(WiFiManagerParameter *parameter) {
+    _parameters.push_back(parameter);
+    return true;
+  }
+  bool autoConnect(const char *apName, const char *apPassword = NULL) {
+    (void)apName, (void)apPassword;
+    if (WiFi.isConnected()) return true;
+    startWebPortal();
+    if (_apCallback) _apCallback(this);
+    return false;
+  }
+  void startWebPortal() {
+    server.reset(new ESP8266WebServer(_httpPort));
+    if (_webServerCallback) _webServerCallback();
+  }
+  void process() {}
+  void resetSettings() {}
+
+  // Save the parameters as the portal does when its form is sent.
+  void saveParams() {
+    if (_saveParamsCallback) _saveParamsCallback();
+  }
+
+ private:
+  uint16_t _httpPort = 80;                          // Portal port.
+  std::vector<WiFiManagerParameter *> _parameters;  // Parameters.
+  std::function<void(WiFiManager *)> _apCallback;   // On config mode callback.
+  std::function<void()> _saveParamsCallback;        // On save parameters callback.
+  std::function<void()> _webServerCallback;         // On web server setup callback.
+};
+
+#endif
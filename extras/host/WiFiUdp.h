@@ -0,0 +1,38 @@
+/**
+ * WiFiUdp.h
+ *
+ * Host stand-in for the ESP8266 Wi-Fi UDP, on a UDP socket of the host. Only sending is here.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef WiFiUdp_h
+#define WiFiUdp_h
+
+#include <Arduino.h>  // Arduino library.
+#include <vector>     // Packet.
+
+class WiFiUDP : public Print {
+ private:
+  int _fd;                       // Socket, -1 until a packet is sent.
+  IPAddress _ip;                 // Destination.
+  uint16_t _port;                // Destination port.
+  std::vector<uint8_t> _packet;  // Packet being written.
+  bool _writing;                 // Flag that indicates a packet was begun.
+
+ public:
+  WiFiUDP() : _fd(-1), _port(0), _writing(false) {}
+  ~WiFiUDP() { stop(); }
+  int beginPacket(IPAddress ip, uint16_t port);
+  int beginPacketMulticast(IPAddress group, uint16_t port, IPAddress localIP, int ttl = 1);
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t *buf, size_t size) override;
+  int endPacket();
+  void stop();
+  static void stopAll() {}
+  using Print::write;
+};
+
+#endif
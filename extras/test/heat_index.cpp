@@ -0,0 +1,137 @@
+/**
+ * heat_index.cpp
+ *
+ * Host test of CFHeatIndex over the whole DHT22 range, -40.0 to 80.0 C and 0 to 100.0 % by tenths
+ * (1.2M pairs), against:
+ *   - an extended precision (long double) evaluation of the DHT library formula, that the fixed
+ *     point kernel must match exactly, but for .x5 ties long double can't tell apart;
+ *   - the float path CFDHTHelper used before (DHT::computeHeatIndex), that may be off by a tenth.
+ * The unit conversions are checked against exact rational rounding too.
+ *
+ *   g++ -std=c++11 -O2 -I extras/host -I src extras/test/heat_index.cpp src/CFHeatIndex.cpp -o heat_index
+ *   ./heat_index
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFHeatIndex.h>  // CF Heat Index.
+#include <cmath>          // Math.
+#include <cstdio>         // Output.
+#include <cstdlib>        // Absolute values.
+
+/**
+ * Heat index in F, DHT library formula in long double.
+ */
+long double exactHeatIndexF(long double t, long double h) {
+  long double hi = 0.5L * (t + 61.0L + ((t - 68.0L) * 1.2L) + (h * 0.094L));
+  if (hi > 79) {
+    hi = -42.379L + 2.04901523L * t + 10.14333127L * h + -0.22475541L * t * h + -0.00683783L * t * t +
+         -0.05481717L * h * h + 0.00122874L * t * t * h + 0.00085282L * t * h * h + -0.00000199L * t * t * h * h;
+    if ((h < 13) && (t >= 80.0L) && (t <= 112.0L)) {
+      hi -= ((13.0L - h) * 0.25L) * sqrtl((17.0L - fabsl(t - 95.0L)) * 0.05882L);
+    } else if ((h > 85.0L) && (t >= 80.0L) && (t <= 87.0L)) {
+      hi += ((h - 85.0L) * 0.1L) * ((87.0L - t) * 0.2L);
+    }
+  }
+  return hi;
+}
+
+/**
+ * Heat index, DHT library float path (DHT::computeHeatIndex with its conversions).
+ */
+float floatHeatIndex(float temperature, float percentHumidity, bool isFahrenheit) {
+  float hi;
+  if (!isFahrenheit) temperature = temperature * 1.8 + 32;
+  hi = 0.5 * (temperature + 61.0 + ((temperature - 68.0) * 1.2) + (percentHumidity * 0.094));
+  if (hi > 79) {
+    hi = -42.379 + 2.04901523 * temperature + 10.14333127 * percentHumidity + -0.22475541 * temperature * percentHumidity +
+         -0.00683783 * pow(temperature, 2) + -0.05481717 * pow(percentHumidity, 2) +
+         0.00122874 * pow(temperature, 2) * percentHumidity + 0.00085282 * temperature * pow(percentHumidity, 2) +
+         -0.00000199 * pow(temperature, 2) * pow(percentHumidity, 2);
+    if ((percentHumidity < 13) && (temperature >= 80.0) && (temperature <= 112.0)) {
+      hi -= ((13.0 - percentHumidity) * 0.25) * sqrt((17.0 - fabs(temperature - 95.0)) * 0.05882);
+    } else if ((percentHumidity > 85.0) && (temperature >= 80.0) && (temperature <= 87.0)) {
+      hi += ((percentHumidity - 85.0) * 0.1) * ((87.0 - temperature) * 0.2);
+    }
+  }
+  return isFahrenheit ? hi : (hi - 32) * 0.55555;
+}
+
+/**
+ * True if a result in tenths is the exact value rounded half away from zero. When the exact value is
+ * a tie within the kernel resolution (1e-8, 1e-7 tenths), either neighbour is taken.
+ */
+bool isRounded(int result, long double exact) {
+  long double tenths = exact * 10;
+  long double fraction = fabsl(tenths - truncl(tenths));
+  if (fabsl(fraction - 0.5L) < 1e-7L) return result == (int)floorl(tenths) || result == (int)ceill(tenths);
+  return result == (int)llroundl(tenths);
+}
+
+/**
+ * Round a division half away from zero, exactly.
+ */
+int roundDiv(int value, int divisor) {
+  return value >= 0 ? (2 * value + divisor) / (2 * divisor) : -((-2 * value + divisor) / (2 * divisor));
+}
+
+int main() {
+  long pairs = 0;
+  long failures = 0;
+  long ties = 0;
+  long floatDiffC = 0;
+  long floatDiffF = 0;
+  int floatMaxDiff = 0;
+
+  for (int c10 = -400; c10 <= 800; c10++) {
+    for (int h10 = 0; h10 <= 1000; h10++) {
+      int16_t heatIndexC;
+      int16_t heatIndexF;
+      CFHeatIndex::compute(c10, h10, heatIndexC, heatIndexF);
+      pairs++;
+
+      // Tenths of C are exact hundredths of F.
+      long double exactF = exactHeatIndexF((c10 * 18 + 3200) / 100.0L, h10 / 10.0L);
+      long double exactC = (exactF - 32) * 0.55555L;
+      if (!isRounded(heatIndexF, exactF) || !isRounded(heatIndexC, exactC)) {
+        if (failures++ < 10) {
+          printf("FAIL %.1f C %.1f %%: %d %d, exact %.6Lf %.6Lf\n", c10 / 10.0, h10 / 10.0, heatIndexC, heatIndexF, exactC * 10, exactF * 10);
+        }
+      }
+      if (heatIndexF != (int)llroundl(exactF * 10) || heatIndexC != (int)llroundl(exactC * 10)) ties++;
+
+      // The float path rounded the same way.
+      float temperatureC = c10 / 10.0f;
+      float humidity = h10 / 10.0f;
+      int floatC = (int)lroundf(floatHeatIndex(temperatureC, humidity, false) * 10);
+      int floatF = (int)lroundf(floatHeatIndex(temperatureC * 1.8 + 32, humidity, true) * 10);
+      if (floatC != heatIndexC) floatDiffC++;
+      if (floatF != heatIndexF) floatDiffF++;
+      if (abs(floatC - heatIndexC) > floatMaxDiff) floatMaxDiff = abs(floatC - heatIndexC);
+      if (abs(floatF - heatIndexF) > floatMaxDiff) floatMaxDiff = abs(floatF - heatIndexF);
+    }
+  }
+
+  // Conversions, over every tenth the sensors and the heat index can give.
+  for (int c10 = -1000; c10 <= 1500; c10++) {
+    if (CFHeatIndex::celsiusToFahrenheit(c10) != roundDiv(c10 * 9, 5) + 320) {
+      if (failures++ < 10) printf("FAIL celsiusToFahrenheit(%d)\n", c10);
+    }
+  }
+  for (int f10 = -1480; f10 <= 3020; f10++) {
+    if (CFHeatIndex::fahrenheitToCelsius(f10) != roundDiv((f10 - 320) * 5, 9)) {
+      if (failures++ < 10) printf("FAIL fahrenheitToCelsius(%d)\n", f10);
+    }
+  }
+
+  printf("%ld pairs, %ld failures, %ld ties\n", pairs, failures, ties);
+  printf("float path: %ld C and %ld F results differ (%.3f%%), by %.1f at most\n", floatDiffC, floatDiffF,
+         100.0 * (floatDiffC + floatDiffF) / (2 * pairs), floatMaxDiff / 10.0);
+  if (floatMaxDiff > 1) {
+    printf("FAIL float path differs by more than 0.1\n");
+    failures++;
+  }
+  return failures == 0 ? 0 : 1;
+}
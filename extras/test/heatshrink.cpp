@@ -0,0 +1,273 @@
+/**
+ * heatshrink.cpp
+ *
+ * Host test of CFHeatshrinkDecoder:
+ *   - fixtures assembled by hand from the stream format, with literals, back-references, overlapping
+ *     runs and the padding of the last byte;
+ *   - round trips of text, binary, zero runs and incompressible data, longer than the window, compressed
+ *     by a reference encoder for several window and lookahead sizes, and decoded with input and output
+ *     chunks of every size from 1 byte to the whole stream;
+ *   - reset between streams and the window and lookahead limits.
+ *
+ *   g++ -std=c++11 -O2 -I src extras/test/heatshrink.cpp src/CFHeatshrinkDecoder.cpp -o heatshrink
+ *   ./heatshrink
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFHeatshrinkDecoder.h>  // CF Heatshrink Decoder.
+#include <cstdio>                 // Output.
+#include <random>                 // Test data.
+#include <string>                 // Names.
+#include <vector>                 // Buffers.
+
+typedef std::vector<uint8_t> Bytes;
+
+static int failures = 0;  // Checks failed.
+
+/**
+ * A stream written bit by bit, MSB first, the last byte padded with 0 bits.
+ */
+class BitWriter {
+ public:
+  Bytes bytes;
+  void write(uint32_t value, uint8_t qty) {
+    for (int i = qty - 1; i >= 0; i--) {
+      if (_bitsQty == 0) bytes.push_back(0);
+      if ((value >> i) & 1) bytes.back() |= 0x80 >> _bitsQty;
+      _bitsQty = (_bitsQty + 1) % 8;
+    }
+  }
+  void literal(uint8_t value) {
+    write(1, 1);
+    write(value, 8);
+  }
+  void backref(uint16_t offset, uint16_t length, uint8_t windowBits, uint8_t lookaheadBits) {
+    write(0, 1);
+    write(offset - 1, windowBits);
+    write(length - 1, lookaheadBits);
+  }
+
+ private:
+  uint8_t _bitsQty = 0;
+};
+
+/**
+ * Reference encoder: greedy LZSS in the heatshrink format, back-references of 2 bytes or more.
+ */
+Bytes encode(const Bytes &data, uint8_t windowBits, uint8_t lookaheadBits) {
+  BitWriter writer;
+  size_t window = (size_t)1 << windowBits;
+  size_t maxLength = (size_t)1 << lookaheadBits;
+  size_t i = 0;
+  while (i < data.size()) {
+    size_t bestLength = 0;
+    size_t bestOffset = 0;
+    for (size_t offset = 1; offset <= window && offset <= i; offset++) {
+      size_t length = 0;
+      while (length < maxLength && i + length < data.size() && data[i + length - offset] == data[i + length]) length++;
+      if (length > bestLength) {
+        bestLength = length;
+        bestOffset = offset;
+        if (length == maxLength) break;
+      }
+    }
+    if (bestLength >= 2) {
+      writer.backref(bestOffset, bestLength, windowBits, lookaheadBits);
+      i += bestLength;
+    } else {
+      writer.literal(data[i++]);
+    }
+  }
+  return writer.bytes;
+}
+
+/**
+ * Decode a stream fed in chunks of inputSize bytes, into an output buffer of outputSize bytes.
+ */
+Bytes decode(CFHeatshrinkDecoder &decoder, const Bytes &stream, size_t inputSize, size_t outputSize) {
+  Bytes result;
+  Bytes output(outputSize);
+  for (size_t position = 0; position < stream.size(); position += inputSize) {
+    const uint8_t *input = stream.data() + position;
+    size_t length = std::min(inputSize, stream.size() - position);
+    // The output is drained until the chunk is consumed and the decoder doesn't fill it anymore.
+    while (true) {
+      size_t produced = decoder.decode(input, length, output.data(), outputSize);
+      result.insert(result.end(), output.begin(), output.begin() + produced);
+      if (produced < outputSize && length == 0) break;
+      if (produced == 0) return Bytes();  // Stuck with input left.
+    }
+  }
+  return result;
+}
+
+/**
+ * Check a result.
+ */
+void check(bool ok, const std::string &name) {
+  if (ok) return;
+  failures++;
+  printf("FAIL %s\n", name.c_str());
+}
+
+/**
+ * Fixtures assembled by hand.
+ */
+void testFixtures() {
+  struct Fixture {
+    const char *name;
+    uint8_t windowBits;
+    uint8_t lookaheadBits;
+    Bytes stream;
+    std::string plain;
+  };
+  std::vector<Fixture> fixtures;
+
+  // Literals only.
+  BitWriter literals;
+  for (char c : std::string("heatshrink")) literals.literal(c);
+  fixtures.push_back({"literals", 8, 4, literals.bytes, "heatshrink"});
+
+  // A back-reference that overlaps what it produces: abc then offset 3, length 6.
+  BitWriter overlap;
+  overlap.literal('a');
+  overlap.literal('b');
+  overlap.literal('c');
+  overlap.backref(3, 6, 8, 4);
+  fixtures.push_back({"overlap", 8, 4, overlap.bytes, "abcabcabc"});
+
+  // A run: one byte then offset 1, the longest length.
+  BitWriter run;
+  run.literal('z');
+  run.backref(1, 16, 8, 4);
+  fixtures.push_back({"run", 8, 4, run.bytes, std::string(17, 'z')});
+
+  // The same as bytes, checked against the stream format: 1 01111010 0 00000000 1111, padded.
+  fixtures.push_back({"run bytes", 8, 4, Bytes{0xBD, 0x00, 0x3C}, std::string(17, 'z')});
+
+  // The smallest window, with a back-reference to its far end.
+  BitWriter smallest;
+  for (char c : std::string("0123456789ABCDEF")) smallest.literal(c);
+  smallest.backref(16, 8, 4, 3);
+  fixtures.push_back({"smallest window", 4, 3, smallest.bytes, "0123456789ABCDEF01234567"});
+
+  // The largest window and lookahead.
+  BitWriter largest;
+  largest.literal('x');
+  largest.literal('y');
+  largest.backref(2, 16384, 15, 14);
+  std::string largestPlain;
+  for (int i = 0; i < 8193; i++) largestPlain += "xy";
+  fixtures.push_back({"largest window", 15, 14, largest.bytes, largestPlain});
+
+  for (const Fixture &fixture : fixtures) {
+    // The reference encoder must agree with the hand assembled streams.
+    Bytes plain(fixture.plain.begin(), fixture.plain.end());
+    if (std::string(fixture.name) == "literals" || std::string(fixture.name) == "run bytes") {
+      check(encode(plain, fixture.windowBits, fixture.lookaheadBits) == fixture.stream, std::string("encoder ") + fixture.name);
+    }
+    for (size_t inputSize : {(size_t)1, fixture.stream.size()}) {
+      for (size_t outputSize : {(size_t)1, (size_t)5, plain.size()}) {
+        CFHeatshrinkDecoder decoder(fixture.windowBits, fixture.lookaheadBits);
+        check(decode(decoder, fixture.stream, inputSize, outputSize) == plain,
+              std::string(fixture.name) + " in " + std::to_string(inputSize) + " out " + std::to_string(outputSize));
+      }
+    }
+  }
+}
+
+/**
+ * Round trips through the reference encoder.
+ */
+void testRoundTrips() {
+  std::mt19937 rng(1);
+  auto byte = [&rng]() { return (uint8_t)(rng() & 0xFF); };
+
+  // Words from a small vocabulary, like text or a JSON payload.
+  Bytes text;
+  std::vector<Bytes> words;
+  for (int i = 0; i < 40; i++) {
+    Bytes word(1 + rng() % 12);
+    for (uint8_t &b : word) b = 'a' + rng() % 26;
+    words.push_back(word);
+  }
+  while (text.size() < 6000) {
+    const Bytes &word = words[rng() % words.size()];
+    text.insert(text.end(), word.begin(), word.end());
+    text.push_back(' ');
+  }
+
+  // A firmware-like image: magic byte, code with repeated sequences, and zero padding.
+  Bytes binary(1, 0xE9);
+  while (binary.size() < 5000) {
+    if (rng() % 5 == 0) {
+      binary.push_back(byte());
+    } else {
+      const Bytes &word = words[rng() % words.size()];
+      for (uint8_t b : word) binary.push_back(b ^ 0x5A);
+    }
+  }
+  binary.insert(binary.end(), 700, 0);
+
+  // Incompressible.
+  Bytes noise(3000);
+  for (uint8_t &b : noise) b = byte();
+
+  struct Sample {
+    const char *name;
+    Bytes *data;
+  } samples[] = {{"text", &text}, {"binary", &binary}, {"noise", &noise}};
+  struct Size {
+    uint8_t windowBits;
+    uint8_t lookaheadBits;
+  } sizes[] = {{4, 3}, {8, 4}, {10, 5}, {11, 4}, {13, 8}};
+  size_t inputSizes[] = {1, 3, 64, 1460, (size_t)-1};
+  size_t outputSizes[] = {1, 7, 256, 4096};
+
+  for (const Sample &sample : samples) {
+    for (const Size &size : sizes) {
+      Bytes stream = encode(*sample.data, size.windowBits, size.lookaheadBits);
+      printf("%-7s w %2d l %d: %5zu -> %5zu bytes\n", sample.name, size.windowBits, size.lookaheadBits, sample.data->size(), stream.size());
+      for (size_t inputSize : inputSizes) {
+        if (inputSize == (size_t)-1) inputSize = stream.size();
+        for (size_t outputSize : outputSizes) {
+          CFHeatshrinkDecoder decoder(size.windowBits, size.lookaheadBits);
+          check(decode(decoder, stream, inputSize, outputSize) == *sample.data,
+                std::string(sample.name) + " w " + std::to_string(size.windowBits) + " l " + std::to_string(size.lookaheadBits) +
+                    " in " + std::to_string(inputSize) + " out " + std::to_string(outputSize));
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Reset between streams, and the window and lookahead limits.
+ */
+void testResetAndLimits() {
+  Bytes first(500, 'a');
+  Bytes second;
+  for (int i = 0; i < 500; i++) second.push_back('0' + i % 7);
+  CFHeatshrinkDecoder decoder(8, 4);
+  check(decode(decoder, encode(first, 8, 4), 1, 3) == first, "first stream");
+  decoder.reset();
+  check(decode(decoder, encode(second, 8, 4), 1, 3) == second, "second stream after reset");
+
+  check(CFHeatshrinkDecoder(4, 3).isValid(), "window 4 lookahead 3 is valid");
+  check(CFHeatshrinkDecoder(15, 14).isValid(), "window 15 lookahead 14 is valid");
+  check(!CFHeatshrinkDecoder(3, 3).isValid(), "window 3 is invalid");
+  check(!CFHeatshrinkDecoder(16, 4).isValid(), "window 16 is invalid");
+  check(!CFHeatshrinkDecoder(8, 2).isValid(), "lookahead 2 is invalid");
+  check(!CFHeatshrinkDecoder(8, 8).isValid(), "lookahead as large as the window is invalid");
+}
+
+int main() {
+  testFixtures();
+  testRoundTrips();
+  testResetAndLimits();
+  printf("%d failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,487 @@
+/**
+ * soak.cpp
+ *
+ * Accelerated soak test of the timing of CFVirtualButton, CFMistMakerHelper and CFThingsBoardHelper.
+ * The sketch runs on a simulated board whose clock only moves when the sketch waits, so months go by
+ * in minutes and millis() wraps (every 49.7 days) in the middle of the timers:
+ *   - a button on pin 5 pushed every few minutes, and right before each wrap; the pulse must end on
+ *     the first loop after 100 ms, not before and not later;
+ *   - a mist maker, its button on pin 12 and its status on pin 14, turned on and off every couple of
+ *     hours, and right before each wrap; it must get there within 3 s and with a single push;
+ *   - ThingsBoard connected to a broker in the same process, on a localhost socket. Telemetry must go
+ *     every minute, connection attempts must be a minute apart while the broker refuses them (an
+ *     outage every 20 days and one across the first wrap) and a dropped connection must be back on
+ *     the next loop.
+ * Each report period shows loops, loop latency (real time per loop and longest virtual loop), heap in
+ * use, messages and missed deadlines. It ends with the latency drift and the heap growth, and exits
+ * with 1 if a deadline was missed or the heap grew.
+ *
+ * On the board unsigned long has 32 bits, on a 64-bit host it has 64 and the library timers would
+ * never wrap, so the library is built from a copy where unsigned long is uint32_t (see
+ * extras/README.md), or with -m32.
+ *
+ *   ./soak [days] [loop period (ms)] [report period (days)]
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <Arduino.h>              // Arduino library.
+#include <CFMistMakerHelper.h>    // CF Mist Maker.
+#include <CFThingsBoardHelper.h>  // CF ThingsBoard.
+#include <CFVirtualButton.h>      // CF Virtual Button.
+#include <CFWatchdog.h>           // CF Watchdog.
+#include <algorithm>              // Sort.
+#include <arpa/inet.h>            // Addresses.
+#include <chrono>                 // Real time.
+#include <cstdio>                 // Output.
+#include <fcntl.h>                // Non-blocking sockets.
+#include <netinet/in.h>           // Internet sockets.
+#include <sys/socket.h>           // Sockets.
+#include <unistd.h>               // Close.
+#include <utility>                // Declval.
+#include <vector>                 // Buffers.
+
+static_assert(sizeof(std::declval<CFThingsBoardHelper &>().getConnectTime()) == 4,
+              "The library must be built with 32-bit unsigned long, as on the board. See extras/README.md.");
+
+#define PIN_BUTTON 5        // Virtual button pin.
+#define PIN_MIST_BUTTON 12  // Mist maker button pin.
+#define PIN_MIST_STATUS 14  // Mist maker status pin.
+
+#define BUTTON_TIME 100      // Button pulse (ms).
+#define MIST_TIME 3000       // Max time to change the mist maker (ms).
+#define TB_SEND_TIME 60000   // Time between telemetry submissions (ms).
+#define TB_RETRY_TIME 60000  // Time between connection attempts (ms).
+#define BROKER_POLL_TIME 20  // Time between broker polls (ms).
+
+#define MINUTE 60000ULL      // Minute (ms).
+#define HOUR (60 * MINUTE)   // Hour (ms).
+#define DAY (24 * HOUR)      // Day (ms).
+#define WRAP 0x100000000ULL  // millis() wrap (ms).
+
+static int failures = 0;       // Deadlines missed.
+static uint64_t loopTime = 0;  // Loop period (ms).
+static uint64_t slack = 0;     // Time a deadline may be missed by, the longest a loop may take (ms).
+
+/**
+ * Virtual time of the board (ms), it never wraps.
+ */
+static uint64_t now() {
+  return ArduinoHost::getTime() / 1000;
+}
+
+/**
+ * Report a missed deadline.
+ */
+static void miss(const char *format, uint64_t value) {
+  failures++;
+  if (failures <= 20) {
+    printf("  MISS at %.3f days: ", now() / (double)DAY);
+    printf(format, (unsigned long long)value);
+    printf("\n");
+  }
+}
+
+/**
+ * ThingsBoard MQTT broker on a localhost socket, polled from the system task of the board and after
+ * each loop, so messages are timed by the loop that sent them. It answers
+ * CONNECT, SUBSCRIBE and PINGREQ, and takes note of when telemetry and connection attempts come.
+ */
+class Broker {
+ public:
+  uint16_t port = 0;            // Port listened.
+  bool refusing = false;        // Flag that indicates connections are refused (CONNACK 5).
+  uint64_t telemetryQty = 0;    // Telemetry messages.
+  uint64_t attributesQty = 0;   // Attribute messages.
+  uint64_t connectsQty = 0;     // Connections accepted.
+  uint64_t refusedQty = 0;      // Connections refused.
+  uint64_t pingsQty = 0;        // Pings.
+  uint64_t tLastTelemetry = 0;  // Last telemetry of the connection, 0 for none.
+  uint64_t tLastAttempt = 0;    // Last connection attempt, 0 for none.
+  uint64_t tDropped = 0;        // When the connection was dropped or refused, 0 if it wasn't.
+
+  bool begin() {
+    _listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (_listener < 0 || bind(_listener, (sockaddr *)&address, length) != 0 || listen(_listener, 4) != 0 ||
+        getsockname(_listener, (sockaddr *)&address, &length) != 0) {
+      return false;
+    }
+    fcntl(_listener, F_SETFL, O_NONBLOCK);
+    port = ntohs(address.sin_port);
+    return true;
+  }
+
+  void poll(bool force = false) {
+    if (!force && now() - _tLastPoll < BROKER_POLL_TIME) return;
+    _tLastPoll = now();
+    if (_client < 0) {
+      _client = accept(_listener, NULL, NULL);
+      if (_client < 0) return;
+      fcntl(_client, F_SETFL, O_NONBLOCK);
+    }
+    uint8_t buffer[512];
+    ssize_t length;
+    while ((length = recv(_client, buffer, sizeof(buffer), 0)) > 0) _rx.insert(_rx.end(), buffer, buffer + length);
+    if (length == 0) {
+      drop();
+      return;
+    }
+    _dispatch();
+  }
+
+  void drop() {
+    if (_client < 0) return;
+    close(_client);
+    _client = -1;
+    _rx.clear();
+    tLastTelemetry = 0;
+    tDropped = now();
+  }
+
+ private:
+  int _listener = -1;        // Listening socket.
+  int _client = -1;          // Device socket, -1 if it isn't connected.
+  std::vector<uint8_t> _rx;  // Bytes received and not handled.
+  uint64_t _tLastPoll = 0;   // Last poll.
+
+  void _send(const uint8_t *packet, size_t length) { send(_client, packet, length, MSG_NOSIGNAL); }
+
+  void _dispatch() {
+    while (_client >= 0 && _rx.size() >= 2) {
+      // Fixed header: type and remaining length.
+      size_t remaining = 0, header = 1;
+      uint8_t shift = 0;
+      do {
+        if (header >= _rx.size()) return;
+        remaining |= (size_t)(_rx[header] & 0x7F) << shift;
+        shift += 7;
+      } while (_rx[header++] & 0x80);
+      if (_rx.size() < header + remaining) return;
+      uint8_t type = _rx[0] >> 4;
+      const uint8_t *body = _rx.data() + header;
+
+      if (type == 1) {  // CONNECT.
+        _onConnect();
+        uint8_t connack[] = {0x20, 0x02, 0x00, (uint8_t)(refusing ? 0x05 : 0x00)};
+        _send(connack, sizeof(connack));
+        if (refusing) {
+          drop();
+          return;
+        }
+      } else if (type == 3) {  // PUBLISH.
+        size_t topicLength = (body[0] << 8) | body[1];
+        std::string topic((const char *)body + 2, topicLength);
+        if (topic == "v1/devices/me/telemetry") {
+          _onTelemetry();
+        } else if (topic == "v1/devices/me/attributes") {
+          attributesQty++;
+        }
+      } else if (type == 8) {  // SUBSCRIBE.
+        uint8_t suback[] = {0x90, 0x03, body[0], body[1], 0x00};
+        _send(suback, sizeof(suback));
+      } else if (type == 12) {  // PINGREQ.
+        uint8_t pingresp[] = {0xD0, 0x00};
+        _send(pingresp, sizeof(pingresp));
+        pingsQty++;
+      } else if (type == 14) {  // DISCONNECT.
+        drop();
+        return;
+      }
+      _rx.erase(_rx.begin(), _rx.begin() + header + remaining);
+    }
+  }
+
+  void _onConnect() {
+    uint64_t t = now();
+    if (refusing) {
+      // Attempts must be a retry time apart, not less, and not much more.
+      if (tLastAttempt > 0 && tLastAttempt >= tDropped) {
+        uint64_t gap = t - tLastAttempt;
+        if (gap <= TB_RETRY_TIME) miss("connection attempt early, %llu ms after the last one", gap);
+        if (gap > TB_RETRY_TIME + slack) miss("connection attempt late, %llu ms after the last one", gap);
+      }
+      refusedQty++;
+      tLastAttempt = t;
+      tDropped = t;
+      return;
+    }
+    // Back within a retry time from the last refused attempt, or on the next loop after a drop.
+    uint64_t limit = tLastAttempt >= tDropped && tLastAttempt > 0 ? TB_RETRY_TIME + slack : slack;
+    uint64_t from = tLastAttempt >= tDropped && tLastAttempt > 0 ? tLastAttempt : tDropped;
+    if (tDropped > 0 && t - from > limit) miss("reconnection late, %llu ms", t - from);
+    connectsQty++;
+    tLastAttempt = 0;
+    tDropped = 0;
+    tLastTelemetry = 0;
+  }
+
+  void _onTelemetry() {
+    uint64_t t = now();
+    if (tLastTelemetry > 0) {
+      uint64_t gap = t - tLastTelemetry;
+      if (gap <= TB_SEND_TIME) miss("telemetry early, %llu ms after the last one", gap);
+      if (gap > TB_SEND_TIME + slack) miss("telemetry late, %llu ms after the last one", gap);
+    }
+    telemetryQty++;
+    tLastTelemetry = t;
+  }
+};
+
+/**
+ * Stats of a report period.
+ */
+struct Period {
+  uint64_t loopsQty = 0;      // Loops.
+  uint64_t realTime = 0;      // Real time spent on the loops (ns).
+  uint64_t maxLoop = 0;       // Longest loop, in virtual time (ms).
+  size_t heapUsed = 0;        // Heap in use at the end.
+  uint64_t telemetryQty = 0;  // Telemetry messages.
+  uint64_t connectsQty = 0;   // Connections.
+  int failures = 0;           // Deadlines missed.
+};
+
+static Broker broker;
+static CFVirtualButton button(PIN_BUTTON, LOW);
+static CFMistMakerHelper mistMaker(PIN_MIST_BUTTON, PIN_MIST_STATUS);
+static CFThingsBoardHelper thingsBoard("soak", "1.0");
+
+static bool mist = false;            // Mist maker model: on or off.
+static uint64_t mistTogglesQty = 0;  // Mist maker toggles.
+
+// Mist maker changes.
+enum MistChange {
+  MIST_TOGGLE,  // The other way around.
+  MIST_ON,      // On, if it's off.
+  MIST_OFF      // Off.
+};
+
+int main(int argc, char **argv) {
+  double days = argc > 1 ? atof(argv[1]) : 100;
+  loopTime = argc > 2 ? atoi(argv[2]) : 250;
+  double reportDays = argc > 3 ? atof(argv[3]) : 5;
+  if (days <= 0 || loopTime == 0 || reportDays <= 0) {
+    printf("Usage: soak [days] [loop period (ms)] [report period (days)]\n");
+    return 1;
+  }
+  // The mist maker reads its status up to twice a loop, for up to 500 ms each, and a connection takes
+  // a few broker polls.
+  slack = loopTime + 1000 + 10 * BROKER_POLL_TIME;
+
+  // Quiet library, the board Serial is discarded.
+  Logger::setLogLevel(Logger::ERROR);
+  ArduinoHost::setSerialOutput(NULL);
+
+  if (!broker.begin()) {
+    printf("Could not listen on localhost.\n");
+    return 1;
+  }
+  ArduinoHost::setSystemTask([]() { broker.poll(); });
+
+  // Mist maker: a push (falling edge on its button) toggles it, the status pin follows.
+  ArduinoHost::getBoard()->onPinWrite = [](uint8_t pin, uint8_t level) {
+    static uint8_t lastLevel = HIGH;
+    if (pin != PIN_MIST_BUTTON) return;
+    if (lastLevel == HIGH && level == LOW) {
+      mist = !mist;
+      mistTogglesQty++;
+      ArduinoHost::setPin(PIN_MIST_STATUS, mist ? HIGH : LOW);
+    }
+    lastLevel = level;
+  };
+
+  // Sketch setup.
+  CFWatchdog::begin();
+  button.begin();
+  mistMaker.begin();
+  thingsBoard.setServerURL("127.0.0.1");
+  thingsBoard.setServerPort(broker.port);
+  thingsBoard.setToken("soak");
+  thingsBoard.setAttributeValue("firmware", "1.0");
+
+  // Schedule, its memory isn't counted as the sketch heap. Right before each wrap the button is pushed and the mist maker turned off (it's turned on
+  // a while before, so the loops are short), both finish after the wrap. Nothing else is scheduled
+  // around it.
+  size_t heapSketch = ArduinoHost::getHeapUsed();
+  uint64_t end = (uint64_t)(days * DAY);
+  std::vector<uint64_t> wraps;
+  for (uint64_t t = WRAP; t < end; t += WRAP) wraps.push_back(t);
+  auto acrossWrap = [&](uint64_t from, uint64_t to) {
+    for (uint64_t wrap : wraps) {
+      if (from < wrap && wrap <= to) return true;
+    }
+    return false;
+  };
+  auto nearWrap = [&](uint64_t t) {
+    for (uint64_t wrap : wraps) {
+      if (t + 15 * MINUTE >= wrap && t <= wrap + MINUTE) return true;
+    }
+    return false;
+  };
+  std::vector<uint64_t> pushes;
+  std::vector<std::pair<uint64_t, MistChange>> mistChanges;
+  for (uint64_t t = 7 * MINUTE + 13000; t < end; t += 7 * MINUTE + 13000) {
+    if (!nearWrap(t)) pushes.push_back(t);
+  }
+  for (uint64_t t = 2 * HOUR + 17 * MINUTE; t < end; t += 2 * HOUR + 17 * MINUTE) {
+    if (!nearWrap(t)) mistChanges.push_back({t, MIST_TOGGLE});
+  }
+  for (uint64_t wrap : wraps) {
+    pushes.push_back(wrap - 50);
+    mistChanges.push_back({wrap - 10 * MINUTE, MIST_ON});
+    mistChanges.push_back({wrap - 50, MIST_OFF});
+  }
+  std::sort(pushes.begin(), pushes.end());
+  std::sort(mistChanges.begin(), mistChanges.end());
+
+  // Broker refusing connections (start, end), and dropping the connection.
+  std::vector<std::pair<uint64_t, uint64_t>> outages;
+  for (uint64_t t = 7 * DAY + 7 * HOUR; t < end; t += 20 * DAY) outages.push_back({t, t + 3 * HOUR});
+  if (!wraps.empty()) outages.push_back({wraps[0] - 20 * MINUTE, wraps[0] + 20 * MINUTE});
+  uint64_t tNextKick = 3 * DAY + HOUR;
+
+  printf("Soak: %.1f days, loop every %llu ms, millis() wraps at", days, (unsigned long long)loopTime);
+  for (uint64_t wrap : wraps) printf(" %.2f", wrap / (double)DAY);
+  printf(" days.\n\n");
+  printf("%8s %10s %10s %10s %10s %10s %10s %8s\n", "days", "loops", "ns/loop", "max ms", "heap B", "telemetry",
+         "connects", "missed");
+
+  size_t pushIndex = 0;      // Next button push.
+  size_t mistIndex = 0;      // Next mist maker change.
+  uint64_t tPush = 0;        // Last button push, 0 if the pulse ended.
+  uint64_t tMist = 0;        // Last mist maker change, 0 if it's done.
+  uint64_t mistToggles = 0;  // Toggles before the last mist maker change.
+  bool mistRequest = false;  // Mist maker status requested.
+  size_t wrapPulses = 0;     // Button pulses across a wrap.
+  size_t wrapMist = 0;       // Mist maker changes across a wrap.
+  uint64_t reportTime = (uint64_t)(reportDays * DAY);
+  std::vector<Period> periods;
+  periods.reserve(end / reportTime + 2);
+  size_t heapSchedule = ArduinoHost::getHeapUsed() - heapSketch;
+  Period period;
+  uint64_t tReport = reportTime;
+  auto started = std::chrono::steady_clock::now();
+  while (now() < end) {
+    uint64_t t = now();
+
+    // Outages and dropped connections.
+    bool refusing = false;
+    for (const std::pair<uint64_t, uint64_t> &outage : outages) refusing |= t >= outage.first && t < outage.second;
+    if (refusing && !broker.refusing) broker.drop();
+    broker.refusing = refusing;
+    if (t >= tNextKick) {
+      if (!refusing) broker.drop();
+      tNextKick += 3 * DAY;
+    }
+
+    // Button and mist maker.
+    if (pushIndex < pushes.size() && t >= pushes[pushIndex] && tPush == 0) {
+      pushIndex++;
+      button.push();
+      if (ArduinoHost::getPin(PIN_BUTTON) != HIGH) miss("button push ignored", 0);
+      tPush = t;
+    }
+    if (mistIndex < mistChanges.size() && t >= mistChanges[mistIndex].first && tMist == 0) {
+      MistChange change = mistChanges[mistIndex++].second;
+      if (change != MIST_ON || !mistRequest) {
+        mistRequest = change == MIST_TOGGLE ? !mistRequest : change == MIST_ON;
+        if (mistRequest) mistMaker.turnOn();
+        else mistMaker.turnOff();
+        tMist = t;
+        mistToggles = mistTogglesQty;
+      }
+    }
+
+    // Sketch loop.
+    bool pulseDue = tPush > 0 && t - tPush > BUTTON_TIME;
+    auto loopStarted = std::chrono::steady_clock::now();
+    thingsBoard.setTelemetryValue("mist", mistMaker.getStatus());
+    thingsBoard.setTelemetryValue("uptime", millis() / 1000);
+    button.loop();
+    mistMaker.loop();
+    thingsBoard.loop();
+    CFWatchdog::loop();
+    broker.poll(true);
+    period.realTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - loopStarted).count();
+    period.loopsQty++;
+    period.maxLoop = max(period.maxLoop, now() - t);
+
+    // The pulse ends on the first loop after its time.
+    if (tPush > 0) {
+      bool released = ArduinoHost::getPin(PIN_BUTTON) == LOW;
+      if (released && !pulseDue) miss("button released early, after %llu ms", t - tPush);
+      if (!released && pulseDue) miss("button released late, still pushed after %llu ms", t - tPush);
+      if (released && acrossWrap(tPush, t)) wrapPulses++;
+      if (released || pulseDue) tPush = 0;
+    }
+
+    // The mist maker gets where it was asked with a single push, and stays there.
+    if (tMist > 0 && now() - tMist > MIST_TIME) {
+      uint64_t toggles = mistTogglesQty - mistToggles;
+      if (mist != mistRequest || toggles != 1) {
+        miss("mist maker not changed with a single push in time, %llu pushes", toggles);
+        mist = mistRequest;
+        ArduinoHost::setPin(PIN_MIST_STATUS, mist ? HIGH : LOW);
+      } else if (acrossWrap(tMist, now())) {
+        wrapMist++;
+      }
+      tMist = 0;
+    }
+
+    // Wait for the next loop, or for the next event.
+    uint64_t tNext = now() + loopTime;
+    if (pushIndex < pushes.size() && pushes[pushIndex] > now()) tNext = min(tNext, pushes[pushIndex]);
+    if (mistIndex < mistChanges.size() && mistChanges[mistIndex].first > now()) {
+      tNext = min(tNext, mistChanges[mistIndex].first);
+    }
+    delay(max(tNext - now(), (uint64_t)1));
+
+    // Report.
+    if (now() >= tReport || now() >= end) {
+      period.heapUsed = ArduinoHost::getHeapUsed() - heapSchedule;
+      period.telemetryQty = broker.telemetryQty;
+      period.connectsQty = broker.connectsQty;
+      period.failures = failures;
+      periods.push_back(period);
+      const Period *last = periods.size() > 1 ? &periods[periods.size() - 2] : NULL;
+      printf("%8.2f %10llu %10llu %10llu %10zu %10llu %10llu %8d\n", now() / (double)DAY,
+             (unsigned long long)period.loopsQty, (unsigned long long)(period.realTime / period.loopsQty),
+             (unsigned long long)period.maxLoop, period.heapUsed,
+             (unsigned long long)(period.telemetryQty - (last ? last->telemetryQty : 0)),
+             (unsigned long long)(period.connectsQty - (last ? last->connectsQty : 0)),
+             period.failures - (last ? last->failures : 0));
+      period = Period();
+      tReport += reportTime;
+    }
+  }
+  double realTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  // Summary.
+  const Period &first = periods.front();
+  const Period &last = periods.back();
+  double drift = ((double)last.realTime / last.loopsQty) / ((double)first.realTime / first.loopsQty);
+  long heapGrowth = (long)last.heapUsed - (long)first.heapUsed;
+  printf("\n%.1f days in %.1f s (%.0fx real time).\n", days, realTime, now() / 1000.0 / realTime);
+  printf("Telemetry: %llu, attributes: %llu, connections: %llu, refused: %llu, pings: %llu.\n",
+         (unsigned long long)broker.telemetryQty, (unsigned long long)broker.attributesQty,
+         (unsigned long long)broker.connectsQty, (unsigned long long)broker.refusedQty,
+         (unsigned long long)broker.pingsQty);
+  printf("Button pushes: %zu, mist maker toggles: %llu. Longest section: %s (%lu ms).\n", pushIndex,
+         (unsigned long long)mistTogglesQty, CFWatchdog::getStallSection(), (unsigned long)CFWatchdog::getStallTime());
+  printf("Across a wrap: %zu button pulses and %zu mist maker changes, of %zu wraps.\n", wrapPulses, wrapMist,
+         wraps.size());
+  if (wrapPulses < wraps.size() || wrapMist < wraps.size()) {
+    printf("  MISS: the wraps weren't crossed by the button and the mist maker.\n");
+    failures++;
+  }
+  printf("Loop latency drift (last/first period): %.2fx.\n", drift);
+  printf("Heap growth after the first period: %ld bytes, peak %zu bytes.\n", heapGrowth, ArduinoHost::getHeapPeak());
+  printf("Missed deadlines: %d.\n", failures);
+  if (heapGrowth > 0) printf("FAIL: the heap grew.\n");
+  return failures > 0 || heapGrowth > 0 ? 1 : 0;
+}
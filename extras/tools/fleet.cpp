@@ -0,0 +1,619 @@
+/**
+ * fleet.cpp
+ *
+ * Fleet simulator, to see how a ThingsBoard server copes with the whole fleet, e.g. before an upgrade.
+ *
+ * Every virtual device is a simulated board (ArduinoHost::Board) running a sketch made of the real
+ * helpers: CFDHTHelper reading a DHT22 with its reset pin, CFRelayBankHelper driving a humidifier
+ * (kept around a target humidity by the sketch) and a spare relay, and CFThingsBoardHelper publishing
+ * temperature, humidity, heat index and relays with deadbands, and taking the getRelays and setRelays
+ * RPC through CFRPCRouter. Each board has its own clock: it starts when the device boots (spread over
+ * --ramp seconds) and runs --speed times faster than real time, off by its own drift. And its own
+ * sensor model: temperature follows a daily cycle plus noise, humidity goes the other way and rises
+ * while the humidifier is on, and now and then the sensor hangs until it's powered off (the DHT bug
+ * CFDHTRecovery deals with).
+ *
+ * Devices are coroutines multiplexed over a single event loop. A device runs until its sketch waits
+ * (delay() or yield(), between loops or while waiting for CONNACK), then the loop resumes the device
+ * whose clock is due next, and sleeps when none is. Sockets are real, so any MQTT endpoint will do:
+ * a ThingsBoard server with a device per token (--token-prefix followed by the device number, from 0),
+ * or extras/tools/tb_broker, which also measures RPC round trips.
+ *
+ * Every --report seconds, and at the end, it prints devices connected, message and byte rates, and
+ * the latencies:
+ *   - connect: from CONNECT to CONNACK, as the device measured it (to the millisecond of its clock);
+ *   - queue: from a telemetry message being published to the device queue being written to the
+ *     socket, it grows when the server doesn't keep up and TCP pushes back;
+ *   - wake: how late the event loop resumed the devices. Past a few milliseconds the simulator is the
+ *     bottleneck and the numbers tell little of the server: use fewer devices, a lower speed or a
+ *     longer --loop-time.
+ *
+ *   ./fleet --host 127.0.0.1 --port 1883 --devices 1000 --duration 60 --speed 10
+ *
+ * The library timers have unsigned long as on the board, with 64 bits on the host they don't wrap,
+ * so runs should stay short of 49.7 days of device time (see the soak test for the wraps). It's for
+ * POSIX systems with ucontext.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <Arduino.h>              // Arduino library.
+#include <CFDHTHelper.h>          // CF DHT Helper.
+#include <CFRPCRouter.h>          // CF RPC Router.
+#include <CFRelayBankHelper.h>    // CF Relay Bank.
+#include <CFThingsBoardHelper.h>  // CF ThingsBoard.
+#include <DHT.h>                  // DHT.
+#include <Logger.h>               // Logger.
+#include <chrono>                 // Real time.
+#include <csignal>                // Ctrl+C.
+#include <cstdio>                 // Output.
+#include <ctime>                  // Sleep.
+#include <queue>                  // Wake ups.
+#include <random>                 // Sensor models.
+#include <string>                 // Options.
+#include <sys/mman.h>             // Coroutine stacks.
+#include <sys/resource.h>         // Sockets limit.
+#include <ucontext.h>             // Coroutines.
+#include <vector>                 // Devices.
+
+#define APP_CODE "cf-fleet"  // App code.
+#define APP_VERSION "1.0.0"  // App version.
+
+#define PIN_DHT_DATA 14     // DHT data pin.
+#define PIN_DHT_RESET 5     // DHT power pin, for the recovery.
+#define PIN_HUMIDIFIER 12   // Humidifier relay pin.
+#define PIN_SPARE 13        // Spare relay pin.
+#define RELAYS_QTY 2        // Relays.
+#define RELAY_HUMIDIFIER 0  // Humidifier relay channel.
+
+#define HUMIDITY_TARGET 55     // Humidity the sketch keeps with the humidifier (%).
+#define HUMIDITY_HYSTERESIS 3  // Humidity off the target that switches the humidifier (%).
+
+#define STACK_SIZE (64 * 1024)  // Coroutine stack size.
+
+/**
+ * Options.
+ */
+struct Options {
+  std::string host = "127.0.0.1";      // MQTT host.
+  int port = 1883;                     // MQTT port.
+  int devices = 100;                   // Devices.
+  double duration = 0;                 // Seconds to run, 0 until Ctrl+C.
+  double speed = 1;                    // Device time per real time.
+  double ramp = 10;                    // Seconds over which the devices boot.
+  double drift = 100;                  // Max clock drift of a device (ppm).
+  unsigned long interval = 60000;      // Max time between readings sent (device ms).
+  unsigned long loopTime = 10;         // Time the sketch waits between loops (device ms).
+  double hang = 0.0005;                // Probability of a reading hanging the sensor.
+  std::string tokenPrefix = "fleet-";  // Device token, followed by the device number.
+  double report = 10;                  // Seconds between reports.
+  unsigned seed = 1;                   // Random seed.
+};
+
+/**
+ * Latencies, in log-spaced buckets from 1 us to 100 s (20 per decade, about 12% wide).
+ */
+class Histogram {
+ private:
+  static const int BUCKETS = 8 * 20 + 2;  // Under 1 us, 8 decades and over 100 s.
+  uint64_t _counts[BUCKETS] = {0};        // Values per bucket.
+  uint64_t _count = 0;                    // Values.
+  double _max = 0;                        // Max value (ms).
+
+ public:
+  void add(double ms) {
+    int bucket = ms < 0.001 ? 0 : 1 + (int)(log10(ms / 0.001) * 20);
+    _counts[min(bucket, BUCKETS - 1)]++;
+    _count++;
+    _max = max(_max, ms);
+  }
+
+  // Upper edge of the bucket the percentile falls in (ms).
+  double percentile(double p) const {
+    uint64_t rank = (uint64_t)ceil(p * _count);
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+      seen += _counts[i];
+      if (seen >= rank && seen > 0) return min(0.001 * pow(10, i / 20.0), _max);
+    }
+    return _max;
+  }
+
+  // Percentile for a report, - if there are no values.
+  std::string format(double p) const {
+    char value[16];
+    snprintf(value, sizeof(value), "%.2f", percentile(p));
+    return _count > 0 ? value : "-";
+  }
+
+  void print(const char *name) const {
+    if (_count == 0) {
+      printf("  %-8s -\n", name);
+      return;
+    }
+    printf("  %-8s ms p50 %.2f p95 %.2f p99 %.2f max %.2f (%llu)\n", name, percentile(0.5), percentile(0.95),
+           percentile(0.99), _max, (unsigned long long)_count);
+  }
+};
+
+/**
+ * Counters, for the whole run and for each report period.
+ */
+struct Stats {
+  uint64_t telemetryQty = 0;   // Telemetry messages published.
+  uint64_t droppedQty = 0;     // Telemetry messages dropped.
+  uint64_t bytesSent = 0;      // Bytes written to the network.
+  uint64_t bytesReceived = 0;  // Bytes read from the network.
+  uint64_t rpcQty = 0;         // RPC handled.
+  uint64_t connectsQty = 0;    // Connections made.
+  uint64_t reconnectsQty = 0;  // Connections made again.
+  uint64_t wakesQty = 0;       // Times devices were resumed.
+  Histogram connect;           // CONNECT to CONNACK.
+  Histogram queue;             // Telemetry published to written.
+  Histogram wake;              // Wake up lateness.
+};
+
+/**
+ * A virtual device: board, helpers, clock, sensor model and coroutine.
+ */
+struct Device {
+  int index;                        // Device number.
+  ArduinoHost::Board board;         // Board.
+  CFThingsBoardHelper thingsBoard;  // ThingsBoard.
+  CFDHTHelper dht;                  // DHT sensor.
+  CFRelayBankHelper relays;         // Relays.
+  CFRPCRouter rpcRouter;            // RPC router.
+  String token;                     // Device token.
+
+  // Clock.
+  double tBoot;  // Real time it boots (s since start).
+  double rate;   // Device time per real time, speed and drift.
+
+  // Sensor model.
+  std::mt19937 rng;         // Random numbers.
+  double baseTemperature;   // Mean temperature (C).
+  double baseHumidity;      // Mean humidity without the humidifier (%).
+  double phase;             // Daily cycle phase (rad).
+  double noiseTemperature;  // Temperature noise (C).
+  double noiseHumidity;     // Humidity noise (%).
+  double humidifierGain;    // Humidity added by the humidifier so far (%).
+  double tModel;            // Device time of the last model step (s).
+  bool hung;                // Flag that indicates the sensor hangs until it's powered off.
+
+  // Sketch.
+  float lastTemperature;  // Temperature last set in telemetry.
+  float lastHumidity;     // Humidity last set in telemetry.
+  uint32_t lastRelays;    // Relays last set in telemetry.
+
+  // Metrics.
+  bool connected;               // Flag that indicates it was connected on the last loop.
+  unsigned long connectsQty;    // Connections made.
+  unsigned long publishedQty;   // Telemetry messages published, as last seen.
+  unsigned long droppedQty;     // Telemetry messages dropped, as last seen.
+  unsigned long bytesSent;      // Bytes written, as last seen.
+  unsigned long bytesReceived;  // Bytes read, as last seen.
+  double tPublished;            // Real time a message waits in the queue since, -1 if none.
+
+  // Coroutine.
+  ucontext_t context;  // Context, while it waits.
+  void *stack;         // Stack.
+
+  Device(int index, const uint8_t *relayPins) : index(index),
+                                                thingsBoard(APP_CODE, APP_VERSION),
+                                                dht(DHT22, PIN_DHT_DATA, PIN_DHT_RESET),
+                                                relays(relayPins, RELAYS_QTY) {
+  }
+
+  // Device time at a real time (us).
+  uint64_t timeAt(double t) { return t > tBoot ? (uint64_t)((t - tBoot) * rate * 1e6) : 0; }
+
+  // Real time at a device time (s).
+  double realAt(uint64_t time) { return tBoot + time / 1e6 / rate; }
+};
+
+/**
+ * A device waiting for its clock.
+ */
+struct Wake {
+  double due;      // Real time it's due (s since start).
+  uint64_t seq;    // Order it was scheduled, first come first served on ties.
+  Device *device;  // Device.
+  bool operator>(const Wake &other) const { return due > other.due || (due == other.due && seq > other.seq); }
+};
+
+// State.
+static Options options;                                                         // Options.
+static std::vector<Device *> devices;                                           // Devices.
+static std::priority_queue<Wake, std::vector<Wake>, std::greater<Wake>> wakes;  // Devices waiting, soonest first.
+static uint64_t wakeSeq = 0;                                                    // Wake ups scheduled.
+static Device *current = NULL;                                                  // Device running.
+static ucontext_t loopContext;                                                  // Event loop context.
+static Stats total;                                                             // Counters of the run.
+static Stats period;                                                            // Counters of the report period.
+static volatile sig_atomic_t stopRequested = 0;                                 // Flag set by Ctrl+C.
+static std::chrono::steady_clock::time_point tStart;                            // Start time.
+static const uint8_t relayPins[RELAYS_QTY] = {PIN_HUMIDIFIER, PIN_SPARE};       // Relay pins.
+
+/**
+ * Real time since start (s).
+ */
+static double now() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+}
+
+/**
+ * Count on both the run and the period.
+ */
+#define COUNT(field, value) \
+  do {                      \
+    total.field += value;   \
+    period.field += value;  \
+  } while (0)
+
+/**
+ * Sensor model of the device running, called by the DHT stand-in.
+ */
+static bool readSensor(uint8_t pin, float &temperature, float &humidity) {
+  Device *d = current;
+  if (pin != PIN_DHT_DATA || !d) return false;
+
+  // Powered off through the reset pin: it doesn't answer, and it's no longer hung once back.
+  if (!digitalRead(PIN_DHT_RESET)) {
+    d->hung = false;
+    return false;
+  }
+  if (d->hung) return false;
+  std::uniform_real_distribution<double> uniform(0, 1);
+  if (uniform(d->rng) < options.hang) {
+    d->hung = true;
+    return false;
+  }
+
+  // Step the model to now: noise pulled back to 0 in 10 minutes, humidifier gain lost in 15.
+  double t = millis() / 1000.0;
+  double dt = t - d->tModel;
+  d->tModel = t;
+  std::normal_distribution<double> normal(0, 1);
+  d->noiseTemperature += -d->noiseTemperature * min(dt / 600, 1.0) + 0.02 * sqrt(dt) * normal(d->rng);
+  d->noiseHumidity += -d->noiseHumidity * min(dt / 600, 1.0) + 0.1 * sqrt(dt) * normal(d->rng);
+  d->humidifierGain -= d->humidifierGain * min(dt / 900, 1.0);
+  if (digitalRead(PIN_HUMIDIFIER)) d->humidifierGain += 0.05 * dt;
+
+  double cycle = 3 * sin(2 * M_PI * t / 86400 + d->phase);
+  double celsius = d->baseTemperature + cycle + d->noiseTemperature;
+  double percent = d->baseHumidity - 2 * cycle + d->humidifierGain + d->noiseHumidity;
+  temperature = round(celsius * 10) / 10;
+  humidity = round(constrain(percent, 0.0, 100.0) * 10) / 10;
+  return true;
+}
+
+/**
+ * On ThingsBoard connect, from the loop where the helper connected: a dropped connection is back
+ * within that same loop, so connections are counted here.
+ */
+static void onConnect() {
+  Device *d = current;
+  d->thingsBoard.RPCSubscribe(d->rpcRouter);
+  COUNT(connectsQty, 1);
+  if (d->connectsQty++ > 0) COUNT(reconnectsQty, 1);
+  double ms = d->thingsBoard.getConnectTime() / d->rate;
+  total.connect.add(ms);
+  period.connect.add(ms);
+}
+
+/**
+ * Sketch setup, on the device board.
+ */
+static void setup(Device *d) {
+  d->relays.begin();
+  d->dht.begin();
+
+  // RPC.
+  d->rpcRouter.addRoute("getRelays", [](JsonVariantConst params, JsonVariant response) {
+    COUNT(rpcQty, 1);
+    current->relays.getRPC(params, response);
+  });
+  d->rpcRouter.addRoute("setRelays", [](JsonVariantConst params, JsonVariant response) {
+    COUNT(rpcQty, 1);
+    current->relays.setRPC(params, response);
+  });
+
+  // ThingsBoard.
+  d->thingsBoard.setServerURL(options.host.c_str());
+  d->thingsBoard.setServerPort(options.port);
+  d->thingsBoard.setToken(d->token);
+  d->thingsBoard.setDeviceId(d->board.chipId);
+  d->thingsBoard.setLocalIP(d->board.localIP.toString());
+  d->thingsBoard.setTransport(CFMQTTClient::QUEUED);
+  d->thingsBoard.setPersistentSession(true);
+  d->thingsBoard.setTelemetryDeadband("temperature", 0.5, 0, options.interval);
+  d->thingsBoard.setTelemetryDeadband("humidity", 2, 0, options.interval);
+  d->thingsBoard.setTelemetryDeadband("relays", 1, 0, options.interval);  // Relay changes right away.
+  d->thingsBoard.setOnThingsBoardConnectCallback(onConnect);
+}
+
+/**
+ * Take note of what the helpers did on the last loop.
+ */
+static void observe(Device *d) {
+  d->connected = d->thingsBoard.isConnected();
+
+  unsigned long publishedQty = d->thingsBoard.getPublishedQty();
+  if (publishedQty != d->publishedQty) {
+    COUNT(telemetryQty, publishedQty - d->publishedQty);
+    d->publishedQty = publishedQty;
+    if (d->tPublished < 0) d->tPublished = now();
+  }
+  if (d->tPublished >= 0 && d->thingsBoard.getQueueDepth() == 0) {
+    double ms = (now() - d->tPublished) * 1000;
+    total.queue.add(ms);
+    period.queue.add(ms);
+    d->tPublished = -1;
+  }
+  if (!d->connected) d->tPublished = -1;
+
+  unsigned long droppedQty = d->thingsBoard.getDroppedQty();
+  unsigned long bytesSent = d->thingsBoard.getBytesSent();
+  unsigned long bytesReceived = d->thingsBoard.getBytesReceived();
+  COUNT(droppedQty, droppedQty - d->droppedQty);
+  COUNT(bytesSent, bytesSent - d->bytesSent);
+  COUNT(bytesReceived, bytesReceived - d->bytesReceived);
+  d->droppedQty = droppedQty;
+  d->bytesSent = bytesSent;
+  d->bytesReceived = bytesReceived;
+}
+
+/**
+ * Sketch loop, on the device board.
+ */
+static void loop(Device *d) {
+  d->dht.loop();
+  if (d->dht.isRead()) {
+    float temperature = d->dht.getTemperatureC();
+    float humidity = d->dht.getHumidity();
+    if (temperature != d->lastTemperature || humidity != d->lastHumidity) {
+      d->thingsBoard.setTelemetryValue("temperature", temperature);
+      d->thingsBoard.setTelemetryValue("humidity", humidity);
+      d->thingsBoard.setTelemetryValue("heat_index", d->dht.getHeatIndexC());
+      d->lastTemperature = temperature;
+      d->lastHumidity = humidity;
+    }
+
+    // Humidifier.
+    if (humidity < HUMIDITY_TARGET - HUMIDITY_HYSTERESIS) d->relays.set(RELAY_HUMIDIFIER, true);
+    if (humidity > HUMIDITY_TARGET + HUMIDITY_HYSTERESIS) d->relays.set(RELAY_HUMIDIFIER, false);
+  }
+
+  d->relays.loop();
+  if (d->relays.getAll() != d->lastRelays) {
+    d->lastRelays = d->relays.getAll();
+    d->thingsBoard.setTelemetryValue("relays", d->lastRelays);
+  }
+
+  d->thingsBoard.loop();
+  observe(d);
+}
+
+/**
+ * Coroutine of a device: the sketch, forever.
+ */
+static void run(int index) {
+  Device *d = devices[index];
+  setup(d);
+  for (;;) {
+    loop(d);
+    delay(options.loopTime);
+  }
+}
+
+/**
+ * System task, on delay() and yield() of the device running: it waits for its clock in the event loop.
+ */
+static void onWait() {
+  Device *d = current;
+  wakes.push({d->realAt(d->board.time), wakeSeq++, d});
+  swapcontext(&d->context, &loopContext);
+}
+
+/**
+ * Create a device, waiting to boot.
+ */
+static Device *createDevice(int index, std::mt19937 &rng) {
+  std::uniform_real_distribution<double> uniform(0, 1);
+  Device *d = new Device(index, relayPins);
+  d->board.chipId = 0x100000 + index;
+  d->board.localIP = IPAddress(10, 0, index >> 8, index & 0xFF);
+  d->token = String(options.tokenPrefix.c_str()) + index;
+  d->tBoot = uniform(rng) * options.ramp;
+  d->rate = options.speed * (1 + (uniform(rng) * 2 - 1) * options.drift / 1e6);
+
+  d->rng.seed(options.seed + index);
+  d->baseTemperature = 18 + uniform(rng) * 10;
+  d->baseHumidity = 40 + uniform(rng) * 30;
+  d->phase = uniform(rng) * 2 * M_PI;
+  d->noiseTemperature = 0;
+  d->noiseHumidity = 0;
+  d->humidifierGain = 0;
+  d->tModel = 0;
+  d->hung = false;
+
+  d->lastTemperature = NAN;
+  d->lastHumidity = NAN;
+  d->lastRelays = 0;
+  d->connected = false;
+  d->connectsQty = 0;
+  d->publishedQty = 0;
+  d->droppedQty = 0;
+  d->bytesSent = 0;
+  d->bytesReceived = 0;
+  d->tPublished = -1;
+
+  // Stack with a guard page under it, so an overflow faults instead of corrupting another device.
+  long page = sysconf(_SC_PAGESIZE);
+  uint8_t *memory = (uint8_t *)mmap(NULL, STACK_SIZE + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    perror("mmap");
+    exit(1);
+  }
+  mprotect(memory, page, PROT_NONE);
+  d->stack = memory + page;
+  getcontext(&d->context);
+  d->context.uc_stack.ss_sp = d->stack;
+  d->context.uc_stack.ss_size = STACK_SIZE;
+  d->context.uc_link = NULL;
+  makecontext(&d->context, (void (*)())run, 1, index);
+  return d;
+}
+
+/**
+ * Print the report of a period, or of the whole run.
+ */
+static void report(const Stats &stats, double seconds, bool final) {
+  int connected = 0;
+  for (Device *d : devices) connected += d->connected;
+  if (!final) {
+    printf("%7.1f s  connected %d/%d  telemetry %.1f msg/s  out %.1f KB/s  in %.1f KB/s  rpc %.1f/s  connects %llu  reconnects %llu"
+           "  connect p99 %s ms  queue p99 %s ms  wake p99 %s ms\n",
+           now(), connected, options.devices, stats.telemetryQty / seconds, stats.bytesSent / seconds / 1024,
+           stats.bytesReceived / seconds / 1024, stats.rpcQty / seconds, (unsigned long long)stats.connectsQty,
+           (unsigned long long)stats.reconnectsQty, stats.connect.format(0.99).c_str(), stats.queue.format(0.99).c_str(),
+           stats.wake.format(0.99).c_str());
+    fflush(stdout);
+    return;
+  }
+
+  unsigned long failuresQty = 0;
+  unsigned long resetsQty = 0;
+  for (Device *d : devices) {
+    failuresQty += d->dht.getFailuresQty();
+    resetsQty += d->dht.getResetsQty();
+  }
+  printf("\n%d devices, %.1f s at %gx (%.1f s of device time), %s:%d\n", options.devices, seconds, options.speed,
+         seconds * options.speed, options.host.c_str(), options.port);
+  printf("  connected %d, connects %llu, reconnects %llu\n", connected, (unsigned long long)stats.connectsQty,
+         (unsigned long long)stats.reconnectsQty);
+  printf("  telemetry %llu msgs (%.2f msg/s, %.4f per device), dropped %llu, rpc %llu (%.2f/s)\n",
+         (unsigned long long)stats.telemetryQty, stats.telemetryQty / seconds, stats.telemetryQty / seconds / options.devices,
+         (unsigned long long)stats.droppedQty, (unsigned long long)stats.rpcQty, stats.rpcQty / seconds);
+  printf("  bytes out %llu (%.1f KB/s), in %llu (%.1f KB/s)\n", (unsigned long long)stats.bytesSent,
+         stats.bytesSent / seconds / 1024, (unsigned long long)stats.bytesReceived, stats.bytesReceived / seconds / 1024);
+  printf("  sensor failures %lu, power cycles %lu, heap per device %llu bytes, wakes %.0f/s\n", failuresQty, resetsQty,
+         (unsigned long long)(ArduinoHost::getHeapUsed() / options.devices), stats.wakesQty / seconds);
+  stats.connect.print("connect");
+  stats.queue.print("queue");
+  stats.wake.print("wake");
+  fflush(stdout);
+}
+
+/**
+ * Read the options.
+ */
+static bool parseOptions(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    std::string name = argv[i];
+    if (i + 1 >= argc) return false;
+    const char *value = argv[++i];
+    if (name == "--host") options.host = value;
+    else if (name == "--port") options.port = atoi(value);
+    else if (name == "--devices") options.devices = atoi(value);
+    else if (name == "--duration") options.duration = atof(value);
+    else if (name == "--speed") options.speed = atof(value);
+    else if (name == "--ramp") options.ramp = atof(value);
+    else if (name == "--drift") options.drift = atof(value);
+    else if (name == "--interval") options.interval = strtoul(value, NULL, 10);
+    else if (name == "--loop-time") options.loopTime = strtoul(value, NULL, 10);
+    else if (name == "--hang") options.hang = atof(value);
+    else if (name == "--token-prefix") options.tokenPrefix = value;
+    else if (name == "--report") options.report = atof(value);
+    else if (name == "--seed") options.seed = strtoul(value, NULL, 10);
+    else return false;
+  }
+  return options.devices > 0 && options.speed > 0 && options.report > 0 && options.loopTime > 0;
+}
+
+static void onSignal(int) {
+  stopRequested = 1;
+}
+
+int main(int argc, char **argv) {
+  if (!parseOptions(argc, argv)) {
+    fprintf(stderr,
+            "Usage: %s [--host 127.0.0.1] [--port 1883] [--devices n] [--duration s] [--speed x] [--ramp s]\n"
+            "          [--drift ppm] [--interval ms] [--loop-time ms] [--hang 0..1] [--token-prefix prefix]\n"
+            "          [--report s] [--seed n]\n",
+            argv[0]);
+    return 2;
+  }
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+  Logger::setLogLevel(Logger::ERROR);
+  ArduinoHost::setSerialOutput(NULL);
+
+  // A socket per device.
+  rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < (rlim_t)options.devices + 16) {
+    fprintf(stderr, "Only %llu sockets can be open, raise the limit (ulimit -n) for %d devices.\n",
+            (unsigned long long)limit.rlim_cur, options.devices);
+    return 1;
+  }
+
+  std::mt19937 rng(options.seed);
+  for (int i = 0; i < options.devices; i++) {
+    devices.push_back(createDevice(i, rng));
+    wakes.push({devices[i]->tBoot, wakeSeq++, devices[i]});
+  }
+  DHT::setModel(readSensor);
+  ArduinoHost::setSystemTask(onWait);
+
+  tStart = std::chrono::steady_clock::now();
+  printf("%d devices booting over %.0f s, at %gx, to %s:%d.\n", options.devices, options.ramp, options.speed,
+         options.host.c_str(), options.port);
+  fflush(stdout);
+
+  // Event loop.
+  double tReport = options.report;
+  double tPeriod = 0;
+  while (!stopRequested && (options.duration <= 0 || now() < options.duration)) {
+    double t = now();
+    if (t >= tReport) {
+      report(period, t - tPeriod, false);
+      period = Stats();
+      tPeriod = t;
+      tReport += options.report;
+    }
+
+    // Sleep until the next device is due.
+    Wake wake = wakes.top();
+    if (wake.due > t) {
+      double until = min(wake.due, tReport);
+      if (options.duration > 0) until = min(until, options.duration);
+      timespec sleep = {(time_t)(until - t), (long)(fmod(until - t, 1) * 1e9)};
+      nanosleep(&sleep, NULL);
+      continue;
+    }
+    wakes.pop();
+
+    // Resume it, with its clock moved to now.
+    Device *d = wake.device;
+    double lag = (t - wake.due) * 1000;
+    total.wake.add(lag);
+    period.wake.add(lag);
+    COUNT(wakesQty, 1);
+    ArduinoHost::select(&d->board);
+    uint64_t time = d->timeAt(t);
+    if (time > d->board.time) d->board.time = time;
+    current = d;
+    swapcontext(&loopContext, &d->context);
+    current = NULL;
+  }
+
+  report(total, now(), true);
+  return 0;
+}
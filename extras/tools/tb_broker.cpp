@@ -0,0 +1,754 @@
+/**
+ * tb_broker.cpp
+ *
+ * A stand-in for the ThingsBoard MQTT device API, to benchmark devices on the bench without a server.
+ *
+ * It speaks enough MQTT 3.1.1 for the library (CONNECT, SUBSCRIBE, UNSUBSCRIBE, PUBLISH with QoS 0
+ * and 1, PINGREQ and DISCONNECT, persistent sessions) and handles the ThingsBoard topics:
+ *   - v1/devices/me/telemetry: counted, with the values in each message (JSON or MessagePack).
+ *   - v1/devices/me/attributes: client attributes are counted, shared attributes are pushed to the
+ *     subscribers every --attr-interval (attr_tick and a bumped attr_version).
+ *   - v1/devices/me/attributes/request/<id>: answered on .../response/<id> with the shared attributes.
+ *   - v1/devices/me/rpc/request/+: an RPC is sent to the subscribers every --rpc-interval and the time
+ *     to its answer on v1/devices/me/rpc/response/<id> is measured.
+ * Like ThingsBoard, it rejects anything but JSON on v1/devices/me/telemetry. Binary telemetry is taken
+ * on --bridge-topic instead.
+ *
+ * The network between device and broker is shaped here: every packet is delayed by --latency (plus a
+ * random --jitter, keeping the order, like TCP does), and each PUBLISH is lost with the --loss
+ * probability in either direction, as a QoS 0 message would be by a broker under pressure. Every
+ * --kick-interval the connections are dropped, and the time each device takes to come back is
+ * measured.
+ *
+ * At the end (--duration or Ctrl+C) it prints, per client and in total: publish throughput, bytes on
+ * the wire per telemetry message and per value, RPC round trip times, and reconnection times.
+ *
+ *   g++ -std=c++11 -O2 extras/tools/tb_broker.cpp -o tb_broker
+ *   ./tb_broker --port 1883 --duration 60 --latency 40 --jitter 20 --loss 0.02 --rpc-interval 1000
+ *
+ * It's a standalone program for POSIX systems, it doesn't link the library.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <algorithm>     // Sort.
+#include <arpa/inet.h>   // Addresses.
+#include <chrono>        // Clock.
+#include <csignal>       // Ctrl+C.
+#include <cstdio>        // Output.
+#include <cstdlib>       // Arguments.
+#include <cstring>       // Strings.
+#include <deque>         // Packet queues.
+#include <fcntl.h>       // Non-blocking sockets.
+#include <map>           // Clients and sessions.
+#include <netinet/in.h>  // Sockets.
+#include <netinet/tcp.h> // No delay.
+#include <poll.h>        // Event loop.
+#include <random>        // Loss and jitter.
+#include <set>           // Subscriptions.
+#include <string>        // Buffers.
+#include <sys/socket.h>  // Sockets.
+#include <unistd.h>      // Close.
+#include <vector>        // Lists.
+
+// MQTT packet types.
+#define MQTT_CONNECT 1
+#define MQTT_CONNACK 2
+#define MQTT_PUBLISH 3
+#define MQTT_PUBACK 4
+#define MQTT_SUBSCRIBE 8
+#define MQTT_SUBACK 9
+#define MQTT_UNSUBSCRIBE 10
+#define MQTT_UNSUBACK 11
+#define MQTT_PINGREQ 12
+#define MQTT_PINGRESP 13
+#define MQTT_DISCONNECT 14
+
+// ThingsBoard topics.
+#define TB_TELEMETRY_TOPIC "v1/devices/me/telemetry"
+#define TB_ATTRIBUTES_TOPIC "v1/devices/me/attributes"
+#define TB_ATTR_REQUEST_TOPIC "v1/devices/me/attributes/request/"
+#define TB_ATTR_RESPONSE_TOPIC "v1/devices/me/attributes/response/"
+#define TB_RPC_REQUEST_TOPIC "v1/devices/me/rpc/request/"
+#define TB_RPC_RESPONSE_TOPIC "v1/devices/me/rpc/response/"
+
+/**
+ * Options.
+ */
+struct Options {
+  int port = 1883;                         // TCP port.
+  double duration = 0;                     // Seconds to run, 0 until Ctrl+C.
+  double latency = 0;                      // One way delay of every packet (ms).
+  double jitter = 0;                       // Max random delay added to the latency (ms).
+  double loss = 0;                         // Probability of losing a PUBLISH, in each direction.
+  double rpcInterval = 0;                  // Time between RPC requests (ms), 0 for none.
+  std::string rpcMethod = "setValue";      // RPC method.
+  std::string rpcParams = "{\"value\":1}"; // RPC params.
+  double attrInterval = 0;                 // Time between shared attribute updates (ms), 0 for none.
+  double kickInterval = 0;                 // Time between dropping every connection (ms), 0 for never.
+  std::string bridgeTopic;                 // Topic of binary telemetry.
+  std::string token;                       // Device token, any if empty.
+  unsigned seed = 1;                       // Random seed.
+  bool verbose = false;                    // Print every packet.
+};
+
+/**
+ * A packet held back by the simulated network.
+ */
+struct Delayed {
+  double due;         // Time it gets through (ms).
+  std::string bytes;  // Whole packet.
+};
+
+/**
+ * Metrics of a client, kept across its connections.
+ */
+struct Metrics {
+  unsigned long connects = 0;           // Connections accepted.
+  unsigned long telemetryQty = 0;       // Telemetry messages received.
+  unsigned long telemetryBytes = 0;     // Bytes on the wire of the telemetry messages.
+  unsigned long valuesQty = 0;          // Values in the telemetry messages.
+  unsigned long rejectedQty = 0;        // Telemetry messages rejected (not JSON).
+  unsigned long attributesQty = 0;      // Client attribute messages received.
+  unsigned long otherQty = 0;           // Other messages received.
+  unsigned long lostInQty = 0;          // Messages from the client lost.
+  unsigned long lostOutQty = 0;         // Messages to the client lost.
+  unsigned long bytesIn = 0;            // Bytes received.
+  unsigned long bytesOut = 0;           // Bytes sent.
+  unsigned long rpcSent = 0;            // RPC requests sent.
+  unsigned long attrPushed = 0;         // Shared attribute updates sent.
+  unsigned long attrRequests = 0;       // Shared attribute requests answered.
+  std::vector<double> rpcTimes;         // Round trip of the RPC answered (ms).
+  std::vector<double> reconnectTimes;   // Time to come back after being dropped (ms).
+  double tKicked = -1;                  // Last time it was dropped, -1 if it came back.
+  std::map<unsigned long, double> rpcPending;  // RPC requests waiting for an answer, by id.
+};
+
+/**
+ * A TCP connection.
+ */
+struct Connection {
+  int fd;                         // Socket.
+  std::string rx;                 // Bytes received, not framed yet.
+  std::string tx;                 // Bytes that got through the network, to be written.
+  std::deque<Delayed> inbound;    // Packets from the client on their way.
+  std::deque<Delayed> outbound;   // Packets to the client on their way.
+  std::string clientId;           // Client id, empty before CONNECT.
+  bool cleanSession = true;       // Clean session flag of CONNECT.
+  std::set<std::string> filters;  // Topic filters subscribed.
+  bool closing = false;           // Flag that indicates it must be closed once tx is written.
+};
+
+// State.
+static Options options;                                      // Options.
+static std::mt19937 rng;                                     // Random numbers.
+static std::map<std::string, Metrics> metrics;               // Metrics by client id.
+static std::map<std::string, std::set<std::string>> sessions;  // Subscriptions kept by client id.
+static std::vector<Connection *> connections;                // Open connections.
+static std::vector<std::pair<std::string, std::string>> sharedAttributes;  // Shared attributes, as JSON.
+static unsigned long rpcId = 0;                              // Last RPC request id.
+static unsigned long attrTick = 0;                           // Last shared attribute update.
+static volatile sig_atomic_t stopRequested = 0;              // Flag set by Ctrl+C.
+static std::chrono::steady_clock::time_point tStart;         // Start time.
+
+/**
+ * Time since start (ms).
+ */
+static double now() {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+}
+
+/**
+ * True with the given probability.
+ */
+static bool chance(double probability) {
+  return probability > 0 && std::uniform_real_distribution<double>(0, 1)(rng) < probability;
+}
+
+/**
+ * Time a packet sent now gets through, after the ones already on their way.
+ */
+static double dueTime(const std::deque<Delayed> &queue) {
+  double due = now() + options.latency;
+  if (options.jitter > 0) due += std::uniform_real_distribution<double>(0, options.jitter)(rng);
+  if (!queue.empty() && queue.back().due > due) due = queue.back().due;
+  return due;
+}
+
+/**
+ * Build a packet.
+ */
+static std::string packet(uint8_t header, const std::string &body) {
+  std::string p(1, (char)header);
+  size_t remaining = body.size();
+  do {
+    uint8_t b = remaining % 128;
+    remaining /= 128;
+    if (remaining > 0) b |= 0x80;
+    p += (char)b;
+  } while (remaining > 0);
+  return p + body;
+}
+
+/**
+ * Build a length-prefixed string.
+ */
+static std::string mqttString(const std::string &s) {
+  return std::string(1, (char)(s.size() >> 8)) + (char)(s.size() & 0xFF) + s;
+}
+
+/**
+ * Read a length-prefixed string, false if it doesn't fit.
+ */
+static bool readString(const std::string &body, size_t &pos, std::string &s) {
+  if (pos + 2 > body.size()) return false;
+  size_t length = ((uint8_t)body[pos] << 8) | (uint8_t)body[pos + 1];
+  if (pos + 2 + length > body.size()) return false;
+  s = body.substr(pos + 2, length);
+  pos += 2 + length;
+  return true;
+}
+
+/**
+ * True if a topic matches a filter, with + and # wildcards.
+ */
+static bool matches(const std::string &filter, const std::string &topic) {
+  size_t f = 0, t = 0;
+  while (f < filter.size()) {
+    if (filter[f] == '#') return true;
+    if (filter[f] == '+') {
+      while (t < topic.size() && topic[t] != '/') t++;
+      f++;
+      continue;
+    }
+    if (t >= topic.size() || filter[f] != topic[t]) return false;
+    f++;
+    t++;
+  }
+  return t == topic.size();
+}
+
+/**
+ * Queue a packet to a client, through the simulated network.
+ */
+static void send(Connection *c, const std::string &p) {
+  c->outbound.push_back({dueTime(c->outbound), p});
+}
+
+/**
+ * Publish a message to a client if it's subscribed, true if it was sent (even if it's lost on the way).
+ */
+static bool publish(Connection *c, const std::string &topic, const std::string &payload) {
+  bool subscribed = false;
+  for (const std::string &filter : c->filters) subscribed = subscribed || matches(filter, topic);
+  if (!subscribed) return false;
+  if (chance(options.loss)) {
+    metrics[c->clientId].lostOutQty++;
+    return true;
+  }
+  send(c, packet(MQTT_PUBLISH << 4, mqttString(topic) + payload));
+  return true;
+}
+
+/**
+ * True if a payload is a JSON object, the only telemetry ThingsBoard takes.
+ */
+static bool isJsonObject(const std::string &payload) {
+  size_t i = payload.find_first_not_of(" \t\r\n");
+  return i != std::string::npos && payload[i] == '{';
+}
+
+/**
+ * Count the values of a telemetry payload, -1 if it isn't an object.
+ * JSON only needs its top level keys counted, MessagePack maps say how many they have.
+ */
+static long countValues(const std::string &payload) {
+  if (payload.empty()) return -1;
+  uint8_t b = payload[0];
+  if (b >= 0x80 && b <= 0x8F) return b & 0x0F;
+  if (b == 0xDE && payload.size() >= 3) return ((uint8_t)payload[1] << 8) | (uint8_t)payload[2];
+  if (!isJsonObject(payload)) return -1;
+  long values = 0;
+  int depth = 0;
+  bool inString = false;
+  for (size_t i = payload.find('{'); i < payload.size(); i++) {
+    char ch = payload[i];
+    if (inString) {
+      if (ch == '\\') i++;
+      else if (ch == '"') inString = false;
+      continue;
+    }
+    if (ch == '"') {
+      inString = true;
+      if (depth == 1 && values == 0) values = 1;  // First key.
+    }
+    if (ch == '{' || ch == '[') depth++;
+    if (ch == '}' || ch == ']') depth--;
+    if (depth == 1 && ch == ',') values++;
+  }
+  return depth == 0 ? values : -1;
+}
+
+/**
+ * Answer a shared attributes request with the keys asked for, all of them if none are.
+ */
+static void answerAttributes(Connection *c, const std::string &requestId, const std::string &payload) {
+  std::string keys;
+  size_t k = payload.find("\"sharedKeys\"");
+  if (k != std::string::npos) {
+    size_t start = payload.find('"', payload.find(':', k) + 1);
+    size_t end = payload.find('"', start + 1);
+    if (start != std::string::npos && end != std::string::npos) keys = "," + payload.substr(start + 1, end - start - 1) + ",";
+  }
+  std::string shared;
+  for (const auto &attribute : sharedAttributes) {
+    if (!keys.empty() && keys.find("," + attribute.first + ",") == std::string::npos) continue;
+    if (!shared.empty()) shared += ",";
+    shared += "\"" + attribute.first + "\":" + attribute.second;
+  }
+  metrics[c->clientId].attrRequests++;
+  publish(c, TB_ATTR_RESPONSE_TOPIC + requestId, "{\"shared\":{" + shared + "}}");
+}
+
+/**
+ * Handle a PUBLISH from a client.
+ */
+static void handlePublish(Connection *c, uint8_t flags, const std::string &body, size_t wireLength) {
+  size_t pos = 0;
+  std::string topic;
+  if (!readString(body, pos, topic)) return;
+  uint8_t qos = (flags >> 1) & 3;
+  if (qos > 0) {
+    if (pos + 2 > body.size()) return;
+    send(c, packet(MQTT_PUBACK << 4, body.substr(pos, 2)));
+    pos += 2;
+  }
+  std::string payload = body.substr(pos);
+  Metrics &m = metrics[c->clientId];
+  if (chance(options.loss)) {
+    m.lostInQty++;
+    return;
+  }
+  if (options.verbose) printf("%10.1f %s > %s %s\n", now(), c->clientId.c_str(), topic.c_str(), payload.c_str());
+
+  bool binary = !options.bridgeTopic.empty() && topic == options.bridgeTopic;
+  if (topic == TB_TELEMETRY_TOPIC || binary) {
+    long values = countValues(payload);
+    if (values < 0 || (!binary && !isJsonObject(payload))) {
+      m.rejectedQty++;
+      return;
+    }
+    m.telemetryQty++;
+    m.telemetryBytes += wireLength;
+    m.valuesQty += values;
+  } else if (topic == TB_ATTRIBUTES_TOPIC) {
+    m.attributesQty++;
+  } else if (topic.compare(0, strlen(TB_ATTR_REQUEST_TOPIC), TB_ATTR_REQUEST_TOPIC) == 0) {
+    answerAttributes(c, topic.substr(strlen(TB_ATTR_REQUEST_TOPIC)), payload);
+  } else if (topic.compare(0, strlen(TB_RPC_RESPONSE_TOPIC), TB_RPC_RESPONSE_TOPIC) == 0) {
+    unsigned long id = strtoul(topic.c_str() + strlen(TB_RPC_RESPONSE_TOPIC), NULL, 10);
+    auto pending = m.rpcPending.find(id);
+    if (pending != m.rpcPending.end()) {
+      m.rpcTimes.push_back(now() - pending->second);
+      m.rpcPending.erase(pending);
+    }
+  } else {
+    m.otherQty++;
+  }
+}
+
+/**
+ * Handle a CONNECT.
+ */
+static void handleConnect(Connection *c, const std::string &body) {
+  size_t pos = 0;
+  std::string protocol, clientId, username;
+  if (!readString(body, pos, protocol) || pos + 4 > body.size()) {
+    c->closing = true;
+    return;
+  }
+  uint8_t flags = body[pos + 1];
+  pos += 4;
+  if (!readString(body, pos, clientId)) {
+    c->closing = true;
+    return;
+  }
+  std::string skip;
+  if (flags & 0x04) {
+    readString(body, pos, skip);  // Will topic.
+    readString(body, pos, skip);  // Will message.
+  }
+  if (flags & 0x80) readString(body, pos, username);
+  if (!options.token.empty() && username != options.token) {
+    send(c, packet(MQTT_CONNACK << 4, std::string("\x00\x05", 2)));  // Not authorized.
+    c->closing = true;
+    return;
+  }
+  if (clientId.empty()) clientId = "fd-" + std::to_string(c->fd);
+  c->clientId = clientId;
+  c->cleanSession = (flags & 0x02) != 0;
+
+  // Sessions are kept only when the client asks to.
+  bool sessionPresent = false;
+  if (c->cleanSession) {
+    sessions.erase(clientId);
+  } else if (sessions.count(clientId)) {
+    c->filters = sessions[clientId];
+    sessionPresent = true;
+  }
+
+  Metrics &m = metrics[clientId];
+  m.connects++;
+  if (m.tKicked >= 0) {
+    m.reconnectTimes.push_back(now() - m.tKicked);
+    m.tKicked = -1;
+  }
+  m.rpcPending.clear();
+  if (options.verbose) printf("%10.1f %s connected%s\n", now(), clientId.c_str(), sessionPresent ? " (session present)" : "");
+  send(c, packet(MQTT_CONNACK << 4, std::string(1, (char)sessionPresent) + '\0'));
+}
+
+/**
+ * Handle a packet from a client.
+ */
+static void handlePacket(Connection *c, const std::string &p) {
+  size_t header = 1;
+  while ((uint8_t)p[header] & 0x80) header++;
+  header++;
+  std::string body = p.substr(header);
+  uint8_t type = (uint8_t)p[0] >> 4;
+  if (type != MQTT_CONNECT) metrics[c->clientId].bytesIn += p.size();
+  if (c->clientId.empty() && type != MQTT_CONNECT) {
+    c->closing = true;
+    return;
+  }
+
+  switch (type) {
+    case MQTT_CONNECT:
+      handleConnect(c, body);
+      metrics[c->clientId].bytesIn += p.size();
+      break;
+    case MQTT_PUBLISH:
+      handlePublish(c, p[0] & 0x0F, body, p.size());
+      break;
+    case MQTT_SUBSCRIBE:
+    case MQTT_UNSUBSCRIBE: {
+      if (body.size() < 2) return;
+      std::string ack = body.substr(0, 2);
+      size_t pos = 2;
+      std::string filter;
+      while (readString(body, pos, filter)) {
+        if (type == MQTT_SUBSCRIBE) {
+          pos++;
+          c->filters.insert(filter);
+          ack += '\0';
+        } else {
+          c->filters.erase(filter);
+        }
+      }
+      if (!c->cleanSession) sessions[c->clientId] = c->filters;
+      send(c, packet(type == MQTT_SUBSCRIBE ? MQTT_SUBACK << 4 : MQTT_UNSUBACK << 4, ack));
+      break;
+    }
+    case MQTT_PINGREQ:
+      send(c, packet(MQTT_PINGRESP << 4, ""));
+      break;
+    case MQTT_DISCONNECT:
+      c->closing = true;
+      break;
+  }
+}
+
+/**
+ * Frame the packets received and put them on their way.
+ */
+static void frame(Connection *c) {
+  while (c->rx.size() >= 2) {
+    size_t remaining = 0;
+    size_t multiplier = 1;
+    size_t header = 1;
+    bool complete = false;
+    while (header < c->rx.size() && header <= 4) {
+      uint8_t b = c->rx[header++];
+      remaining += (b & 0x7F) * multiplier;
+      multiplier *= 128;
+      if (!(b & 0x80)) {
+        complete = true;
+        break;
+      }
+    }
+    if (!complete || c->rx.size() < header + remaining) return;
+    c->inbound.push_back({dueTime(c->inbound), c->rx.substr(0, header + remaining)});
+    c->rx.erase(0, header + remaining);
+  }
+}
+
+/**
+ * Close a connection.
+ */
+static void closeConnection(Connection *c, bool kicked) {
+  if (!c->clientId.empty()) {
+    if (!c->cleanSession) sessions[c->clientId] = c->filters;
+    if (kicked) metrics[c->clientId].tKicked = now();
+  }
+  if (options.verbose) printf("%10.1f %s %s\n", now(), c->clientId.c_str(), kicked ? "kicked" : "disconnected");
+  close(c->fd);
+  connections.erase(std::find(connections.begin(), connections.end(), c));
+  delete c;
+}
+
+/**
+ * Send an RPC request to every subscriber.
+ */
+static void sendRPC() {
+  rpcId++;
+  std::string payload = "{\"method\":\"" + options.rpcMethod + "\",\"params\":" + options.rpcParams + "}";
+  for (Connection *c : connections) {
+    if (c->clientId.empty()) continue;
+    Metrics &m = metrics[c->clientId];
+    if (!publish(c, TB_RPC_REQUEST_TOPIC + std::to_string(rpcId), payload)) continue;
+    m.rpcSent++;
+    m.rpcPending[rpcId] = now();
+  }
+}
+
+/**
+ * Update the shared attributes and push them to every subscriber.
+ */
+static void pushAttributes() {
+  attrTick++;
+  for (auto &attribute : sharedAttributes) {
+    if (attribute.first == "attr_version" || attribute.first == "attr_tick") attribute.second = std::to_string(attrTick);
+  }
+  std::string payload = "{\"attr_tick\":" + std::to_string(attrTick) + ",\"attr_version\":" + std::to_string(attrTick) + "}";
+  for (Connection *c : connections) {
+    if (!c->clientId.empty() && publish(c, TB_ATTRIBUTES_TOPIC, payload)) metrics[c->clientId].attrPushed++;
+  }
+}
+
+/**
+ * Percentile of a sorted list.
+ */
+static double percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty()) return 0;
+  size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+  return sorted[i];
+}
+
+/**
+ * Print a line of the report.
+ */
+static void printMetrics(const std::string &name, Metrics m, double elapsed) {
+  std::sort(m.rpcTimes.begin(), m.rpcTimes.end());
+  std::sort(m.reconnectTimes.begin(), m.reconnectTimes.end());
+  double seconds = elapsed / 1000;
+  printf("%s\n", name.c_str());
+  printf("  connects %lu, bytes in %lu, bytes out %lu, lost in %lu, lost out %lu\n", m.connects, m.bytesIn, m.bytesOut,
+         m.lostInQty, m.lostOutQty);
+  printf("  telemetry %lu msgs (%.2f msg/s), %lu values (%.2f values/s), %lu rejected, attributes %lu, other %lu\n",
+         m.telemetryQty, m.telemetryQty / seconds, m.valuesQty, m.valuesQty / seconds, m.rejectedQty, m.attributesQty, m.otherQty);
+  if (m.telemetryQty > 0) {
+    printf("  wire bytes per telemetry msg %.1f, per value %.1f\n", (double)m.telemetryBytes / m.telemetryQty,
+           m.valuesQty > 0 ? (double)m.telemetryBytes / m.valuesQty : 0.0);
+  }
+  if (m.rpcSent > 0) {
+    printf("  rpc sent %lu, answered %lu (%.1f%%), round trip ms min %.1f p50 %.1f p95 %.1f max %.1f\n", m.rpcSent,
+           (unsigned long)m.rpcTimes.size(), 100.0 * m.rpcTimes.size() / m.rpcSent, percentile(m.rpcTimes, 0),
+           percentile(m.rpcTimes, 0.5), percentile(m.rpcTimes, 0.95), percentile(m.rpcTimes, 1));
+  }
+  if (m.attrPushed > 0 || m.attrRequests > 0) printf("  shared attributes pushed %lu, requests %lu\n", m.attrPushed, m.attrRequests);
+  if (!m.reconnectTimes.empty()) {
+    printf("  reconnects %lu, ms min %.1f p50 %.1f max %.1f\n", (unsigned long)m.reconnectTimes.size(), percentile(m.reconnectTimes, 0),
+           percentile(m.reconnectTimes, 0.5), percentile(m.reconnectTimes, 1));
+  }
+}
+
+/**
+ * Print the report, per client and in total.
+ */
+static void report() {
+  double elapsed = now();
+  Metrics total;
+  printf("\n%.1f s, latency %.0f ms + jitter %.0f ms, loss %.1f%%\n", elapsed / 1000, options.latency, options.jitter, options.loss * 100);
+  for (auto &client : metrics) {
+    if (client.first.empty()) continue;
+    Metrics &m = client.second;
+    printMetrics(client.first, m, elapsed);
+    total.connects += m.connects;
+    total.telemetryQty += m.telemetryQty;
+    total.telemetryBytes += m.telemetryBytes;
+    total.valuesQty += m.valuesQty;
+    total.rejectedQty += m.rejectedQty;
+    total.attributesQty += m.attributesQty;
+    total.otherQty += m.otherQty;
+    total.lostInQty += m.lostInQty;
+    total.lostOutQty += m.lostOutQty;
+    total.bytesIn += m.bytesIn;
+    total.bytesOut += m.bytesOut;
+    total.rpcSent += m.rpcSent;
+    total.attrPushed += m.attrPushed;
+    total.attrRequests += m.attrRequests;
+    total.rpcTimes.insert(total.rpcTimes.end(), m.rpcTimes.begin(), m.rpcTimes.end());
+    total.reconnectTimes.insert(total.reconnectTimes.end(), m.reconnectTimes.begin(), m.reconnectTimes.end());
+  }
+  printMetrics("total", total, elapsed);
+  fflush(stdout);
+}
+
+/**
+ * Read the options.
+ */
+static bool parseOptions(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    std::string name = argv[i];
+    if (name == "--verbose") {
+      options.verbose = true;
+      continue;
+    }
+    if (i + 1 >= argc) return false;
+    const char *value = argv[++i];
+    if (name == "--port") options.port = atoi(value);
+    else if (name == "--duration") options.duration = atof(value);
+    else if (name == "--latency") options.latency = atof(value);
+    else if (name == "--jitter") options.jitter = atof(value);
+    else if (name == "--loss") options.loss = atof(value);
+    else if (name == "--rpc-interval") options.rpcInterval = atof(value);
+    else if (name == "--rpc-method") options.rpcMethod = value;
+    else if (name == "--rpc-params") options.rpcParams = value;
+    else if (name == "--attr-interval") options.attrInterval = atof(value);
+    else if (name == "--kick-interval") options.kickInterval = atof(value);
+    else if (name == "--bridge-topic") options.bridgeTopic = value;
+    else if (name == "--token") options.token = value;
+    else if (name == "--seed") options.seed = strtoul(value, NULL, 10);
+    else if (name == "--shared") {
+      const char *equals = strchr(value, '=');
+      if (!equals) return false;
+      sharedAttributes.push_back({std::string(value, equals - value), equals + 1});
+    } else return false;
+  }
+  return true;
+}
+
+static void onSignal(int) {
+  stopRequested = 1;
+}
+
+int main(int argc, char **argv) {
+  if (!parseOptions(argc, argv)) {
+    fprintf(stderr,
+            "Usage: %s [--port 1883] [--duration s] [--latency ms] [--jitter ms] [--loss 0..1]\n"
+            "          [--rpc-interval ms] [--rpc-method name] [--rpc-params json] [--attr-interval ms]\n"
+            "          [--kick-interval ms] [--bridge-topic topic] [--token token] [--shared key=json]...\n"
+            "          [--seed n] [--verbose]\n",
+            argv[0]);
+    return 2;
+  }
+  rng.seed(options.seed);
+  sharedAttributes.push_back({"attr_version", "0"});
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  int yes = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(options.port);
+  if (bind(listener, (sockaddr *)&address, sizeof(address)) < 0 || listen(listener, 64) < 0) {
+    perror("listen");
+    return 1;
+  }
+  fcntl(listener, F_SETFL, O_NONBLOCK);
+  tStart = std::chrono::steady_clock::now();
+  printf("Listening on port %d.\n", options.port);
+  fflush(stdout);
+
+  double tRPC = options.rpcInterval;
+  double tAttr = options.attrInterval;
+  double tKick = options.kickInterval;
+  while (!stopRequested && (options.duration <= 0 || now() < options.duration * 1000)) {
+    // Wait for the sockets, or for the next packet to get through.
+    std::vector<pollfd> fds(1, {listener, POLLIN, 0});
+    for (Connection *c : connections) fds.push_back({c->fd, (short)(POLLIN | (c->tx.empty() ? 0 : POLLOUT)), 0});
+    poll(fds.data(), fds.size(), options.latency > 0 || options.jitter > 0 ? 1 : 10);
+
+    if (fds[0].revents & POLLIN) {
+      int fd;
+      while ((fd = accept(listener, NULL, NULL)) >= 0) {
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        Connection *c = new Connection();
+        c->fd = fd;
+        connections.push_back(c);
+      }
+    }
+
+    std::vector<Connection *> closed;
+    for (size_t i = 1; i < fds.size(); i++) {
+      Connection *c = connections[i - 1];
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+        char buffer[4096];
+        ssize_t n = read(c->fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+          closed.push_back(c);
+          continue;
+        }
+        c->rx.append(buffer, n);
+        frame(c);
+      }
+      if ((fds[i].revents & POLLOUT) && !c->tx.empty()) {
+        ssize_t n = write(c->fd, c->tx.data(), c->tx.size());
+        if (n > 0) {
+          metrics[c->clientId].bytesOut += n;
+          c->tx.erase(0, n);
+        }
+      }
+    }
+    for (Connection *c : closed) closeConnection(c, false);
+
+    // Deliver what got through the simulated network.
+    double t = now();
+    std::vector<Connection *> closing;
+    for (Connection *c : connections) {
+      while (!c->inbound.empty() && c->inbound.front().due <= t && !c->closing) {
+        std::string p = c->inbound.front().bytes;
+        c->inbound.pop_front();
+        handlePacket(c, p);
+      }
+      while (!c->outbound.empty() && c->outbound.front().due <= t) {
+        c->tx += c->outbound.front().bytes;
+        c->outbound.pop_front();
+      }
+      if (c->closing && c->outbound.empty()) {
+        if (!c->tx.empty()) {
+          ssize_t n = write(c->fd, c->tx.data(), c->tx.size());
+          if (n > 0) metrics[c->clientId].bytesOut += n;
+        }
+        closing.push_back(c);
+      }
+    }
+    for (Connection *c : closing) closeConnection(c, false);
+
+    // Scheduled traffic.
+    if (options.rpcInterval > 0 && t >= tRPC) {
+      sendRPC();
+      tRPC += options.rpcInterval;
+    }
+    if (options.attrInterval > 0 && t >= tAttr) {
+      pushAttributes();
+      tAttr += options.attrInterval;
+    }
+    if (options.kickInterval > 0 && t >= tKick) {
+      std::vector<Connection *> kicked(connections);
+      for (Connection *c : kicked) closeConnection(c, !c->clientId.empty());
+      tKick += options.kickInterval;
+    }
+  }
+
+  report();
+  return 0;
+}
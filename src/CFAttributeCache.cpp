@@ -0,0 +1,193 @@
+/**
+ * CFAttributeCache.cpp
+ *
+ * A library for Arduino that keeps the last ThingsBoard shared attributes in flash.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFAttributeCache.h>  // CF Attribute Cache.
+
+/**
+ * Constructor.
+ */
+CFAttributeCache::CFAttributeCache() : _attributes(CF_ATTR_CACHE_SIZE),
+                                       _loaded(false),
+                                       _savedQty(0),
+                                       _fetchedQty(0),
+                                       _checkedQty(0),
+                                       _discardedQty(0),
+                                       _onAttributesCallback(NULL) {
+  CFJsonArena::addFixed("attrcache", CF_ATTR_CACHE_SIZE);
+}
+
+/**
+ * Load the attributes saved and apply them through the callback.
+ * It's meant to be called at boot, before the network is up.
+ *
+ * @param onAttributesCallback Callback called with the attributes loaded and every change received.
+ * @returns True if there were attributes saved.
+ */
+bool CFAttributeCache::begin(AttributesCallback onAttributesCallback) {
+  _onAttributesCallback = onAttributesCallback;
+  _attributes.to<JsonObject>();
+  if (!SPIFFS.begin() || !_load()) return false;
+
+  _loaded = true;
+  CF_LOG_NOTICE("Cached attributes loaded (%u).", _attributes.size());
+  if (_onAttributesCallback) _onAttributesCallback(_attributes.as<JsonObjectConst>());
+  return true;
+}
+
+/**
+ * Load the attributes saved.
+ *
+ * @returns True if there were attributes saved, otherwise there are none.
+ */
+bool CFAttributeCache::_load() {
+  _attributes.to<JsonObject>();
+  if (!SPIFFS.exists(CF_ATTR_CACHE_PATH)) return false;
+
+  File file = SPIFFS.open(CF_ATTR_CACHE_PATH, "r");
+  if (!file) return false;
+  DeserializationError error = deserializeMsgPack(_attributes, file);
+  file.close();
+  if (error || !_attributes.is<JsonObject>()) {
+    CF_LOG_WARNING("Fail loading cached attributes: %s.", error.c_str());
+    _attributes.to<JsonObject>();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Discard attributes that don't fit, going back to the ones saved.
+ * Neither flash nor the callback get a partial set.
+ */
+void CFAttributeCache::_discard() {
+  CF_LOG_WARNING("Shared attributes don't fit, they were discarded. Increase CF_ATTR_CACHE_SIZE.");
+  _discardedQty++;
+  _load();
+}
+
+/**
+ * True if the attributes have a version, so only the version has to be checked on connect.
+ *
+ * @returns True if CF_ATTR_VERSION_KEY is cached.
+ */
+bool CFAttributeCache::hasVersion() {
+  return _attributes.containsKey(CF_ATTR_VERSION_KEY);
+}
+
+/**
+ * True if the version received is the one saved.
+ *
+ * @param shared Shared attributes received, with the version.
+ * @returns True if nothing has to be fetched.
+ */
+bool CFAttributeCache::isUpToDate(JsonObjectConst shared) {
+  JsonVariantConst version = shared[CF_ATTR_VERSION_KEY];
+  bool upToDate = !version.isNull() && version == getAttributes()[CF_ATTR_VERSION_KEY];
+  if (upToDate) _checkedQty++;
+  return upToDate;
+}
+
+/**
+ * Replace the attributes with the whole set.
+ *
+ * @param shared Shared attributes received.
+ */
+void CFAttributeCache::replace(JsonObjectConst shared) {
+  _fetchedQty++;
+  if (shared == getAttributes()) return;
+  if (shared.isNull()) {
+    _attributes.to<JsonObject>();
+  } else if (!_attributes.set(shared)) {
+    _discard();
+    return;
+  }
+  _save();
+  if (_onAttributesCallback) _onAttributesCallback(_attributes.as<JsonObjectConst>());
+}
+
+/**
+ * Apply attribute changes pushed by ThingsBoard.
+ * Attributes deleted on the server come as {"deleted": ["key", ...]} and are removed. If the changes
+ * don't fit, none of them is applied.
+ *
+ * @param changes Attributes changed.
+ */
+void CFAttributeCache::update(JsonObjectConst changes) {
+  bool changed = false;
+  JsonObjectConst attributes = getAttributes();
+  for (JsonPairConst p : changes) {
+    if (strcmp(p.key().c_str(), "deleted") == 0 && p.value().is<JsonArrayConst>()) {
+      for (JsonVariantConst key : p.value().as<JsonArrayConst>()) {
+        if (!key.is<const char *>() || !attributes.containsKey(key.as<const char *>())) continue;
+        _attributes.remove(key.as<const char *>());
+        changed = true;
+      }
+      continue;
+    }
+    if (attributes[p.key()] == p.value()) continue;
+    if (!_attributes[p.key()].set(p.value())) {
+      // Replaced strings stay in the document memory until it's compacted.
+      _attributes.garbageCollect();
+      if (!_attributes[p.key()].set(p.value())) {
+        _discard();
+        return;
+      }
+    }
+    changed = true;
+  }
+  if (!changed) return;
+  _save();
+  if (_onAttributesCallback) _onAttributesCallback(changes);
+}
+
+/**
+ * Save the attributes to flash.
+ */
+void CFAttributeCache::_save() {
+  File file = SPIFFS.open(CF_ATTR_CACHE_PATH, "w");
+  if (!file) {
+    CF_LOG_WARNING("Fail saving cached attributes.");
+    return;
+  }
+  serializeMsgPack(_attributes, file);
+  file.close();
+  _savedQty++;
+}
+
+/**
+ * Get the attributes.
+ *
+ * @returns Shared attributes cached.
+ */
+JsonObjectConst CFAttributeCache::getAttributes() {
+  return _attributes.as<JsonObjectConst>();
+}
+
+/**
+ * True if the attributes were loaded from flash at boot.
+ *
+ * @returns True if they were loaded.
+ */
+bool CFAttributeCache::isLoaded() {
+  return _loaded;
+}
+
+/**
+ * Get cache metrics.
+ *
+ * @param metrics Object where the metrics are written.
+ */
+void CFAttributeCache::getMetrics(JsonObject metrics) {
+  metrics["attr_loaded"] = _loaded;
+  metrics["attr_saved_qty"] = _savedQty;
+  metrics["attr_fetched_qty"] = _fetchedQty;
+  metrics["attr_checked_qty"] = _checkedQty;
+  metrics["attr_discarded_qty"] = _discardedQty;
+}
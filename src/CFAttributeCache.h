@@ -0,0 +1,75 @@
+/**
+ * CFAttributeCache.h
+ *
+ * A library for Arduino that keeps the last ThingsBoard shared attributes in flash.
+ *
+ * The attributes saved are applied at boot, before the network is up, so the device starts with the
+ * values it had instead of its defaults. They are saved as MessagePack, only when they change. A set
+ * that doesn't fit in CF_ATTR_CACHE_SIZE is discarded, so the last one saved stays in flash.
+ *
+ * On connect only the version attribute (CF_ATTR_VERSION_KEY, e.g. a counter bumped by a rule chain
+ * whenever a shared attribute changes) is requested, and the whole set only if it's not the version
+ * saved. Without a version attribute on the server the whole set is requested on every connect, as
+ * before, and the last set saved is still applied at boot.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFAttributeCache_h
+#define CFAttributeCache_h
+
+#include <ArduinoJson.h>  // Arduino JSON.
+#include <CFJsonArena.h>  // CF JSON Arena.
+#include <CFLog.h>        // CF Log.
+#include <FS.h>           // File system.
+
+#ifndef CF_ATTR_CACHE_SIZE
+#define CF_ATTR_CACHE_SIZE 1024  // Cached attributes document capacity.
+#endif
+
+#ifndef CF_ATTR_CACHE_PATH
+#define CF_ATTR_CACHE_PATH "/cfattributes.msgpack"  // File where the attributes are saved.
+#endif
+
+#ifndef CF_ATTR_VERSION_KEY
+#define CF_ATTR_VERSION_KEY "attr_version"  // Shared attribute that versions the others.
+#endif
+
+class CFAttributeCache {
+ private:
+  // Aliases.
+  using AttributesCallback = void (*)(JsonObjectConst attributes);  // Alias for callback.
+
+  // Cache.
+  DynamicJsonDocument _attributes;  // Shared attributes.
+  bool _loaded;                     // Flag that indicates the attributes were loaded from flash.
+
+  // Metrics.
+  unsigned long _savedQty;      // Times the attributes were saved.
+  unsigned long _fetchedQty;    // Times the whole set was received.
+  unsigned long _checkedQty;    // Times the version was up to date.
+  unsigned long _discardedQty;  // Times the attributes received didn't fit.
+
+  // Callbacks.
+  AttributesCallback _onAttributesCallback;  // On attributes callback.
+
+  // Methods.
+  bool _load();     // Load the attributes saved.
+  void _save();     // Save the attributes to flash.
+  void _discard();  // Discard attributes that don't fit.
+
+ public:
+  CFAttributeCache();                                   // Constructor.
+  bool begin(AttributesCallback onAttributesCallback);  // Load the attributes and apply them.
+  bool hasVersion();                                    // True if the attributes have a version.
+  bool isUpToDate(JsonObjectConst shared);              // True if the version received is the one saved.
+  void replace(JsonObjectConst shared);                 // Replace the attributes with the whole set.
+  void update(JsonObjectConst changes);                 // Apply attribute changes.
+  JsonObjectConst getAttributes();                      // Get the attributes.
+  bool isLoaded();                                      // True if the attributes were loaded from flash.
+  void getMetrics(JsonObject metrics);                  // Get cache metrics.
+};
+
+#endif
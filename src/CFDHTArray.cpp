@@ -0,0 +1,150 @@
+/**
+ * CFDHTArray.cpp
+ *
+ * DHT Array for CF Arduino Devices with several DHT sensors.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFDHTArray.h>  // CF DHT Array.
+
+/**
+ * Constructor.
+ *
+ * @param sensors Sensors.
+ * @param sensorsQty Sensors quantity.
+ */
+CFDHTArray::CFDHTArray(CFDHTHelper *sensors, int sensorsQty) : _sensors(sensors),
+                                                               _sensorsQty(sensorsQty),
+                                                               _recovery(-1),
+                                                               _lastReading(0),
+                                                               _readingDelay(1000),
+                                                               _nextSensor(0) {
+}
+
+/**
+ * Constructor.
+ * DHT Workaround for fail reading failure.
+ *
+ * @param sensors Sensors.
+ * @param sensorsQty Sensors quantity.
+ * @param pinReset Pin that powers all sensors, used for forced reset when reading is fail.
+ */
+CFDHTArray::CFDHTArray(CFDHTHelper *sensors, int sensorsQty, int pinReset) : _sensors(sensors),
+                                                                             _sensorsQty(sensorsQty),
+                                                                             _recovery(pinReset),
+                                                                             _lastReading(0),
+                                                                             _readingDelay(1000),
+                                                                             _nextSensor(0) {
+}
+
+/**
+ * Initialize.
+ */
+void CFDHTArray::begin() {
+  _recovery.begin();  // DHT Workaround for fail reading failure.
+  for (int i = 0; i < _sensorsQty; i++) {
+    _sensors[i].begin();
+  }
+}
+
+/**
+ * Loop.
+ * Reads a single sensor per slot of reading interval / sensors quantity.
+ * A sensor that fails is read again as soon as the shared power supply is recovered.
+ */
+void CFDHTArray::loop() {
+  if (_sensorsQty == 0) return;
+
+  // Windows close on time, so the last readings are published even if a sensor stops answering.
+  for (int i = 0; i < _sensorsQty; i++) {
+    _sensors[i].getTemperatureStats()->loop();
+    _sensors[i].getHumidityStats()->loop();
+  }
+
+  // DHT Workaround for fail reading failure.
+  _recovery.loop();
+  if (!_recovery.isReady()) return;
+
+  if (_recovery.isRetrying() || _lastReading == 0 || millis() - _lastReading > _readingDelay / _sensorsQty) {
+    // Read
+    _lastReading = millis();
+
+    if (_sensors[_nextSensor].read()) {
+      _recovery.done();
+    } else if (_recovery.start()) {
+      return;  // Retry the same sensor.
+    }
+    _nextSensor = (_nextSensor + 1) % _sensorsQty;
+  }
+}
+
+/**
+ * Write the last readings of all sensors, keyed by sensor number (temperature_1, humidity_1, ...).
+ * Sensors that are not read are left out.
+ *
+ * @param snapshot Object where the readings are written.
+ */
+void CFDHTArray::getSnapshot(JsonObject snapshot) {
+  char key[24];
+  for (int i = 0; i < _sensorsQty; i++) {
+    CFDHTHelper &sensor = _sensors[i];
+    if (!sensor.isRead()) continue;
+
+    sprintf(key, "temperature_%d", i + 1);
+    snapshot[key] = sensor.getTemperatureC();
+    sprintf(key, "humidity_%d", i + 1);
+    snapshot[key] = sensor.getHumidity();
+    sprintf(key, "heat_index_%d", i + 1);
+    snapshot[key] = sensor.getHeatIndexC();
+  }
+}
+
+/**
+ * Define time between readings of the same sensor.
+ *
+ * @param readingDelay Time between readings.
+ */
+void CFDHTArray::setReadingInterval(long readingDelay) {
+  _readingDelay = readingDelay;
+}
+
+/**
+ * Get sensors quantity.
+ *
+ * @returns Sensors quantity.
+ */
+int CFDHTArray::getSensorsQty() {
+  return _sensorsQty;
+}
+
+/**
+ * Get a sensor.
+ *
+ * @param index Sensor index.
+ * @returns Sensor.
+ */
+CFDHTHelper *CFDHTArray::getSensor(int index) {
+  return &_sensors[index];
+}
+
+/**
+ * Get failure recovery of the shared reset pin, to tune its hold and warm up times.
+ *
+ * @returns Failure recovery.
+ */
+CFDHTRecovery *CFDHTArray::getRecovery() {
+  return &_recovery;
+}
+
+/**
+ * Get power cycles done through the shared reset pin.
+ * Failures and recovery times of each sensor are available from the sensor itself.
+ *
+ * @returns Power cycles since boot.
+ */
+unsigned long CFDHTArray::getResetsQty() {
+  return _recovery.getResetsQty();
+}
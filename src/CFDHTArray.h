@@ -0,0 +1,55 @@
+/**
+ * CFDHTArray.h
+ *
+ * DHT Array for CF Arduino Devices with several DHT sensors.
+ *
+ * Reading a DHT blocks for a few milliseconds, so the readings of the sensors are spread evenly
+ * across the reading interval and only one sensor is read per slot.
+ *
+ * Workaround:
+ *    Sensors sharing the same power supply share the reset pin (see CFDHTHelper), so it's handled
+ *    here and the sensors must be created without it.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFDHTArray_h
+#define CFDHTArray_h
+
+#include <ArduinoJson.h>    // Arduino JSON.
+#include <CFDHTHelper.h>    // CF DHT Helper.
+#include <CFDHTRecovery.h>  // CF DHT Recovery.
+
+class CFDHTArray {
+ private:
+  // Attributes.
+  CFDHTHelper *_sensors;    // Sensors.
+  int _sensorsQty;          // Sensors quantity.
+  CFDHTRecovery _recovery;  // DHT Workaround for fail reading failure.
+
+  // Loop control.
+  unsigned long _lastReading;   // Last time a sensor was read.
+  unsigned long _readingDelay;  // Time between readings of the same sensor.
+  int _nextSensor;              // Next sensor to be read.
+
+ public:
+  // Constructors.
+  CFDHTArray(CFDHTHelper *sensors, int sensorsQty);                // Constructor.
+  CFDHTArray(CFDHTHelper *sensors, int sensorsQty, int pinReset);  // Constructor with DHT Workaround for fail reading failure.
+
+  // Methods.
+  void begin();                           // Initialize.
+  void loop();                            // Loop.
+  void getSnapshot(JsonObject snapshot);  // Write the last readings of all sensors.
+
+  // Accessors.
+  void setReadingInterval(long readingDelay);  // Define time between readings of the same sensor.
+  int getSensorsQty();                         // Get sensors quantity.
+  CFDHTHelper *getSensor(int index);           // Get a sensor.
+  CFDHTRecovery *getRecovery();                // Get failure recovery.
+  unsigned long getResetsQty();                // Get power cycles done.
+};
+
+#endif
@@ -18,7 +18,8 @@
  * Workaround:
  *    A pin is being used for physically restarting DHT when it's getting NaN.
  *    Connect the + DHT pin to any pulled down digital write pin and pass it to the constructor.
- *    If it fails reading the pin will be turned off, then turned on again doing a physical reset.
+ *    If it fails reading the pin will be turned off, then turned on again doing a physical reset,
+ *    and the sensor is read again as soon as it's warmed up (see CFDHTRecovery).
  *
  * @author  Caio Frota <caiofrota@gmail.com>
  * @version 1.0
@@ -33,7 +34,7 @@
  * @param pinData Pin data.
  */
 CFDHTHelper::CFDHTHelper(int dhtType, int pinData) : _dht(pinData, dhtType),
-                                                     _pinReset(-1),
+                                                     _recovery(-1),
                                                      _read(false),
                                                      _temperatureC(0),
                                                      _temperatureF(0),
@@ -41,7 +42,13 @@ CFDHTHelper::CFDHTHelper(int dhtType, int pinData) : _dht(pinData, dhtType),
                                                      _heatIndexF(0),
                                                      _humidity(0),
                                                      _lastReading(0),
-                                                     _readingDelay(1000) {
+                                                     _readingDelay(1000),
+                                                     _temperatureStats(60000),
+                                                     _humidityStats(60000),
+                                                     _failuresQty(0),
+                                                     _recoveriesQty(0),
+                                                     _recoveryTime(0),
+                                                     _tFailure(0) {
 }
 
 /**
@@ -52,7 +59,7 @@ CFDHTHelper::CFDHTHelper(int dhtType, int pinData) : _dht(pinData, dhtType),
  * @param pinReset Pin used for forced reset when reading is fail.
  */
 CFDHTHelper::CFDHTHelper(int dhtType, int pinData, int pinReset) : _dht(pinData, dhtType),
-                                                                   _pinReset(pinReset),
+                                                                   _recovery(pinReset),
                                                                    _read(false),
                                                                    _temperatureC(0),
                                                                    _temperatureF(0),
@@ -60,17 +67,20 @@ CFDHTHelper::CFDHTHelper(int dhtType, int pinData, int pinReset) : _dht(pinData,
                                                                    _heatIndexF(0),
                                                                    _humidity(0),
                                                                    _lastReading(0),
-                                                                   _readingDelay(1000) {
+                                                                   _readingDelay(1000),
+                                                                   _temperatureStats(60000),
+                                                                   _humidityStats(60000),
+                                                                   _failuresQty(0),
+                                                                   _recoveriesQty(0),
+                                                                   _recoveryTime(0),
+                                                                   _tFailure(0) {
 }
 
 /**
  * Initialize.
  */
 void CFDHTHelper::begin() {
-  if (_pinReset != -1) {
-    pinMode(_pinReset, OUTPUT);     // DHT Workaround for fail reading failure.
-    digitalWrite(_pinReset, HIGH);  // Turn on the DHT pin.
-  }
+  _recovery.begin();  // DHT Workaround for fail reading failure.
   _dht.begin();
 }
 
@@ -78,37 +88,77 @@ void CFDHTHelper::begin() {
  * Loop.
  */
 void CFDHTHelper::loop() {
-  if (_lastReading == 0 || millis() - _lastReading > _readingDelay) {
+  // Windows close on time, so the last readings are published even if the sensor stops answering.
+  _temperatureStats.loop();
+  _humidityStats.loop();
+
+  // DHT Workaround for fail reading failure.
+  _recovery.loop();
+  if (!_recovery.isReady()) return;
+
+  if (_recovery.isRetrying() || _lastReading == 0 || millis() - _lastReading > _readingDelay) {
     // Read
     _lastReading = millis();
 
-    _temperatureC = _dht.readTemperature();
-    _temperatureF = _dht.readTemperature(true);
-    _humidity = _dht.readHumidity();
-
-    // Check if it was read.
-    if (isnan(_temperatureC) || isnan(_temperatureF) || isnan(_humidity)) {
-      _temperatureC = 0;
-      _temperatureF = 0;
-      _heatIndexC = 0;
-      _heatIndexF = 0;
-      _humidity = 0;
-      _read = false;
+    if (read()) {
+      _recovery.done();
+    } else {
+      _recovery.start();
+    }
+  }
+}
 
-      // DHT Workaround for fail reading failure.
-      digitalWrite(_pinReset, !digitalRead(_pinReset));  // Force physical power recycle.
+/**
+ * Read the sensor now, regardless of the reading interval.
+ *
+ * @returns True if it was read.
+ */
+bool CFDHTHelper::read() {
+  CF_WATCHDOG_SECTION("dht_read");
+  float temperature = _dht.readTemperature();
+  float humidity = _dht.readHumidity();
 
-      return;
-    }
+  // Check if it was read.
+  if (isnan(temperature) || isnan(humidity)) {
+    _temperatureC = 0;
+    _temperatureF = 0;
+    _heatIndexC = 0;
+    _heatIndexF = 0;
+    _humidity = 0;
+    _read = false;
 
-    _temperatureC = roundf(_temperatureC * 10) / 10;
-    _temperatureF = roundf(_temperatureF * 10) / 10;
-    _humidity = roundf(_humidity * 10) / 10;
-    _heatIndexC = roundf(_dht.computeHeatIndex(_temperatureC, _humidity, false) * 10) / 10;
-    _heatIndexF = roundf(_dht.computeHeatIndex(_temperatureC, _humidity) * 10) / 10;
+    // Health statistics.
+    _failuresQty++;
+    if (_tFailure == 0) _tFailure = millis();
+    return false;
+  }
 
-    _read = true;
+  // Health statistics.
+  if (_tFailure != 0) {
+    _recoveriesQty++;
+    _recoveryTime += millis() - _tFailure;
+    _tFailure = 0;
   }
+
+  // Work in tenths, the DHT resolution, so conversions and heat index are integer math.
+  int16_t temperatureC = lroundf(temperature * 10);
+  int16_t humidityPct = lroundf(humidity * 10);
+  int16_t heatIndexC;
+  int16_t heatIndexF;
+  CFHeatIndex::compute(temperatureC, humidityPct, heatIndexC, heatIndexF);
+
+  _temperatureC = temperatureC / 10.0f;
+  _temperatureF = CFHeatIndex::celsiusToFahrenheit(temperatureC) / 10.0f;
+  _humidity = humidityPct / 10.0f;
+  _heatIndexC = heatIndexC / 10.0f;
+  _heatIndexF = heatIndexF / 10.0f;
+
+  // Windowed statistics.
+  _temperatureStats.addFixed(temperatureC);
+  _humidityStats.addFixed(humidityPct);
+
+  _read = true;
+  return true;
 }
 
 /**
@@ -182,3 +232,57 @@ float CFDHTHelper::getHumidity() {
 DHT CFDHTHelper::getDHT() {
   return _dht;
 }
+
+/**
+ * Get failure recovery, to tune its hold and warm up times.
+ *
+ * @returns Failure recovery.
+ */
+CFDHTRecovery *CFDHTHelper::getRecovery() {
+  return &_recovery;
+}
+
+/**
+ * Get temperature in C statistics, aggregated per window (1 minute by default).
+ *
+ * @returns Temperature statistics.
+ */
+CFRollingStats *CFDHTHelper::getTemperatureStats() {
+  return &_temperatureStats;
+}
+
+/**
+ * Get humidity statistics, aggregated per window (1 minute by default).
+ *
+ * @returns Humidity statistics.
+ */
+CFRollingStats *CFDHTHelper::getHumidityStats() {
+  return &_humidityStats;
+}
+
+/**
+ * Get failed readings.
+ *
+ * @returns Failed readings since boot.
+ */
+unsigned long CFDHTHelper::getFailuresQty() {
+  return _failuresQty;
+}
+
+/**
+ * Get power cycles done through the reset pin.
+ *
+ * @returns Power cycles since boot.
+ */
+unsigned long CFDHTHelper::getResetsQty() {
+  return _recovery.getResetsQty();
+}
+
+/**
+ * Get mean time to recover, from the first failed reading to the next successful one.
+ *
+ * @returns Mean recovery time in milliseconds.
+ */
+unsigned long CFDHTHelper::getMeanRecoveryTime() {
+  return _recoveriesQty > 0 ? _recoveryTime / _recoveriesQty : 0;
+}
@@ -18,7 +18,8 @@
  * Workaround:
  *    A pin is being used for physically restarting DHT when it's getting NaN.
  *    Connect the + DHT pin to any pulled down digital write pin and pass it to the constructor.
- *    If it fails reading the pin will be turned off, then turned on again doing a physical reset.
+ *    If it fails reading the pin will be turned off, then turned on again doing a physical reset,
+ *    and the sensor is read again as soon as it's warmed up (see CFDHTRecovery).
  *
  * @author  Caio Frota <caiofrota@gmail.com>
  * @version 1.0
@@ -28,25 +29,39 @@
 #ifndef CFDHTHelper_h
 #define CFDHTHelper_h
 
-#include <DHT.h>     // DHT.
-#include <Logger.h>  // Logger.
+#include <CFDHTRecovery.h>   // CF DHT Recovery.
+#include <CFHeatIndex.h>     // CF Heat Index.
+#include <CFRollingStats.h>  // CF Rolling Stats.
+#include <CFWatchdog.h>      // CF Watchdog.
+#include <DHT.h>             // DHT.
+#include <Logger.h>          // Logger.
 
 class CFDHTHelper {
  private:
   // Attributes.
-  DHT _dht;             // DHT object.
-  int _pinReset;        // DHT Workaround for fail reading failure.
-  bool _read;           // Flag that indicate if data was read.
-  float _temperatureC;  // Temperature in C.
-  float _temperatureF;  // Temperature in F.
-  float _heatIndexC;    // Heat index in C.
-  float _heatIndexF;    // Heat index in F.
-  float _humidity;      // Humidity.
+  DHT _dht;                 // DHT object.
+  CFDHTRecovery _recovery;  // DHT Workaround for fail reading failure.
+  bool _read;               // Flag that indicate if data was read.
+  float _temperatureC;      // Temperature in C.
+  float _temperatureF;      // Temperature in F.
+  float _heatIndexC;        // Heat index in C.
+  float _heatIndexF;        // Heat index in F.
+  float _humidity;          // Humidity.
 
   // Loop control.
   unsigned long _lastReading;   // Last time data was read.
   unsigned long _readingDelay;  // Time between readings.
 
+  // Windowed statistics.
+  CFRollingStats _temperatureStats;  // Temperature in C statistics.
+  CFRollingStats _humidityStats;     // Humidity statistics.
+
+  // Health statistics.
+  unsigned long _failuresQty;    // Failed readings.
+  unsigned long _recoveriesQty;  // Recoveries from failed readings.
+  unsigned long _recoveryTime;   // Total time from the first failed reading to the next successful one.
+  unsigned long _tFailure;       // Time of the first failed reading, 0 if the last reading was successful.
+
  public:
   // Constructors.
   CFDHTHelper(int dhtType, int pinData);                // Constructor.
@@ -55,6 +70,7 @@ class CFDHTHelper {
   // Methods.
   void begin();  // Initialize.
   void loop();   // Loop.
+  bool read();   // Read the sensor now.
 
   // Accessors.
   void setReadingInterval(long readingDelay);  // Define time between readings.
@@ -65,6 +81,12 @@ class CFDHTHelper {
   float getHeatIndexF();                       // Get heat inter in F.
   float getHumidity();                         // Get humidity.
   DHT getDHT();                                // Get DHT object.
+  CFDHTRecovery *getRecovery();                // Get failure recovery.
+  CFRollingStats *getTemperatureStats();       // Get temperature in C statistics.
+  CFRollingStats *getHumidityStats();          // Get humidity statistics.
+  unsigned long getFailuresQty();              // Get failed readings.
+  unsigned long getResetsQty();                // Get power cycles done.
+  unsigned long getMeanRecoveryTime();         // Get mean time to recover from failed readings.
 };
 
 #endif
@@ -0,0 +1,135 @@
+/**
+ * CFDHTRecovery.cpp
+ *
+ * DHT failure recovery for CF Arduino Devices.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFDHTRecovery.h>  // CF DHT Recovery.
+
+/**
+ * Constructor.
+ *
+ * @param pinReset Pin used for forced reset when reading is fail, -1 if there is none.
+ */
+CFDHTRecovery::CFDHTRecovery(int pinReset) : _pinReset(pinReset),
+                                             _state(READY),
+                                             _tState(0),
+                                             _holdTime(1000),
+                                             _warmUpTime(2000),
+                                             _attempts(0),
+                                             _resetsQty(0) {
+}
+
+/**
+ * Initialize.
+ */
+void CFDHTRecovery::begin() {
+  if (_pinReset.isValid()) {
+    _pinReset.setMode(OUTPUT);  // DHT Workaround for fail reading failure.
+    _pinReset.write(true);      // Turn on the DHT pin.
+  }
+}
+
+/**
+ * Loop.
+ */
+void CFDHTRecovery::loop() {
+  switch (_state) {
+    case POWER_OFF:
+      if (millis() - _tState >= _holdTime) {
+        _pinReset.write(true);  // Turn on the DHT pin.
+        _setState(WARM_UP);
+      }
+      break;
+    case WARM_UP:
+      if (millis() - _tState >= _warmUpTime) {
+        _setState(RETRY);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * Start recovering after a failed reading.
+ *
+ * @returns True if it's recovering, false if it gave up until the next regular reading.
+ */
+bool CFDHTRecovery::start() {
+  if (_attempts >= CF_DHT_MAX_ATTEMPTS) {
+    _attempts = 0;
+    _setState(READY);
+    return false;
+  }
+  _attempts++;
+
+  if (_pinReset.isValid()) {
+    _pinReset.write(false);  // Force physical power recycle.
+    _resetsQty++;
+    _setState(POWER_OFF);
+  } else {
+    _setState(WARM_UP);
+  }
+  return true;
+}
+
+/**
+ * Finish recovering after a successful reading.
+ */
+void CFDHTRecovery::done() {
+  _attempts = 0;
+  _setState(READY);
+}
+
+/**
+ * Define current state.
+ *
+ * @param state State.
+ */
+void CFDHTRecovery::_setState(State state) {
+  _state = state;
+  _tState = millis();
+}
+
+/**
+ * Define hold and warm up times.
+ *
+ * @param holdTime Time the sensor is kept powered off.
+ * @param warmUpTime Time the sensor takes to be read after powered on (2 seconds for DHT22).
+ */
+void CFDHTRecovery::setRecoveryTimes(unsigned long holdTime, unsigned long warmUpTime) {
+  _holdTime = holdTime;
+  _warmUpTime = warmUpTime;
+}
+
+/**
+ * True if the sensor can be read.
+ *
+ * @returns True if it's not powered off or warming up.
+ */
+bool CFDHTRecovery::isReady() {
+  return _state == READY || _state == RETRY;
+}
+
+/**
+ * True if the sensor must be read right away, regardless of the reading interval.
+ *
+ * @returns True if it's recovering and ready to retry.
+ */
+bool CFDHTRecovery::isRetrying() {
+  return _state == RETRY;
+}
+
+/**
+ * Get power cycles done.
+ *
+ * @returns Power cycles since boot.
+ */
+unsigned long CFDHTRecovery::getResetsQty() {
+  return _resetsQty;
+}
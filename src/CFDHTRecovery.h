@@ -0,0 +1,66 @@
+/**
+ * CFDHTRecovery.h
+ *
+ * DHT failure recovery for CF Arduino Devices.
+ *
+ * When a reading fails the sensor is powered off through the reset pin, held off, powered on and
+ * given time to warm up before it's read again, without blocking the loop. If it keeps failing
+ * after a few attempts it's left to the regular reading interval.
+ *
+ * Without reset pin it only waits for the warm up time before trying again.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFDHTRecovery_h
+#define CFDHTRecovery_h
+
+#include <Arduino.h>     // Arduino library.
+#include <CFFastGPIO.h>  // CF Fast GPIO.
+
+#ifndef CF_DHT_MAX_ATTEMPTS
+#define CF_DHT_MAX_ATTEMPTS 3  // Max consecutive recovery attempts.
+#endif
+
+class CFDHTRecovery {
+ private:
+  // States.
+  enum State {
+    READY,      // Sensor can be read.
+    POWER_OFF,  // Sensor is powered off.
+    WARM_UP,    // Sensor is powered on and warming up.
+    RETRY       // Sensor must be read right away.
+  };
+
+  // Attributes.
+  CFFastGPIO _pinReset;       // DHT Workaround for fail reading failure.
+  State _state;               // Current state.
+  unsigned long _tState;      // Time the current state started.
+  unsigned long _holdTime;    // Time the sensor is kept powered off.
+  unsigned long _warmUpTime;  // Time the sensor takes to be read after powered on.
+  int _attempts;              // Consecutive recovery attempts.
+  unsigned long _resetsQty;   // Power cycles done.
+
+  // Methods.
+  void _setState(State state);  // Define current state.
+
+ public:
+  // Constructors.
+  CFDHTRecovery(int pinReset);  // Constructor.
+
+  // Methods.
+  void begin();  // Initialize.
+  void loop();   // Loop.
+  bool start();  // Start recovering after a failed reading.
+  void done();   // Finish recovering after a successful reading.
+
+  // Accessors.
+  void setRecoveryTimes(unsigned long holdTime, unsigned long warmUpTime);  // Define hold and warm up times.
+  bool isReady();                                                           // True if the sensor can be read.
+  bool isRetrying();                                                        // True if the sensor must be read right away.
+  unsigned long getResetsQty();                                             // Get power cycles done.
+};
+
+#endif
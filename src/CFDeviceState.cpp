@@ -0,0 +1,364 @@
+/**
+ * CFDeviceState.cpp
+ *
+ * A property store for CF Arduino Devices state, shared by every place the state is shown or sent.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFDeviceState.h>  // CF Device State.
+
+/**
+ * Constructor.
+ */
+CFDeviceState::CFDeviceState() : _propertiesQty(0) {
+}
+
+/**
+ * Register a property.
+ * New properties are dirty for every sink they are bound to, so their first value is pulled as well.
+ *
+ * @param name Property name. It must live as long as the state does.
+ * @param type Property type.
+ * @param sinks Sinks it's bound to.
+ * @returns Property index or -1 if it couldn't be registered.
+ */
+int CFDeviceState::_add(const char *name, Type type, uint8_t sinks) {
+  if (_propertiesQty >= CF_DEVICE_STATE_MAX_PROPERTIES) {
+    CF_LOG_WARNING("Device state is full. Increase CF_DEVICE_STATE_MAX_PROPERTIES.");
+    return -1;
+  }
+  Property &p = _properties[_propertiesQty];
+  p.name = name;
+  p.type = type;
+  p.sinks = sinks;
+  p.dirty = sinks;
+  return _propertiesQty++;
+}
+
+/**
+ * Register a boolean property.
+ *
+ * @param name Property name.
+ * @param value Initial value.
+ * @param sinks Sinks it's bound to.
+ * @returns Property index or -1 if it couldn't be registered.
+ */
+int CFDeviceState::addBool(const char *name, bool value, uint8_t sinks) {
+  int property = _add(name, TYPE_BOOL, sinks);
+  if (property >= 0) _properties[property].value.b = value;
+  return property;
+}
+
+/**
+ * Register an integer property.
+ *
+ * @param name Property name.
+ * @param value Initial value.
+ * @param sinks Sinks it's bound to.
+ * @returns Property index or -1 if it couldn't be registered.
+ */
+int CFDeviceState::addInt(const char *name, long value, uint8_t sinks) {
+  int property = _add(name, TYPE_INT, sinks);
+  if (property >= 0) _properties[property].value.i = value;
+  return property;
+}
+
+/**
+ * Register a float property.
+ *
+ * @param name Property name.
+ * @param value Initial value.
+ * @param sinks Sinks it's bound to.
+ * @returns Property index or -1 if it couldn't be registered.
+ */
+int CFDeviceState::addFloat(const char *name, float value, uint8_t sinks) {
+  int property = _add(name, TYPE_FLOAT, sinks);
+  if (property >= 0) _properties[property].value.f = value;
+  return property;
+}
+
+/**
+ * Get the index of a property.
+ *
+ * @param name Property name.
+ * @returns Property index or -1 if it's not registered.
+ */
+int CFDeviceState::find(const char *name) {
+  for (uint8_t i = 0; i < _propertiesQty; i++) {
+    if (strcmp(_properties[i].name, name) == 0) return i;
+  }
+  return -1;
+}
+
+/**
+ * True if the property exists with the type.
+ *
+ * @param property Property index.
+ * @param type Expected type.
+ * @returns True if it can be accessed as the type.
+ */
+bool CFDeviceState::_check(uint8_t property, Type type) {
+  if (property < _propertiesQty && _properties[property].type == type) return true;
+  CF_LOG_WARNING("Device state property not found or of another type.");
+  return false;
+}
+
+/**
+ * Flag a changed property for its sinks.
+ *
+ * @param property Property index.
+ * @param origin Sinks the change came from, they already have the new value.
+ */
+void CFDeviceState::_changed(uint8_t property, uint8_t origin) {
+  _properties[property].dirty |= _properties[property].sinks & ~origin;
+}
+
+/**
+ * Set a boolean value.
+ *
+ * @param property Property index.
+ * @param value Value.
+ * @param origin Sinks the change came from, they aren't flagged.
+ * @returns True if the value changed.
+ */
+bool CFDeviceState::setBool(uint8_t property, bool value, uint8_t origin) {
+  if (!_check(property, TYPE_BOOL) || _properties[property].value.b == value) return false;
+  _properties[property].value.b = value;
+  _changed(property, origin);
+  return true;
+}
+
+/**
+ * Set an integer value.
+ *
+ * @param property Property index.
+ * @param value Value.
+ * @param origin Sinks the change came from, they aren't flagged.
+ * @returns True if the value changed.
+ */
+bool CFDeviceState::setInt(uint8_t property, long value, uint8_t origin) {
+  if (!_check(property, TYPE_INT) || _properties[property].value.i == value) return false;
+  _properties[property].value.i = value;
+  _changed(property, origin);
+  return true;
+}
+
+/**
+ * Set a float value.
+ *
+ * @param property Property index.
+ * @param value Value.
+ * @param origin Sinks the change came from, they aren't flagged.
+ * @returns True if the value changed.
+ */
+bool CFDeviceState::setFloat(uint8_t property, float value, uint8_t origin) {
+  if (!_check(property, TYPE_FLOAT) || _properties[property].value.f == value) return false;
+  _properties[property].value.f = value;
+  _changed(property, origin);
+  return true;
+}
+
+/**
+ * Set a value from its text, as it comes in a query string or a form.
+ * Booleans take 1/0, true/false or on/off.
+ *
+ * @param property Property index.
+ * @param value Value text.
+ * @param origin Sinks the change came from, they aren't flagged.
+ * @returns True if it's a valid value for the property.
+ */
+bool CFDeviceState::setFromString(uint8_t property, const char *value, uint8_t origin) {
+  if (property >= _propertiesQty || !value) return false;
+
+  char *end;
+  switch (_properties[property].type) {
+    case TYPE_BOOL:
+      if (strcmp(value, "1") == 0 || strcasecmp(value, "true") == 0 || strcasecmp(value, "on") == 0) {
+        setBool(property, true, origin);
+      } else if (strcmp(value, "0") == 0 || strcasecmp(value, "false") == 0 || strcasecmp(value, "off") == 0) {
+        setBool(property, false, origin);
+      } else {
+        return false;
+      }
+      return true;
+    case TYPE_INT: {
+      long number = strtol(value, &end, 10);
+      if (end == value || *end != '\0') return false;
+      setInt(property, number, origin);
+      return true;
+    }
+    case TYPE_FLOAT: {
+      float number = strtof(value, &end);
+      if (end == value || *end != '\0') return false;
+      setFloat(property, number, origin);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Get a boolean value.
+ *
+ * @param property Property index.
+ * @returns Value or false if it's not a boolean property.
+ */
+bool CFDeviceState::getBool(uint8_t property) {
+  return _check(property, TYPE_BOOL) ? _properties[property].value.b : false;
+}
+
+/**
+ * Get an integer value.
+ *
+ * @param property Property index.
+ * @returns Value or 0 if it's not an integer property.
+ */
+long CFDeviceState::getInt(uint8_t property) {
+  return _check(property, TYPE_INT) ? _properties[property].value.i : 0;
+}
+
+/**
+ * Get a float value.
+ *
+ * @param property Property index.
+ * @returns Value or 0 if it's not a float property.
+ */
+float CFDeviceState::getFloat(uint8_t property) {
+  return _check(property, TYPE_FLOAT) ? _properties[property].value.f : 0;
+}
+
+/**
+ * Get a property name.
+ *
+ * @param property Property index.
+ * @returns Name or NULL if it's not registered.
+ */
+const char *CFDeviceState::getName(uint8_t property) {
+  return property < _propertiesQty ? _properties[property].name : NULL;
+}
+
+/**
+ * Get a property type.
+ *
+ * @param property Property index.
+ * @returns Type.
+ */
+CFDeviceState::Type CFDeviceState::getType(uint8_t property) {
+  return property < _propertiesQty ? _properties[property].type : TYPE_INT;
+}
+
+/**
+ * Get properties quantity.
+ *
+ * @returns Properties quantity.
+ */
+uint8_t CFDeviceState::getPropertiesQty() {
+  return _propertiesQty;
+}
+
+/**
+ * True if a sink hasn't pulled the current value of a property.
+ *
+ * @param property Property index.
+ * @param sink Sink.
+ * @returns True if it's dirty for the sink.
+ */
+bool CFDeviceState::isDirty(uint8_t property, uint8_t sink) {
+  return property < _propertiesQty && (_properties[property].dirty & sink) != 0;
+}
+
+/**
+ * True if a sink hasn't pulled the current value of any property.
+ *
+ * @param sink Sink.
+ * @returns True if there are changes for the sink.
+ */
+bool CFDeviceState::hasChanges(uint8_t sink) {
+  for (uint8_t i = 0; i < _propertiesQty; i++) {
+    if (_properties[i].dirty & sink) return true;
+  }
+  return false;
+}
+
+/**
+ * Mark a property as pulled by a sink.
+ *
+ * @param property Property index.
+ * @param sink Sink.
+ */
+void CFDeviceState::clear(uint8_t property, uint8_t sink) {
+  if (property < _propertiesQty) _properties[property].dirty &= ~sink;
+}
+
+/**
+ * Take what changed for a sink.
+ * Every dirty property is written as name: value and marked as pulled by the sink.
+ *
+ * @param sink Sink.
+ * @param changes Object where the changed properties are written.
+ * @returns Properties written.
+ */
+uint8_t CFDeviceState::pull(uint8_t sink, JsonObject changes) {
+  uint8_t pulled = 0;
+  for (uint8_t i = 0; i < _propertiesQty; i++) {
+    Property &p = _properties[i];
+    if ((p.dirty & sink) == 0) continue;
+
+    bool written = false;
+    switch (p.type) {
+      case TYPE_BOOL:
+        written = changes[p.name].set(p.value.b);
+        break;
+      case TYPE_INT:
+        written = changes[p.name].set(p.value.i);
+        break;
+      case TYPE_FLOAT:
+        written = changes[p.name].set(p.value.f);
+        break;
+    }
+    if (!written) {
+      // Keep it dirty to be pulled next time.
+      CF_LOG_WARNING("Fail pulling device state. Increase the changes document size.");
+      break;
+    }
+    p.dirty &= ~sink;
+    pulled++;
+  }
+  return pulled;
+}
+
+/**
+ * Flag every property bound to a sink, so it gets the whole state again (e.g. after reconnecting).
+ *
+ * @param sink Sink.
+ */
+void CFDeviceState::invalidate(uint8_t sink) {
+  for (uint8_t i = 0; i < _propertiesQty; i++) {
+    _properties[i].dirty |= _properties[i].sinks & sink;
+  }
+}
+
+/**
+ * Get every property value, without marking them as pulled.
+ *
+ * @param state Object where the properties are written as name: value.
+ */
+void CFDeviceState::getSnapshot(JsonObject state) {
+  for (uint8_t i = 0; i < _propertiesQty; i++) {
+    Property &p = _properties[i];
+    switch (p.type) {
+      case TYPE_BOOL:
+        state[p.name] = p.value.b;
+        break;
+      case TYPE_INT:
+        state[p.name] = p.value.i;
+        break;
+      case TYPE_FLOAT:
+        state[p.name] = p.value.f;
+        break;
+    }
+  }
+}
@@ -0,0 +1,91 @@
+/**
+ * CFDeviceState.h
+ *
+ * A property store for CF Arduino Devices state, shared by every place the state is shown or sent.
+ *
+ * Each property keeps a dirty flag per sink (ThingsBoard telemetry and attributes, Alexa, display,
+ * the device outputs...). Changing a value flags it for every sink it's bound to, except the one the
+ * change came from, and each sink pulls only what changed since it last did, clearing its own flags.
+ * Nothing is written to a sink while the value stays the same, and no sink misses a change.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFDeviceState_h
+#define CFDeviceState_h
+
+#include <ArduinoJson.h>  // Arduino JSON.
+#include <CFLog.h>        // CF Log.
+
+#ifndef CF_DEVICE_STATE_MAX_PROPERTIES
+#define CF_DEVICE_STATE_MAX_PROPERTIES 16  // Max properties quantity.
+#endif
+
+class CFDeviceState {
+ public:
+  // Sinks (bitmask, up to 8).
+  enum Sink : uint8_t {
+    SINK_TELEMETRY = 0x01,   // ThingsBoard telemetry.
+    SINK_ATTRIBUTES = 0x02,  // ThingsBoard attributes.
+    SINK_ALEXA = 0x04,       // Alexa.
+    SINK_DISPLAY = 0x08,     // Display.
+    SINK_LOCAL = 0x10,       // Device outputs (relays, leds...).
+    SINK_ALL = 0xFF          // Every sink.
+  };
+
+  // Property types.
+  enum Type : uint8_t {
+    TYPE_BOOL,  // Boolean.
+    TYPE_INT,   // Integer.
+    TYPE_FLOAT  // Float.
+  };
+
+ private:
+  // Properties.
+  struct Property {
+    const char *name;  // Name.
+    Type type;         // Type.
+    union {
+      bool b;   // Boolean value.
+      long i;   // Integer value.
+      float f;  // Float value.
+    } value;
+    uint8_t sinks;  // Sinks it's bound to.
+    uint8_t dirty;  // Sinks that haven't pulled the current value.
+  };
+  Property _properties[CF_DEVICE_STATE_MAX_PROPERTIES];  // Properties.
+  uint8_t _propertiesQty;                                // Properties quantity.
+
+  // Methods.
+  int _add(const char *name, Type type, uint8_t sinks);  // Register a property.
+  bool _check(uint8_t property, Type type);              // True if the property exists with the type.
+  void _changed(uint8_t property, uint8_t origin);       // Flag a changed property.
+
+ public:
+  CFDeviceState();                                                        // Constructor.
+  int addBool(const char *name, bool value, uint8_t sinks = SINK_ALL);    // Register a boolean property.
+  int addInt(const char *name, long value, uint8_t sinks = SINK_ALL);     // Register an integer property.
+  int addFloat(const char *name, float value, uint8_t sinks = SINK_ALL);  // Register a float property.
+  int find(const char *name);                                             // Get the index of a property.
+  bool setBool(uint8_t property, bool value, uint8_t origin = 0);         // Set a boolean value.
+  bool setInt(uint8_t property, long value, uint8_t origin = 0);          // Set an integer value.
+  bool setFloat(uint8_t property, float value, uint8_t origin = 0);       // Set a float value.
+  bool setFromString(uint8_t property, const char *value,                 // Set a value from its text.
+                     uint8_t origin = 0);
+  bool getBool(uint8_t property);                                         // Get a boolean value.
+  long getInt(uint8_t property);                                          // Get an integer value.
+  float getFloat(uint8_t property);                                       // Get a float value.
+  const char *getName(uint8_t property);                                  // Get a property name.
+  Type getType(uint8_t property);                                         // Get a property type.
+  uint8_t getPropertiesQty();                                             // Get properties quantity.
+  bool isDirty(uint8_t property, uint8_t sink);                           // True if a sink hasn't pulled a property.
+  bool hasChanges(uint8_t sink);                                          // True if a sink hasn't pulled any property.
+  void clear(uint8_t property, uint8_t sink);                             // Mark a property as pulled by a sink.
+  uint8_t pull(uint8_t sink, JsonObject changes);                         // Take what changed for a sink.
+  void invalidate(uint8_t sink);                                          // Flag every property of a sink.
+  void getSnapshot(JsonObject state);                                     // Get every property value.
+};
+
+#endif
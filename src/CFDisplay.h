@@ -0,0 +1,210 @@
+/**
+ * CFDisplay.h
+ *
+ * A library for Arduino that drives SSD1306 I2C displays of a geometry known at compile time.
+ *
+ * Same use as CFDisplayHelper, with the geometry as template parameters, e.g. CFDisplay<128, 64>:
+ *    - The frame buffer is part of the object, so a global display is in .bss and shows in the
+ *      RAM used at build time instead of being allocated by begin().
+ *    - Bounds checks, page math, init commands and the logo check are constants, the compiler
+ *      folds them away.
+ *    - It's an Adafruit_GFX, so every drawing method is available. Rotation isn't supported.
+ * display() sends the whole frame at once, use CFDisplayHelper for the flush budget.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFDisplay_h
+#define CFDisplay_h
+
+#include <Adafruit_GFX.h>      // Adafruit GFX.
+#include <Adafruit_SSD1306.h>  // Adafruit display (commands and colors).
+#include <Arduino.h>           // Arduino library.
+#include <CFDisplayHelper.h>   // CF Display Helper (I2C settings).
+#include <CFIconSet.h>         // CF Icon Set for display.
+#include <CFWatchdog.h>        // CF Watchdog.
+#include <Wire.h>              // Wire.
+
+template <uint8_t W, uint8_t H>
+class CFDisplay : public Adafruit_GFX {
+  static_assert(W >= 1 && W <= 128, "Width must be from 1 to 128.");
+  static_assert(H >= 16 && H <= 64 && H % 8 == 0, "Height must be a multiple of 8 from 16 to 64.");
+
+ private:
+  // Geometry.
+  static constexpr uint8_t PAGES = H / 8;                                      // Pages (8 rows each).
+  static constexpr uint16_t BUFFER_SIZE = W * PAGES;                           // Frame buffer size.
+  static constexpr uint8_t COLUMN = W == 64 ? 32 : 0;                          // First column in the controller RAM.
+  static constexpr uint8_t COM_PINS = H == 64 ? 0x12 : 0x02;                   // COM pins configuration.
+  static constexpr uint8_t CONTRAST = H == 64 ? 0xCF : H == 16 ? 0xAF : 0x8F;  // Contrast.
+
+  // Display attributes.
+  uint8_t _buffer[BUFFER_SIZE];  // Frame buffer.
+  uint8_t _address;              // Display address.
+  bool _showLogo;                // Flag that indicates if it's to show the logo.
+  unsigned long _logoTime;       // Time that will show the logo.
+
+  // Metrics.
+  unsigned long _frameTime;  // Time to send the last frame (us).
+
+  /**
+   * Send commands.
+   *
+   * @param commands Commands.
+   * @param length Commands quantity.
+   */
+  void _commands(const uint8_t *commands, size_t length) {
+    for (size_t sent = 0; sent < length; sent += CF_DISPLAY_I2C_CHUNK) {
+      Wire.beginTransmission(_address);
+      Wire.write((uint8_t)0x00);  // Command stream.
+      Wire.write(commands + sent, min((size_t)CF_DISPLAY_I2C_CHUNK, length - sent));
+      Wire.endTransmission();
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   *
+   * @param addr Display address.
+   */
+  CFDisplay(uint8_t addr) : Adafruit_GFX(W, H),
+                            _address(addr),
+                            _showLogo(true),
+                            _logoTime(3000),
+                            _frameTime(0) {
+    memset(_buffer, 0, BUFFER_SIZE);
+  }
+
+  /**
+   * Initialize.
+   */
+  void begin() {
+    static const uint8_t init[] = {SSD1306_DISPLAYOFF,
+                                   SSD1306_SETDISPLAYCLOCKDIV, 0x80,
+                                   SSD1306_SETMULTIPLEX, H - 1,
+                                   SSD1306_SETDISPLAYOFFSET, 0x00,
+                                   SSD1306_SETSTARTLINE | 0x00,
+                                   SSD1306_CHARGEPUMP, 0x14,  // Generate display voltage from 3.3V internally.
+                                   SSD1306_MEMORYMODE, 0x00,
+                                   SSD1306_SEGREMAP | 0x01,
+                                   SSD1306_COMSCANDEC,
+                                   SSD1306_SETCOMPINS, COM_PINS,
+                                   SSD1306_SETCONTRAST, CONTRAST,
+                                   SSD1306_SETPRECHARGE, 0xF1,
+                                   SSD1306_SETVCOMDETECT, 0x40,
+                                   SSD1306_DISPLAYALLON_RESUME,
+                                   SSD1306_NORMALDISPLAY,
+                                   SSD1306_DEACTIVATE_SCROLL,
+                                   SSD1306_DISPLAYON};
+    Wire.begin();
+    Wire.setClock(CF_DISPLAY_I2C_CLOCK);
+    _commands(init, sizeof(init));
+    Wire.setClock(CF_DISPLAY_I2C_CLOCK_IDLE);
+
+    // Display logo.
+    if (W == 128 && H == 64 && _showLogo) {
+      clearDisplay();
+      drawBitmap(0, 0, CFIconSet::CFLOGO_128X64, 128, 64, 1);
+      display();
+      delay(_logoTime);
+    }
+
+    // Clear display.
+    clearDisplay();
+    cp437(true);
+    setTextSize(1);
+    setTextColor(SSD1306_WHITE);
+  }
+
+  /**
+   * Render display.
+   */
+  void display() {
+    static const uint8_t window[] = {SSD1306_PAGEADDR, 0, PAGES - 1, SSD1306_COLUMNADDR, COLUMN, COLUMN + W - 1};
+    CF_WATCHDOG_SECTION("display_flush");
+    unsigned long tStart = micros();
+    Wire.setClock(CF_DISPLAY_I2C_CLOCK);
+    _commands(window, sizeof(window));
+    for (uint16_t sent = 0; sent < BUFFER_SIZE; sent += CF_DISPLAY_I2C_CHUNK) {
+      Wire.beginTransmission(_address);
+      Wire.write((uint8_t)0x40);  // Data stream.
+      Wire.write(_buffer + sent, min((uint16_t)CF_DISPLAY_I2C_CHUNK, (uint16_t)(BUFFER_SIZE - sent)));
+      Wire.endTransmission();
+    }
+    Wire.setClock(CF_DISPLAY_I2C_CLOCK_IDLE);
+    _frameTime = micros() - tStart;
+  }
+
+  /**
+   * Clear display.
+   */
+  void clearDisplay() {
+    memset(_buffer, 0, BUFFER_SIZE);
+  }
+
+  /**
+   * Set a pixel.
+   *
+   * @param x Column.
+   * @param y Line.
+   * @param color SSD1306_WHITE, SSD1306_BLACK or SSD1306_INVERSE.
+   */
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if ((uint16_t)x >= W || (uint16_t)y >= H) return;
+    uint8_t &cell = _buffer[(y / 8) * W + x];
+    uint8_t mask = 1 << (y & 7);
+    switch (color) {
+      case SSD1306_WHITE:
+        cell |= mask;
+        break;
+      case SSD1306_BLACK:
+        cell &= ~mask;
+        break;
+      case SSD1306_INVERSE:
+        cell ^= mask;
+        break;
+    }
+  }
+
+  /**
+   * Fill the screen.
+   *
+   * @param color SSD1306_WHITE or SSD1306_BLACK.
+   */
+  void fillScreen(uint16_t color) override {
+    memset(_buffer, color == SSD1306_WHITE ? 0xFF : 0x00, BUFFER_SIZE);
+  }
+
+  /**
+   * Invert the screen colors, without touching the frame buffer.
+   *
+   * @param invert True to invert.
+   */
+  void invertDisplay(bool invert) override {
+    uint8_t command = invert ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY;
+    _commands(&command, 1);
+  }
+
+  /**
+   * Get frame buffer.
+   *
+   * @returns Frame buffer, W bytes per page.
+   */
+  uint8_t *getBuffer() {
+    return _buffer;
+  }
+
+  /**
+   * Get time to send the last frame.
+   *
+   * @returns Time in microseconds.
+   */
+  unsigned long getFrameTime() {
+    return _frameTime;
+  }
+};
+
+#endif
@@ -23,7 +23,26 @@ CFDisplayHelper::CFDisplayHelper(int width, int height, int addr) : _display(wid
                                                                           _height(height),
                                                                           _address(addr),
                                                                           _showLogo(true),
-                                                                          _logoTime(3000) {
+                                                                          _logoTime(3000),
+                                                                          _front(NULL),
+                                                                          _dirtyPages(0),
+                                                                          _flushBudget(0),
+                                                                          _pageTime(0),
+                                                                          _tFrame(0),
+                                                                          _frameTime(0),
+                                                                          _sliceTime(0),
+                                                                          _framesQty(0),
+                                                                          _pagesQty(0),
+                                                                          _tRate(0),
+                                                                          _rateFrames(0),
+                                                                          _frameRate(0) {
+}
+
+/**
+ * Destructor.
+ */
+CFDisplayHelper::~CFDisplayHelper() {
+  delete[] _front;
 }
 
 /**
@@ -32,7 +51,7 @@ CFDisplayHelper::CFDisplayHelper(int width, int height, int addr) : _display(wid
 void CFDisplayHelper::begin() {
   // SSD1306_SWITCHCAPVCC = generate display voltage from 3.3V internally.
   if (!_display.begin(SSD1306_SWITCHCAPVCC, _address)) {
-    Logger::fatal("SSD1306 allocation failed");
+    CF_LOG_FATAL("SSD1306 allocation failed");
     for (;;)
       ;  // Don't proceed, loop forever.
   }
@@ -54,11 +73,111 @@ void CFDisplayHelper::begin() {
   _display.setTextColor(WHITE);
 }
 
+/**
+ * Send pending pages within the budget.
+ * At least one page is sent per call, so the frame always progresses.
+ */
+void CFDisplayHelper::loop() {
+  if (_dirtyPages == 0) return;
+
+  CF_WATCHDOG_SECTION("display_flush");
+  unsigned long tStart = micros();
+  Wire.setClock(CF_DISPLAY_I2C_CLOCK);
+  do {
+    uint8_t page = __builtin_ctz(_dirtyPages);
+    unsigned long tPage = micros();
+    _sendPage(page);
+    _pageTime = micros() - tPage;
+    _dirtyPages &= ~(1 << page);
+    _pagesQty++;
+  } while (_dirtyPages != 0 && micros() - tStart + _pageTime <= _flushBudget);
+  Wire.setClock(CF_DISPLAY_I2C_CLOCK_IDLE);
+
+  unsigned long tEnd = micros();
+  if (_dirtyPages == 0) _frameDone(tEnd);
+  _slice(tStart, tEnd);
+}
+
 /**
  * Render display.
+ * With a flush budget, only the pages that changed are copied to the front buffer to be sent by
+ * loop(). Pages still waiting from the previous frame are sent with the new content.
  */
 void CFDisplayHelper::display() {
-  _display.display();
+  unsigned long tStart = micros();
+  if (!_front) {
+    CF_WATCHDOG_SECTION("display_flush");
+    _display.display();
+    unsigned long tEnd = micros();
+    _tFrame = tStart;
+    _pagesQty += _height / 8;
+    _frameDone(tEnd);
+    _slice(tStart, tEnd);
+    return;
+  }
+
+  uint8_t *back = _display.getBuffer();
+  uint8_t dirtyPages = 0;
+  for (uint8_t page = 0; page < _height / 8; page++) {
+    size_t offset = page * _width;
+    if (memcmp(back + offset, _front + offset, _width) != 0) {
+      memcpy(_front + offset, back + offset, _width);
+      dirtyPages |= 1 << page;
+    }
+  }
+  if (dirtyPages != 0 && _dirtyPages == 0) _tFrame = tStart;
+  _dirtyPages |= dirtyPages;
+  _slice(tStart, micros());
+}
+
+/**
+ * Send a page of the front buffer.
+ * Same addressing Adafruit_SSD1306::display() uses, narrowed to one page.
+ *
+ * @param page Page (8 rows).
+ */
+void CFDisplayHelper::_sendPage(uint8_t page) {
+  uint8_t column = _width == 64 ? 32 : 0;  // 64 pixels wide displays are centered in the controller RAM.
+  uint8_t commands[] = {SSD1306_PAGEADDR, page, page, SSD1306_COLUMNADDR, column, (uint8_t)(column + _width - 1)};
+  Wire.beginTransmission(_address);
+  Wire.write((uint8_t)0x00);  // Command stream.
+  Wire.write(commands, sizeof(commands));
+  Wire.endTransmission();
+
+  const uint8_t *data = _front + page * _width;
+  for (int sent = 0; sent < _width; sent += CF_DISPLAY_I2C_CHUNK) {
+    Wire.beginTransmission(_address);
+    Wire.write((uint8_t)0x40);  // Data stream.
+    Wire.write(data + sent, min(CF_DISPLAY_I2C_CHUNK, _width - sent));
+    Wire.endTransmission();
+  }
+}
+
+/**
+ * Update frame metrics.
+ *
+ * @param tEnd Time the frame was on the screen (us).
+ */
+void CFDisplayHelper::_frameDone(unsigned long tEnd) {
+  _frameTime = tEnd - _tFrame;
+  _framesQty++;
+
+  unsigned long now = millis();
+  if (now - _tRate >= 1000) {
+    _frameRate = (_framesQty - _rateFrames) * 1000 / (now - _tRate);
+    _tRate = now;
+    _rateFrames = _framesQty;
+  }
+}
+
+/**
+ * Update call time metrics.
+ *
+ * @param tStart Time the call started (us).
+ * @param tEnd Time the call finished (us).
+ */
+void CFDisplayHelper::_slice(unsigned long tStart, unsigned long tEnd) {
+  if (tEnd - tStart > _sliceTime) _sliceTime = tEnd - tStart;
 }
 
 /**
@@ -99,4 +218,90 @@ void CFDisplayHelper::print(String text) {
  */
 void CFDisplayHelper::drawBitmap(int x, int y, const unsigned char bmap[], int w, int h, int color) {
   _display.drawBitmap(x, y, bmap, w, h, color);
+}
+
+/**
+ * Set max time sending pages in a loop.
+ * Must be called after begin(). The front buffer is allocated on the first call and the next
+ * loop() sends the whole frame.
+ *
+ * @param budget Time in microseconds, 0 to send the frame at once in display().
+ * @returns True if it was set, false if there is no memory for the front buffer.
+ */
+bool CFDisplayHelper::setFlushBudget(unsigned long budget) {
+  if (budget == 0) {
+    delete[] _front;
+    _front = NULL;
+    _dirtyPages = 0;
+    _flushBudget = 0;
+    return true;
+  }
+
+  if (!_front) {
+    if (!_display.getBuffer()) return false;
+    _front = new (std::nothrow) uint8_t[_width * (_height / 8)];
+    if (!_front) {
+      CF_LOG_WARNING("No memory for the display front buffer. Sending frames at once.");
+      return false;
+    }
+    memcpy(_front, _display.getBuffer(), _width * (_height / 8));
+    _dirtyPages = (1 << (_height / 8)) - 1;
+    _tFrame = micros();
+  }
+  _flushBudget = budget;
+  return true;
+}
+
+/**
+ * True if a frame is being sent.
+ *
+ * @returns True if there are pages waiting for loop().
+ */
+bool CFDisplayHelper::isFlushing() {
+  return _dirtyPages != 0;
+}
+
+/**
+ * Get time from render to screen.
+ *
+ * @returns Time in microseconds of the last frame.
+ */
+unsigned long CFDisplayHelper::getFrameTime() {
+  return _frameTime;
+}
+
+/**
+ * Get frames per second.
+ *
+ * @returns Frames sent per second, updated every second while frames are sent.
+ */
+unsigned long CFDisplayHelper::getFrameRate() {
+  return _frameRate;
+}
+
+/**
+ * Get longest time in a display or loop call.
+ *
+ * @returns Time in microseconds since boot.
+ */
+unsigned long CFDisplayHelper::getSliceTime() {
+  return _sliceTime;
+}
+
+/**
+ * Get frames sent.
+ *
+ * @returns Frames since boot.
+ */
+unsigned long CFDisplayHelper::getFramesQty() {
+  return _framesQty;
+}
+
+/**
+ * Get pages sent.
+ *
+ * @returns Pages since boot.
+ */
+unsigned long CFDisplayHelper::getPagesQty() {
+  return _pagesQty;
 }
\ No newline at end of file
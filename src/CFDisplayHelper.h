@@ -3,6 +3,11 @@
  *
  * A library for Arduino that helps to print display for CF IoT devices.
  *
+ * By default display() sends the whole frame at once, which holds the loop while the I2C transfer
+ * runs (about 25 ms for 128x64 at 400 kHz). With a flush budget, display() only copies the changed
+ * pages to a front buffer and loop() sends them a page at a time, never longer than the budget
+ * (at least one page per call). The sketch can keep drawing while a frame is being sent.
+ *
  * @author  Caio Frota <caiofrota@gmail.com>
  * @version 1.0
  * @since   Sep, 2021
@@ -14,9 +19,23 @@
 #include <Adafruit_GFX.h>      // Adafruit GFX.
 #include <Adafruit_SSD1306.h>  // Adafruit display.
 #include <Arduino.h>           // Arduino library.
-#include <Logger.h>            // Logger.
+#include <CFLog.h>             // CF Log.
+#include <CFWatchdog.h>        // CF Watchdog.
+#include <new>                 // Non-throwing new.
 #include <Wire.h>              // Wire.
 
+#ifndef CF_DISPLAY_I2C_CHUNK
+#define CF_DISPLAY_I2C_CHUNK 31  // Data bytes per I2C transmission (Wire buffer minus the control byte).
+#endif
+
+#ifndef CF_DISPLAY_I2C_CLOCK
+#define CF_DISPLAY_I2C_CLOCK 400000  // Bus clock while a page is sent.
+#endif
+
+#ifndef CF_DISPLAY_I2C_CLOCK_IDLE
+#define CF_DISPLAY_I2C_CLOCK_IDLE 100000  // Bus clock restored for the other devices.
+#endif
+
 class CFDisplayHelper {
  private:
   // Display attributes.
@@ -27,15 +46,45 @@ class CFDisplayHelper {
   bool _showLogo;             // Flag that indicates if it's to show the logo.
   unsigned long _logoTime;    // Time that will show the logo.
 
+  // Flush.
+  uint8_t *_front;             // Frame being sent, only with a flush budget.
+  uint8_t _dirtyPages;         // Pages of the front buffer still to be sent (bit per page).
+  unsigned long _flushBudget;  // Max time sending pages in a loop (us), 0 to send the frame at once.
+  unsigned long _pageTime;     // Time to send the last page (us).
+  unsigned long _tFrame;       // Time the frame being sent was rendered (us).
+
+  // Metrics.
+  unsigned long _frameTime;   // Time from render to the last frame on the screen (us).
+  unsigned long _sliceTime;   // Longest time in a display or loop call (us).
+  unsigned long _framesQty;   // Frames sent.
+  unsigned long _pagesQty;    // Pages sent.
+  unsigned long _tRate;       // Time the frame rate window started.
+  unsigned long _rateFrames;  // Frames sent when the frame rate window started.
+  unsigned long _frameRate;   // Frames per second in the last window.
+
+  // Methods.
+  void _sendPage(uint8_t page);                           // Send a page of the front buffer.
+  void _frameDone(unsigned long tEnd);                    // Update frame metrics.
+  void _slice(unsigned long tStart, unsigned long tEnd);  // Update call time metrics.
+
  public:
   CFDisplayHelper(int width, int height, int addr);          // Constructor.
+  ~CFDisplayHelper();                                        // Destructor.
   void begin();                                              // Initialize.
+  void loop();                                               // Send pending pages within the budget.
   void display();                                            // Render display.
   void clearDisplay();                                       // Clear display.
   void setCursor(int col, int lin);                          // Set cursor position.
   void print(String text);                                   // Print what should be rendered.
   void drawBitmap(int x, int y, const unsigned char bmap[],  // Draw bitmap.
                   int w, int h, int color);
+  bool setFlushBudget(unsigned long budget);                 // Set max time sending pages in a loop.
+  bool isFlushing();                                         // True if a frame is being sent.
+  unsigned long getFrameTime();                              // Get time from render to screen.
+  unsigned long getFrameRate();                              // Get frames per second.
+  unsigned long getSliceTime();                              // Get longest time in a display or loop call.
+  unsigned long getFramesQty();                              // Get frames sent.
+  unsigned long getPagesQty();                               // Get pages sent.
 };
 
-#endif
\ No newline at end of file
+#endif
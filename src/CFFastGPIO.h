@@ -0,0 +1,178 @@
+/**
+ * CFFastGPIO.h
+ *
+ * Direct register GPIO access for CF Arduino Devices.
+ *
+ * digitalRead and digitalWrite look the pin up and check its mode on every call, which costs about
+ * 1 us each on ESP8266. Here a read or write is a single access to the GPIO registers:
+ *    - CFFastGPIO: pin given at run time, as the helpers get it. The register bit is found once.
+ *    - CFFastPin<PIN>: pin known at compile time, the access is inlined to a single instruction.
+ * GPIO 16 has its own registers and is handled too. Pin modes are set once through pinMode.
+ *
+ * Out of ESP8266 (e.g. host builds with a simulated Arduino core) both fall back to digitalRead and
+ * digitalWrite, so the simulated port keeps working.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFFastGPIO_h
+#define CFFastGPIO_h
+
+#include <Arduino.h>  // Arduino library.
+
+class CFFastGPIO {
+ private:
+  int _pin;        // Pin, -1 if there is none.
+  uint32_t _mask;  // Pin bit in the GPIO registers, 0 for GPIO 16 or none.
+  bool _gpio16;    // Flag that indicates the pin is GPIO 16, which has its own registers.
+
+ public:
+  /**
+   * Constructor.
+   *
+   * @param pin Pin, -1 if there is none. Pins out of GPIO 0 to 16 are taken as none.
+   */
+  CFFastGPIO(int pin) : _pin(pin >= 0 && pin <= 16 ? pin : -1),
+                        _mask(pin >= 0 && pin < 16 ? 1UL << pin : 0),
+                        _gpio16(pin == 16) {
+  }
+
+  /**
+   * Set pin mode.
+   *
+   * @param mode INPUT, INPUT_PULLUP or OUTPUT.
+   */
+  void setMode(uint8_t mode) {
+    if (_pin >= 0) pinMode(_pin, mode);
+  }
+
+  /**
+   * Read the pin.
+   *
+   * @returns True if it's HIGH, false if there is no pin.
+   */
+  bool read() {
+    if (_pin < 0) return false;
+#if defined(ESP8266)
+    return _gpio16 ? (GP16I & 0x01) != 0 : (GPI & _mask) != 0;
+#else
+    return digitalRead(_pin) == HIGH;
+#endif
+  }
+
+  /**
+   * Write the pin, nothing is done if there is no pin.
+   *
+   * @param level True for HIGH.
+   */
+  void write(bool level) {
+    if (_pin < 0) return;
+#if defined(ESP8266)
+    if (_gpio16) {
+      GP16O = level;
+    } else if (level) {
+      GPOS = _mask;
+    } else {
+      GPOC = _mask;
+    }
+#else
+    digitalWrite(_pin, level ? HIGH : LOW);
+#endif
+  }
+
+  /**
+   * Get the pin bit in the GPIO registers, to write many pins at once with writeMasks().
+   *
+   * @returns Pin bit, 0 for GPIO 16 or if there is no pin.
+   */
+  uint32_t getMask() {
+    return _mask;
+  }
+
+  /**
+   * Write many of GPIO 0 to 15 at once.
+   *
+   * @param high Bits of the pins to be set HIGH.
+   * @param low Bits of the pins to be set LOW.
+   */
+  static void writeMasks(uint32_t high, uint32_t low) {
+#if defined(ESP8266)
+    GPOS = high;
+    GPOC = low;
+#else
+    for (uint8_t pin = 0; pin < 16; pin++) {
+      if (high & (1UL << pin)) digitalWrite(pin, HIGH);
+      if (low & (1UL << pin)) digitalWrite(pin, LOW);
+    }
+#endif
+  }
+
+  /**
+   * True if there is a pin.
+   *
+   * @returns True if the pin isn't -1.
+   */
+  bool isValid() {
+    return _pin >= 0;
+  }
+
+  /**
+   * Get the pin.
+   *
+   * @returns Pin, -1 if there is none.
+   */
+  int getPin() {
+    return _pin;
+  }
+};
+
+template <uint8_t PIN>
+class CFFastPin {
+  static_assert(PIN <= 16, "ESP8266 has GPIO 0 to 16.");
+
+ public:
+  /**
+   * Set pin mode.
+   *
+   * @param mode INPUT, INPUT_PULLUP or OUTPUT.
+   */
+  static void setMode(uint8_t mode) {
+    pinMode(PIN, mode);
+  }
+
+  /**
+   * Read the pin.
+   *
+   * @returns True if it's HIGH.
+   */
+  static bool read() {
+#if defined(ESP8266)
+    return PIN == 16 ? (GP16I & 0x01) != 0 : (GPI & (1UL << PIN)) != 0;
+#else
+    return digitalRead(PIN) == HIGH;
+#endif
+  }
+
+  /**
+   * Write the pin.
+   *
+   * @param level True for HIGH.
+   */
+  static void write(bool level) {
+#if defined(ESP8266)
+    if (PIN == 16) {
+      GP16O = level;
+    } else if (level) {
+      GPOS = 1UL << PIN;
+    } else {
+      GPOC = 1UL << PIN;
+    }
+#else
+    digitalWrite(PIN, level ? HIGH : LOW);
+#endif
+  }
+};
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * CFHeatIndex.cpp
+ *
+ * Fixed point heat index and unit conversion for CF Arduino Devices.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFHeatIndex.h>  // CF Heat Index.
+
+/**
+ * Round a division to the nearest integer, half away from zero.
+ */
+static int64_t roundDiv(int64_t value, int64_t divisor) {
+  return value >= 0 ? (value + divisor / 2) / divisor : (value - divisor / 2) / divisor;
+}
+
+/**
+ * Convert tenths of C to tenths of F.
+ *
+ * @param temperatureC Temperature in tenths of C.
+ * @returns Temperature in tenths of F.
+ */
+int16_t CFHeatIndex::celsiusToFahrenheit(int16_t temperatureC) {
+  return roundDiv((int32_t)temperatureC * 9, 5) + 320;
+}
+
+/**
+ * Convert tenths of F to tenths of C.
+ *
+ * @param temperatureF Temperature in tenths of F.
+ * @returns Temperature in tenths of C.
+ */
+int16_t CFHeatIndex::fahrenheitToCelsius(int16_t temperatureF) {
+  return roundDiv(((int32_t)temperatureF - 320) * 5, 9);
+}
+
+/**
+ * Compute heat index in tenths of C and F.
+ *
+ * @param temperatureC Temperature in tenths of C.
+ * @param humidity Humidity in tenths of %.
+ * @param heatIndexC Heat index in tenths of C.
+ * @param heatIndexF Heat index in tenths of F.
+ */
+void CFHeatIndex::compute(int16_t temperatureC, int16_t humidity, int16_t &heatIndexC, int16_t &heatIndexF) {
+  // Hundredths of F are exact for tenths of C.
+  int64_t heatIndex = _computeF((int32_t)temperatureC * 18 + 3200, humidity);
+  heatIndexF = roundDiv(heatIndex, 10000000LL);
+  heatIndexC = roundDiv((heatIndex - 3200000000LL) * 55555 / 100000, 10000000LL);  // Same factor as the DHT library.
+}
+
+/**
+ * Heat index in F.
+ *
+ * @param temperatureF Temperature in hundredths of F.
+ * @param humidity Humidity in tenths of %.
+ * @returns Heat index in 1e-8 F.
+ */
+int64_t CFHeatIndex::_computeF(int32_t temperatureF, int32_t humidity) {
+  int64_t t = temperatureF;
+  int64_t h = humidity;
+
+  // Simple formula: 1.1 * T - 10.3 + 0.047 * RH.
+  int64_t heatIndex = (110 * t - 103000 + 47 * h) * 10000;
+  if (heatIndex <= 7900000000LL) return heatIndex;
+
+  // Rothfusz regression, coefficients in 1e-8.
+  heatIndex = -4237900000LL +
+              204901523LL * t / 100 +
+              1014333127LL * h / 10 -
+              22475541LL * t * h / 1000 -
+              683783LL * t * t / 10000 -
+              5481717LL * h * h / 100 +
+              122874LL * t * t * h / 100000 +
+              85282LL * t * h * h / 10000 -
+              199LL * t * t * h * h / 1000000;
+
+  if (h < 130 && t >= 8000 && t <= 11200) {
+    // Low humidity adjustment: ((13 - RH) * 0.25) * sqrt((17 - |T - 95|) * 0.05882).
+    int64_t distance = 1700 - (t > 9500 ? t - 9500 : 9500 - t);
+    int64_t root = _sqrt(distance * 5882 * 100000);  // sqrt in 1e-6.
+    heatIndex -= (130 - h) * 25 * root / 10;
+  } else if (h > 850 && t >= 8000 && t <= 8700) {
+    // High humidity adjustment: ((RH - 85) * 0.1) * ((87 - T) * 0.2).
+    heatIndex += (h - 850) * (8700 - t) * 2000;
+  }
+  return heatIndex;
+}
+
+/**
+ * Integer square root.
+ *
+ * @param value Value.
+ * @returns Floor of the square root.
+ */
+uint32_t CFHeatIndex::_sqrt(uint64_t value) {
+  uint64_t root = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > value) bit >>= 2;
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
@@ -0,0 +1,35 @@
+/**
+ * CFHeatIndex.h
+ *
+ * Fixed point heat index and unit conversion for CF Arduino Devices.
+ *
+ * ESP8266 has no floating point unit, so temperatures and humidity are handled in tenths, which is
+ * the DHT resolution. The heat index uses the same Rothfusz regression and adjustments as the DHT
+ * library, computed in 64-bit integers.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFHeatIndex_h
+#define CFHeatIndex_h
+
+#include <Arduino.h>  // Arduino library.
+
+class CFHeatIndex {
+ private:
+  // Methods.
+  static uint32_t _sqrt(uint64_t value);           // Integer square root.
+  static int64_t _computeF(int32_t temperatureF,   // Heat index in F (1e-8).
+                           int32_t humidity);
+
+ public:
+  // Methods.
+  static int16_t celsiusToFahrenheit(int16_t temperatureC);  // Convert tenths of C to tenths of F.
+  static int16_t fahrenheitToCelsius(int16_t temperatureF);  // Convert tenths of F to tenths of C.
+  static void compute(int16_t temperatureC, int16_t humidity,  // Compute heat index in tenths of C and F.
+                      int16_t &heatIndexC, int16_t &heatIndexF);
+};
+
+#endif
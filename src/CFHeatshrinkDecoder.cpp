@@ -0,0 +1,145 @@
+/**
+ * CFHeatshrinkDecoder.cpp
+ *
+ * A streaming decoder for heatshrink (LZSS) compressed data.
+ *
+ * Stream format, read MSB first: a tag bit 1 followed by a literal byte, or a tag bit 0 followed by
+ * a back-reference of windowBits bits (offset - 1) and lookaheadBits bits (length - 1). The last
+ * byte is padded with 0 bits, which are left unread.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFHeatshrinkDecoder.h>  // CF Heatshrink Decoder.
+
+/**
+ * Constructor.
+ *
+ * @param windowBits Window bits used to compress (4 to 15).
+ * @param lookaheadBits Lookahead bits used to compress (3 to windowBits - 1).
+ */
+CFHeatshrinkDecoder::CFHeatshrinkDecoder(uint8_t windowBits, uint8_t lookaheadBits) : _windowBits(windowBits),
+                                                                                      _lookaheadBits(lookaheadBits),
+                                                                                      _window(NULL) {
+  if (windowBits >= 4 && windowBits <= 15 && lookaheadBits >= 3 && lookaheadBits < windowBits) {
+    _window = new (std::nothrow) uint8_t[1 << windowBits];
+  }
+  reset();
+}
+
+/**
+ * Destructor.
+ */
+CFHeatshrinkDecoder::~CFHeatshrinkDecoder() {
+  delete[] _window;
+}
+
+/**
+ * Reset to decode a new stream.
+ */
+void CFHeatshrinkDecoder::reset() {
+  if (_window) memset(_window, 0, 1 << _windowBits);
+  _head = 0;
+  _state = TAG;
+  _index = 0;
+  _count = 0;
+  _input = 0;
+  _inputMask = 0;
+  _bits = 0;
+  _bitsQty = 0;
+}
+
+/**
+ * Read a field of the stream. Bits read are kept while the input runs out.
+ *
+ * @param qty Field bits quantity.
+ * @param input Input, advanced as bytes are consumed.
+ * @param length Input length, decreased as bytes are consumed.
+ * @param value Field value, when it's complete.
+ * @returns True if the field is complete.
+ */
+bool CFHeatshrinkDecoder::_readBits(uint8_t qty, const uint8_t *&input, size_t &length, uint16_t &value) {
+  while (_bitsQty < qty) {
+    if (_inputMask == 0) {
+      if (length == 0) return false;
+      _input = *input++;
+      length--;
+      _inputMask = 0x80;
+    }
+    _bits = (_bits << 1) | ((_input & _inputMask) ? 1 : 0);
+    _inputMask >>= 1;
+    _bitsQty++;
+  }
+  value = _bits;
+  _bits = 0;
+  _bitsQty = 0;
+  return true;
+}
+
+/**
+ * Add a byte to the window.
+ *
+ * @param value Byte.
+ * @returns The same byte.
+ */
+uint8_t CFHeatshrinkDecoder::_push(uint8_t value) {
+  _window[_head++ & ((1 << _windowBits) - 1)] = value;
+  return value;
+}
+
+/**
+ * Decode a chunk.
+ * Stops when the output is full or the input runs out, whatever comes first, and continues from
+ * there on the next call. A result smaller than the output size means all the input was consumed.
+ *
+ * @param input Compressed input, advanced as bytes are consumed.
+ * @param length Input length, decreased as bytes are consumed.
+ * @param output Buffer where decompressed bytes are written.
+ * @param size Output buffer size.
+ * @returns Bytes written to the output.
+ */
+size_t CFHeatshrinkDecoder::decode(const uint8_t *&input, size_t &length, uint8_t *output, size_t size) {
+  if (!_window) return 0;
+
+  size_t produced = 0;
+  uint16_t value;
+  while (produced < size) {
+    switch (_state) {
+      case TAG:
+        if (!_readBits(1, input, length, value)) return produced;
+        _state = value ? LITERAL : INDEX;
+        break;
+      case LITERAL:
+        if (!_readBits(8, input, length, value)) return produced;
+        output[produced++] = _push(value);
+        _state = TAG;
+        break;
+      case INDEX:
+        if (!_readBits(_windowBits, input, length, value)) return produced;
+        _index = value + 1;
+        _state = COUNT;
+        break;
+      case COUNT:
+        if (!_readBits(_lookaheadBits, input, length, value)) return produced;
+        _count = value + 1;
+        _state = BACKREF;
+        break;
+      case BACKREF:
+        output[produced++] = _push(_window[(uint16_t)(_head - _index) & ((1 << _windowBits) - 1)]);
+        if (--_count == 0) _state = TAG;
+        break;
+    }
+  }
+  return produced;
+}
+
+/**
+ * True if the window was allocated.
+ *
+ * @returns True if it's able to decode.
+ */
+bool CFHeatshrinkDecoder::isValid() {
+  return _window != NULL;
+}
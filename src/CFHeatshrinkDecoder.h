@@ -0,0 +1,67 @@
+/**
+ * CFHeatshrinkDecoder.h
+ *
+ * A streaming decoder for heatshrink (LZSS) compressed data.
+ *
+ * Input can be fed in chunks of any size and output is produced into a buffer of any size, the
+ * state is kept between calls. The only RAM it needs is the window, 2^windowBits bytes. It doesn't
+ * depend on Arduino, so it can be built and tested on the host.
+ *
+ * Data must be compressed with the same window and lookahead bits, e.g. with the heatshrink CLI:
+ *
+ *    heatshrink -e -w 11 -l 4 firmware.bin firmware.bin.hs
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFHeatshrinkDecoder_h
+#define CFHeatshrinkDecoder_h
+
+#include <new>       // Non-throwing new.
+#include <stddef.h>  // Standard definitions.
+#include <stdint.h>  // Standard integers.
+#include <string.h>  // Memory functions.
+
+class CFHeatshrinkDecoder {
+ private:
+  // States.
+  enum State : uint8_t {
+    TAG,      // Reading the tag bit.
+    LITERAL,  // Reading a literal byte.
+    INDEX,    // Reading a back-reference offset.
+    COUNT,    // Reading a back-reference length.
+    BACKREF   // Copying a back-reference.
+  };
+
+  // Window.
+  uint8_t _windowBits;     // Window size (2^windowBits bytes).
+  uint8_t _lookaheadBits;  // Max back-reference length (2^lookaheadBits bytes).
+  uint8_t *_window;        // Last bytes produced.
+  uint16_t _head;          // Position of the next byte in the window.
+
+  // Decoding.
+  State _state;     // Current state.
+  uint16_t _index;  // Back-reference offset.
+  uint16_t _count;  // Back-reference bytes left to copy.
+
+  // Bit reader.
+  uint8_t _input;      // Current input byte.
+  uint8_t _inputMask;  // Next bit of the current input byte, 0 when it's consumed.
+  uint16_t _bits;      // Bits read of the current field.
+  uint8_t _bitsQty;    // Bits quantity read of the current field.
+
+  // Methods.
+  bool _readBits(uint8_t qty, const uint8_t *&input, size_t &length, uint16_t &value);  // Read a field.
+  uint8_t _push(uint8_t value);                                                         // Add a byte to the window.
+
+ public:
+  CFHeatshrinkDecoder(uint8_t windowBits, uint8_t lookaheadBits);                      // Constructor.
+  ~CFHeatshrinkDecoder();                                                              // Destructor.
+  void reset();                                                                        // Reset to decode a new stream.
+  size_t decode(const uint8_t *&input, size_t &length, uint8_t *output, size_t size);  // Decode a chunk.
+  bool isValid();                                                                      // True if the window was allocated.
+};
+
+#endif
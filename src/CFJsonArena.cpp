@@ -0,0 +1,219 @@
+/**
+ * CFJsonArena.cpp
+ *
+ * A shared scratch region for the JSON documents that only live while something is built, parsed
+ * or sent.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFJsonArena.h>  // CF JSON Arena.
+
+#define CF_JSON_ARENA_NO_OWNER 0xFF  // Owner index when there is no room for a new owner.
+
+uint8_t CFJsonArena::_region[CF_JSON_ARENA_SIZE] __attribute__((aligned(8)));
+uint16_t CFJsonArena::_blocks[CF_JSON_ARENA_MAX_BLOCKS];
+uint8_t CFJsonArena::_blocksQty = 0;
+size_t CFJsonArena::_top = 0;
+size_t CFJsonArena::_peak = 0;
+unsigned long CFJsonArena::_fallbacksQty = 0;
+CFJsonArena::Owner CFJsonArena::_owners[CF_JSON_ARENA_MAX_OWNERS];
+uint8_t CFJsonArena::_ownersQty = 0;
+
+/**
+ * Take memory for a document.
+ * It comes from the region while it has room, from the heap otherwise.
+ *
+ * @param size Size.
+ * @param owner Owner name. It must live as long as the arena does.
+ * @returns Memory or NULL if there is none.
+ */
+void *CFJsonArena::allocate(size_t size, const char *owner) {
+  uint8_t index = _owner(owner);
+  size_t total = sizeof(Header) + _align(size);
+  Header *header;
+  if (_blocksQty < CF_JSON_ARENA_MAX_BLOCKS && _top + total <= CF_JSON_ARENA_SIZE) {
+    header = (Header *)(_region + _top);
+    header->heap = false;
+    _blocks[_blocksQty++] = _top;
+    _top += total;
+    if (_top > _peak) _peak = _top;
+  } else {
+    header = (Header *)malloc(total);
+    if (!header) return NULL;
+    header->heap = true;
+    if (_fallbacksQty++ == 0) {
+      CF_LOG_WARNING("JSON arena is full, documents go to the heap. Increase CF_JSON_ARENA_SIZE.");
+    }
+    if (index != CF_JSON_ARENA_NO_OWNER) _owners[index].fallbacksQty++;
+  }
+  header->size = size;
+  header->owner = index;
+  header->freed = false;
+
+  if (index != CF_JSON_ARENA_NO_OWNER) {
+    _owners[index].used += size;
+    if (_owners[index].used > _owners[index].peak) _owners[index].peak = _owners[index].used;
+  }
+  return header + 1;
+}
+
+/**
+ * Resize the memory of a document.
+ * The block on top of the region is resized in place, the others are moved.
+ *
+ * @param ptr Memory.
+ * @param size New size.
+ * @param owner Owner name.
+ * @returns Memory or NULL if there is none, the old memory is kept then.
+ */
+void *CFJsonArena::reallocate(void *ptr, size_t size, const char *owner) {
+  if (!ptr) return allocate(size, owner);
+
+  Header *header = _header(ptr);
+  if (!header->heap && (uint8_t *)header == _region + _blocks[_blocksQty - 1] &&
+      _blocks[_blocksQty - 1] + sizeof(Header) + _align(size) <= CF_JSON_ARENA_SIZE) {
+    if (header->owner != CF_JSON_ARENA_NO_OWNER) {
+      Owner &o = _owners[header->owner];
+      o.used = o.used - header->size + size;
+      if (o.used > o.peak) o.peak = o.used;
+    }
+    header->size = size;
+    _top = _blocks[_blocksQty - 1] + sizeof(Header) + _align(size);
+    if (_top > _peak) _peak = _top;
+    return ptr;
+  }
+
+  void *moved = allocate(size, owner);
+  if (!moved) return NULL;
+  memcpy(moved, ptr, min(size, (size_t)header->size));
+  release(ptr);
+  return moved;
+}
+
+/**
+ * Give the memory of a document back.
+ * Region blocks are reclaimed once every block after them is released too.
+ *
+ * @param ptr Memory.
+ */
+void CFJsonArena::release(void *ptr) {
+  if (!ptr) return;
+
+  Header *header = _header(ptr);
+  if (header->owner != CF_JSON_ARENA_NO_OWNER) _owners[header->owner].used -= header->size;
+  if (header->heap) {
+    free(header);
+    return;
+  }
+
+  header->freed = true;
+  while (_blocksQty > 0 && ((Header *)(_region + _blocks[_blocksQty - 1]))->freed) {
+    _top = _blocks[--_blocksQty];
+  }
+}
+
+/**
+ * Add JSON memory a helper holds for its whole life.
+ *
+ * @param owner Owner name. It must live as long as the arena does.
+ * @param size Size.
+ */
+void CFJsonArena::addFixed(const char *owner, size_t size) {
+  uint8_t index = _owner(owner);
+  if (index != CF_JSON_ARENA_NO_OWNER) _owners[index].fixed += size;
+}
+
+/**
+ * Get the owner index, adding it if it's new.
+ *
+ * @param name Owner name.
+ * @returns Owner index or CF_JSON_ARENA_NO_OWNER if there is no room for it.
+ */
+uint8_t CFJsonArena::_owner(const char *name) {
+  for (uint8_t i = 0; i < _ownersQty; i++) {
+    if (_owners[i].name == name || strcmp(_owners[i].name, name) == 0) return i;
+  }
+  if (_ownersQty >= CF_JSON_ARENA_MAX_OWNERS) return CF_JSON_ARENA_NO_OWNER;
+
+  _owners[_ownersQty] = {name, 0, 0, 0, 0};
+  return _ownersQty++;
+}
+
+/**
+ * Round a size up to the block alignment.
+ *
+ * @param size Size.
+ * @returns Size multiple of 8.
+ */
+size_t CFJsonArena::_align(size_t size) {
+  return (size + 7) & ~(size_t)7;
+}
+
+/**
+ * Get the header of a block.
+ *
+ * @param ptr Memory of the block.
+ * @returns Header.
+ */
+CFJsonArena::Header *CFJsonArena::_header(void *ptr) {
+  return (Header *)ptr - 1;
+}
+
+/**
+ * Get region memory in use.
+ *
+ * @returns Bytes, headers included.
+ */
+size_t CFJsonArena::getUsed() {
+  return _top;
+}
+
+/**
+ * Get region peak.
+ *
+ * @returns Bytes since boot, headers included.
+ */
+size_t CFJsonArena::getPeak() {
+  return _peak;
+}
+
+/**
+ * Get documents that went to the heap.
+ *
+ * @returns Documents since boot.
+ */
+unsigned long CFJsonArena::getFallbacksQty() {
+  return _fallbacksQty;
+}
+
+/**
+ * Get the memory budget.
+ *
+ * @param report Object where the report is written.
+ */
+void CFJsonArena::getReport(JsonObject report) {
+  report["json_arena_size"] = CF_JSON_ARENA_SIZE;
+  report["json_arena_peak"] = _peak;
+  report["json_arena_fallbacks_qty"] = _fallbacksQty;
+  JsonObject budget = report.createNestedObject("json_budget");
+  for (uint8_t i = 0; i < _ownersQty; i++) {
+    JsonObject owner = budget.createNestedObject(_owners[i].name);
+    owner["fixed"] = _owners[i].fixed;
+    owner["peak"] = _owners[i].peak;
+    owner["fallbacks_qty"] = _owners[i].fallbacksQty;
+  }
+}
+
+/**
+ * Log the memory budget.
+ * Called at the end of setup() it tells what each helper needs to boot.
+ */
+void CFJsonArena::logReport() {
+  CF_LOG_NOTICE("JSON arena peak: %u of %u bytes. Documents on the heap: %lu.", _peak, CF_JSON_ARENA_SIZE, _fallbacksQty);
+  for (uint8_t i = 0; i < _ownersQty; i++) {
+    CF_LOG_NOTICE("JSON memory of %s: %u bytes fixed, %u bytes scratch peak.", _owners[i].name, _owners[i].fixed, _owners[i].peak);
+  }
+}
@@ -0,0 +1,103 @@
+/**
+ * CFJsonArena.h
+ *
+ * A shared scratch region for the JSON documents that only live while something is built, parsed
+ * or sent, instead of each one taking its own heap block or stack space.
+ *
+ * Scratch documents are CFJsonScratch, a DynamicJsonDocument that takes its memory from the arena.
+ * Their lifetime is their scope: the memory is taken when the document is created and given back
+ * when it goes out of scope. Memory is handed out as a stack, so a document only returns its space
+ * once the ones created after it are gone too, which is always the case for scoped documents.
+ *
+ *    CFJsonScratch doc(1024, CFJsonArenaAllocator("wifimanager"));
+ *
+ * When the arena is full the document falls back to the heap and it's counted, so the report tells
+ * if CF_JSON_ARENA_SIZE is too small. The report also shows the fixed JSON memory each helper holds
+ * for its whole life, added with addFixed(), and the scratch peak of each one.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFJsonArena_h
+#define CFJsonArena_h
+
+#include <Arduino.h>      // Arduino library.
+#include <ArduinoJson.h>  // Arduino JSON.
+#include <CFLog.h>        // CF Log.
+
+#ifndef CF_JSON_ARENA_SIZE
+#define CF_JSON_ARENA_SIZE 2048  // Scratch region size.
+#endif
+
+#ifndef CF_JSON_ARENA_MAX_BLOCKS
+#define CF_JSON_ARENA_MAX_BLOCKS 8  // Max documents alive in the region at once.
+#endif
+
+#ifndef CF_JSON_ARENA_MAX_OWNERS
+#define CF_JSON_ARENA_MAX_OWNERS 8  // Max owners in the report.
+#endif
+
+class CFJsonArena {
+ private:
+  // Block header, placed before the memory of each document.
+  struct Header {
+    uint32_t size;  // Size asked for.
+    uint8_t owner;  // Owner index.
+    bool heap;      // Flag that indicates it's out of the region.
+    bool freed;     // Flag that indicates it was released but isn't on top of the region yet.
+  };
+
+  // Owner of scratch and fixed memory.
+  struct Owner {
+    const char *name;            // Name.
+    size_t fixed;                // JSON memory held for its whole life.
+    size_t used;                 // Scratch memory in use.
+    size_t peak;                 // Scratch memory peak.
+    unsigned long fallbacksQty;  // Documents that went to the heap.
+  };
+
+  // Region.
+  static uint8_t _region[CF_JSON_ARENA_SIZE];         // Scratch region.
+  static uint16_t _blocks[CF_JSON_ARENA_MAX_BLOCKS];  // Offset of each block in the region, as a stack.
+  static uint8_t _blocksQty;                          // Blocks in the region.
+  static size_t _top;                                 // Offset of the free space.
+  static size_t _peak;                                // Region peak.
+  static unsigned long _fallbacksQty;                 // Documents that went to the heap.
+
+  // Owners.
+  static Owner _owners[CF_JSON_ARENA_MAX_OWNERS];  // Owners.
+  static uint8_t _ownersQty;                       // Owners quantity.
+
+  // Methods.
+  static uint8_t _owner(const char *name);  // Get the owner index, adding it if it's new.
+  static size_t _align(size_t size);        // Round a size up to the block alignment.
+  static Header *_header(void *ptr);        // Get the header of a block.
+
+ public:
+  static void *allocate(size_t size, const char *owner);               // Take memory for a document.
+  static void *reallocate(void *ptr, size_t size, const char *owner);  // Resize the memory of a document.
+  static void release(void *ptr);                                      // Give the memory of a document back.
+  static void addFixed(const char *owner, size_t size);                // Add JSON memory a helper holds for its whole life.
+  static size_t getUsed();                                             // Get region memory in use.
+  static size_t getPeak();                                             // Get region peak.
+  static unsigned long getFallbacksQty();                              // Get documents that went to the heap.
+  static void getReport(JsonObject report);                            // Get the memory budget.
+  static void logReport();                                             // Log the memory budget.
+};
+
+class CFJsonArenaAllocator {
+ private:
+  const char *_owner;  // Owner name.
+
+ public:
+  CFJsonArenaAllocator(const char *owner = "other") : _owner(owner) {}                             // Constructor.
+  void *allocate(size_t size) { return CFJsonArena::allocate(size, _owner); }                      // Take memory.
+  void deallocate(void *ptr) { CFJsonArena::release(ptr); }                                        // Give memory back.
+  void *reallocate(void *ptr, size_t size) { return CFJsonArena::reallocate(ptr, size, _owner); }  // Resize memory.
+};
+
+using CFJsonScratch = BasicJsonDocument<CFJsonArenaAllocator>;  // Scratch JSON document.
+
+#endif
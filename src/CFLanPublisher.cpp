@@ -0,0 +1,133 @@
+/**
+ * CFLanPublisher.cpp
+ *
+ * A library for Arduino that broadcasts telemetry frames to the local network over UDP multicast.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFLanPublisher.h>  // CF LAN Publisher.
+
+/**
+ * Constructor.
+ * Frames are sent to 239.255.67.70 (site-local multicast) on CF_LAN_PORT.
+ */
+CFLanPublisher::CFLanPublisher() : _group(239, 255, 67, 70),
+                                   _port(CF_LAN_PORT),
+                                   _deviceId(0),
+                                   _sequence(0),
+                                   _sentQty(0),
+                                   _failedQty(0) {
+}
+
+/**
+ * Constructor with multicast group and port.
+ *
+ * @param group Multicast group.
+ * @param port Multicast port.
+ */
+CFLanPublisher::CFLanPublisher(IPAddress group, uint16_t port) : _group(group),
+                                                                 _port(port),
+                                                                 _deviceId(0),
+                                                                 _sequence(0),
+                                                                 _sentQty(0),
+                                                                 _failedQty(0) {
+}
+
+/**
+ * Initialize.
+ */
+void CFLanPublisher::begin() {
+  begin(ESP.getChipId());
+}
+
+/**
+ * Initialize with device id.
+ *
+ * @param deviceId Device id sent in the frames, to tell apart devices simulated on the same host.
+ */
+void CFLanPublisher::begin(uint32_t deviceId) {
+  _deviceId = deviceId;
+}
+
+/**
+ * Broadcast a telemetry frame.
+ *
+ * @param telemetry Telemetry.
+ * @returns True if it was sent.
+ */
+bool CFLanPublisher::publish(const JsonDocument &telemetry) {
+  if (!WiFi.isConnected()) return false;
+
+  uint8_t frame[CF_LAN_FRAME_SIZE];
+  size_t length = CFPayloadCodec::encode(telemetry, frame + CF_LAN_HEADER_SIZE,
+                                         sizeof(frame) - CF_LAN_HEADER_SIZE, CFPayloadCodec::MSGPACK);
+  if (length == 0) {
+    CF_LOG_WARNING("LAN telemetry doesn't fit in a frame. Increase CF_LAN_FRAME_SIZE.");
+    _failedQty++;
+    return false;
+  }
+
+  // Header.
+  uint32_t sequence = _sequence + 1;
+  uint32_t uptime = millis();
+  uint32_t fields[3] = {_deviceId, sequence, uptime};
+  frame[0] = 'C';
+  frame[1] = 'F';
+  frame[2] = 1;
+  frame[3] = CFPayloadCodec::MSGPACK;
+  for (uint8_t i = 0; i < 3; i++) {
+    frame[4 + i * 4] = fields[i] >> 24;
+    frame[5 + i * 4] = fields[i] >> 16;
+    frame[6 + i * 4] = fields[i] >> 8;
+    frame[7 + i * 4] = fields[i];
+  }
+
+  if (!_udp.beginPacketMulticast(_group, _port, WiFi.localIP()) ||
+      _udp.write(frame, CF_LAN_HEADER_SIZE + length) != CF_LAN_HEADER_SIZE + length ||
+      !_udp.endPacket()) {
+    _failedQty++;
+    return false;
+  }
+  _sequence = sequence;
+  _sentQty++;
+  return true;
+}
+
+/**
+ * Get device id.
+ *
+ * @returns Device id (ESP chip id).
+ */
+uint32_t CFLanPublisher::getDeviceId() {
+  return _deviceId;
+}
+
+/**
+ * Get last sequence sent.
+ *
+ * @returns Sequence.
+ */
+uint32_t CFLanPublisher::getSequence() {
+  return _sequence;
+}
+
+/**
+ * Get frames sent.
+ *
+ * @returns Frames sent since boot.
+ */
+unsigned long CFLanPublisher::getSentQty() {
+  return _sentQty;
+}
+
+/**
+ * Get frames that couldn't be sent.
+ *
+ * @returns Frames failed since boot.
+ */
+unsigned long CFLanPublisher::getFailedQty() {
+  return _failedQty;
+}
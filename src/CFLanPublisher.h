@@ -0,0 +1,71 @@
+/**
+ * CFLanPublisher.h
+ *
+ * A library for Arduino that broadcasts telemetry frames to the local network over UDP multicast.
+ *
+ * Local dashboards and aggregators get the values without the round trip to ThingsBoard. Each frame
+ * is one datagram (all numbers big-endian):
+ *
+ *    0   'C' 'F'     Magic.
+ *    2   uint8       Frame version (1).
+ *    3   uint8       Payload encoding (CFPayloadCodec::Encoding, 1 = MessagePack).
+ *    4   uint32      Device id (ESP chip id).
+ *    8   uint32      Sequence, starting at 1 on every boot.
+ *    12  uint32      Device uptime when it was sent (ms).
+ *    16  ...         Telemetry payload.
+ *
+ * Receivers find lost frames by the gaps in the sequence of each device, and latency and jitter by
+ * comparing the arrival time with the uptime, once its offset is taken from the fastest frames.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFLanPublisher_h
+#define CFLanPublisher_h
+
+#include <ArduinoJson.h>     // Arduino JSON.
+#include <CFLog.h>           // CF Log.
+#include <CFPayloadCodec.h>  // CF Payload Codec.
+#include <ESP8266WiFi.h>     // ESP8266 Wi-Fi.
+#include <WiFiUdp.h>         // Wi-Fi UDP.
+
+#ifndef CF_LAN_PORT
+#define CF_LAN_PORT 47808  // Default multicast port.
+#endif
+
+#ifndef CF_LAN_FRAME_SIZE
+#define CF_LAN_FRAME_SIZE 256  // Max frame size, header included.
+#endif
+
+#define CF_LAN_HEADER_SIZE 16  // Frame header size.
+
+class CFLanPublisher {
+ private:
+  // Multicast.
+  WiFiUDP _udp;      // UDP.
+  IPAddress _group;  // Multicast group.
+  uint16_t _port;    // Multicast port.
+
+  // Frames.
+  uint32_t _deviceId;  // Device id.
+  uint32_t _sequence;  // Last sequence sent.
+
+  // Metrics.
+  unsigned long _sentQty;    // Frames sent.
+  unsigned long _failedQty;  // Frames that couldn't be sent.
+
+ public:
+  CFLanPublisher();                                // Constructor.
+  CFLanPublisher(IPAddress group, uint16_t port);  // Constructor with multicast group and port.
+  void begin();                                    // Initialize.
+  void begin(uint32_t deviceId);                   // Initialize with device id.
+  bool publish(const JsonDocument &telemetry);     // Broadcast a telemetry frame.
+  uint32_t getDeviceId();                          // Get device id.
+  uint32_t getSequence();                          // Get last sequence sent.
+  unsigned long getSentQty();                      // Get frames sent.
+  unsigned long getFailedQty();                    // Get frames that couldn't be sent.
+};
+
+#endif
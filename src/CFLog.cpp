@@ -0,0 +1,46 @@
+/**
+ * CFLog.cpp
+ *
+ * Logging macros for CF Arduino Devices, on top of Logger.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFLog.h>  // CF Log.
+
+/**
+ * Format and log a message.
+ * Called by the CF_LOG_* macros once the level was checked.
+ *
+ * @param level Level.
+ * @param format printf-style format, in flash.
+ */
+void CFLog::log(Logger::Level level, PGM_P format, ...) {
+  char message[CF_LOG_BUFFER_SIZE];
+  va_list args;
+  va_start(args, format);
+  vsnprintf_P(message, sizeof(message), format, args);
+  va_end(args);
+
+  switch (level) {
+    case Logger::VERBOSE:
+      Logger::verbose(message);
+      break;
+    case Logger::NOTICE:
+      Logger::notice(message);
+      break;
+    case Logger::WARNING:
+      Logger::warning(message);
+      break;
+    case Logger::ERROR:
+      Logger::error(message);
+      break;
+    case Logger::FATAL:
+      Logger::fatal(message);
+      break;
+    default:
+      break;
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * CFLog.h
+ *
+ * Logging macros for CF Arduino Devices, on top of Logger.
+ *
+ * CF_LOG_VERBOSE(format, ...) and its siblings check the Logger level before anything else, so
+ * their arguments aren't even evaluated when the message is filtered out. Levels below
+ * CF_LOG_MIN_LEVEL aren't compiled at all. Messages are formatted printf-style into a stack buffer
+ * from a format string kept in flash, so no String is built to log them.
+ *
+ *    CF_LOG_WARNING("Fail connecting. Retrying in %lu second(s).", _ttRetry / 1000);
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFLog_h
+#define CFLog_h
+
+#include <Arduino.h>  // Arduino library.
+#include <Logger.h>   // Logger.
+
+// Levels, as in Logger::Level, so they can be compared by the preprocessor.
+#define CF_LOG_LEVEL_VERBOSE 0  // Verbose.
+#define CF_LOG_LEVEL_NOTICE 1   // Notice.
+#define CF_LOG_LEVEL_WARNING 2  // Warning.
+#define CF_LOG_LEVEL_ERROR 3    // Error.
+#define CF_LOG_LEVEL_FATAL 4    // Fatal.
+#define CF_LOG_LEVEL_SILENT 5   // Nothing is compiled.
+
+#ifndef CF_LOG_MIN_LEVEL
+#define CF_LOG_MIN_LEVEL CF_LOG_LEVEL_VERBOSE  // Lowest level compiled in.
+#endif
+
+#ifndef CF_LOG_BUFFER_SIZE
+#define CF_LOG_BUFFER_SIZE 128  // Max formatted message length, longer ones are truncated.
+#endif
+
+class CFLog {
+ public:
+  static void log(Logger::Level level, PGM_P format, ...)  // Format and log a message.
+      __attribute__((format(printf, 2, 3)));
+};
+
+// Log only if the runtime level lets it through, arguments are evaluated after the check.
+#define CF_LOG(level, format, ...)                      \
+  do {                                                  \
+    if (Logger::getLogLevel() <= (level)) {             \
+      CFLog::log((level), PSTR(format), ##__VA_ARGS__); \
+    }                                                   \
+  } while (0)
+
+#if CF_LOG_MIN_LEVEL <= CF_LOG_LEVEL_VERBOSE
+#define CF_LOG_VERBOSE(format, ...) CF_LOG(Logger::VERBOSE, format, ##__VA_ARGS__)
+#else
+#define CF_LOG_VERBOSE(format, ...) do {} while (0)
+#endif
+
+#if CF_LOG_MIN_LEVEL <= CF_LOG_LEVEL_NOTICE
+#define CF_LOG_NOTICE(format, ...) CF_LOG(Logger::NOTICE, format, ##__VA_ARGS__)
+#else
+#define CF_LOG_NOTICE(format, ...) do {} while (0)
+#endif
+
+#if CF_LOG_MIN_LEVEL <= CF_LOG_LEVEL_WARNING
+#define CF_LOG_WARNING(format, ...) CF_LOG(Logger::WARNING, format, ##__VA_ARGS__)
+#else
+#define CF_LOG_WARNING(format, ...) do {} while (0)
+#endif
+
+#if CF_LOG_MIN_LEVEL <= CF_LOG_LEVEL_ERROR
+#define CF_LOG_ERROR(format, ...) CF_LOG(Logger::ERROR, format, ##__VA_ARGS__)
+#else
+#define CF_LOG_ERROR(format, ...) do {} while (0)
+#endif
+
+#if CF_LOG_MIN_LEVEL <= CF_LOG_LEVEL_FATAL
+#define CF_LOG_FATAL(format, ...) CF_LOG(Logger::FATAL, format, ##__VA_ARGS__)
+#else
+#define CF_LOG_FATAL(format, ...) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,841 @@
+/**
+ * CFMQTTClient.cpp
+ *
+ * A network client for Arduino that sits between ThingsBoard and the Wi-Fi connection.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFMQTTClient.h>  // CF MQTT Client.
+
+// MQTT packet types.
+#define CF_MQTT_CONNECT 0x10    // Connect.
+#define CF_MQTT_CONNACK 0x20    // Connect acknowledgement.
+#define CF_MQTT_PUBLISH 0x30    // Publish.
+#define CF_MQTT_SUBSCRIBE 0x82  // Subscribe (with required flags).
+
+// ThingsBoard topics.
+#define CF_TB_RPC_REQUEST_TOPIC "v1/devices/me/rpc/request/"    // RPC request topic prefix.
+#define CF_TB_RPC_RESPONSE_TOPIC "v1/devices/me/rpc/response/"  // RPC response topic prefix.
+#define CF_TB_ATTRIBUTES_TOPIC "v1/devices/me/attributes"      // Attributes topic, and prefix of requests and responses.
+
+// Attribute request identifiers, far from the ones ThingsBoard uses.
+#define CF_MQTT_ATTR_VERSION_REQUEST "52993"  // Version check.
+#define CF_MQTT_ATTR_FETCH_REQUEST "52994"    // Whole set.
+
+/**
+ * Constructor.
+ */
+CFMQTTClient::CFMQTTClient() : _client(),
+                               _packetId(0xCF00),
+                               _transport(BLOCKING),
+                               _txQueue(NULL),
+                               _rpcRouter(NULL),
+                               _persistentSession(false),
+                               _subscriptionsQty(0),
+                               _attributeCache(NULL),
+                               _bytesSent(0),
+                               _bytesReceived(0),
+                               _rpcTime(0),
+                               _writeTime(0),
+                               _txPeak(0),
+                               _txRejected(0),
+                               _skippedQty(0),
+                               _oversizedQty(0) {
+  _reset();
+}
+
+/**
+ * Destructor.
+ */
+CFMQTTClient::~CFMQTTClient() {
+  delete[] _txQueue;
+}
+
+/**
+ * Loop.
+ * Writes the queued bytes the socket has room for.
+ */
+void CFMQTTClient::loop() {
+  if (_txQueue) _drain();
+}
+
+/**
+ * Define transport.
+ * Switching back to BLOCKING writes what's still queued first.
+ *
+ * @param transport Transport, BLOCKING by default.
+ * @returns True if it was defined, false if there isn't memory for the queue.
+ */
+bool CFMQTTClient::setTransport(Transport transport) {
+  if (transport == QUEUED && !_txQueue) {
+    _txQueue = new (std::nothrow) uint8_t[CF_MQTT_QUEUE_SIZE];
+    if (!_txQueue) return false;
+    _txHead = 0;
+    _txLength = 0;
+  } else if (transport == BLOCKING && _txQueue) {
+    while (_txLength > 0) {
+      size_t chunk = min(_txLength, (size_t)CF_MQTT_QUEUE_SIZE - _txHead);
+      if (_send(_txQueue + _txHead, chunk) < chunk) break;
+      _txHead = (_txHead + chunk) % CF_MQTT_QUEUE_SIZE;
+      _txLength -= chunk;
+    }
+    delete[] _txQueue;
+    _txQueue = NULL;
+  }
+  _transport = transport;
+  return true;
+}
+
+/**
+ * Define RPC router.
+ *
+ * @param rpcRouter RPC router that handles the requests, NULL to let them through.
+ */
+void CFMQTTClient::setRPCRouter(CFRPCRouter *rpcRouter) {
+  _rpcRouter = rpcRouter;
+}
+
+/**
+ * Define attribute cache.
+ *
+ * @param attributeCache Attribute cache that keeps the shared attributes received, NULL to stop.
+ */
+void CFMQTTClient::setAttributeCache(CFAttributeCache *attributeCache) {
+  _attributeCache = attributeCache;
+}
+
+/**
+ * Subscribe to the attributes and sync the cache.
+ * Only the version is requested if the cache has one, the whole set otherwise.
+ *
+ * @returns True if the request was sent.
+ */
+bool CFMQTTClient::requestAttributes() {
+  if (!_attributeCache) return false;
+  if (!subscribe(CF_TB_ATTRIBUTES_TOPIC) || !subscribe(CF_TB_ATTRIBUTES_TOPIC "/response/+")) return false;
+  if (_attributeCache->hasVersion()) {
+    return _requestAttributes(CF_MQTT_ATTR_VERSION_REQUEST, "{\"sharedKeys\":\"" CF_ATTR_VERSION_KEY "\"}");
+  }
+  return _requestAttributes(CF_MQTT_ATTR_FETCH_REQUEST, "{}");
+}
+
+/**
+ * Request shared attributes.
+ *
+ * @param requestId Request identifier.
+ * @param keys Request payload.
+ * @returns True if it was sent.
+ */
+bool CFMQTTClient::_requestAttributes(const char *requestId, const char *keys) {
+  char topic[sizeof(CF_TB_ATTRIBUTES_TOPIC "/request/") + 6];
+  strcpy(topic, CF_TB_ATTRIBUTES_TOPIC "/request/");
+  strcat(topic, requestId);
+  return publish(topic, (const uint8_t *)keys, strlen(keys));
+}
+
+/**
+ * Subscribe to a topic with QoS 0.
+ * The acknowledgement is ignored by ThingsBoard like any other unexpected packet.
+ *
+ * @param topic Topic.
+ * @returns True if it was sent.
+ */
+bool CFMQTTClient::subscribe(const char *topic) {
+  size_t topicLength = strlen(topic);
+  uint8_t packetId[2] = {(uint8_t)(++_packetId >> 8), (uint8_t)_packetId};
+  uint8_t qos = 0;
+  uint32_t hash = _hash(topic, topicLength);
+  if (_persistentSession && _isSubscribed(hash)) return true;
+  size_t remaining = 2 + 2 + topicLength + 1;
+  if (!_reserve(_headerLength(remaining) + remaining)) return false;
+
+  size_t sent = _writeHeader(CF_MQTT_SUBSCRIBE, remaining);
+  sent += _put(packetId, 2);
+  sent += _writeString(topic, topicLength);
+  sent += _put(&qos, 1);
+  if (sent != _headerLength(remaining) + remaining) return false;
+  _addSubscription(hash);
+  return true;
+}
+
+/**
+ * Publish a message with QoS 0.
+ *
+ * @param topic Topic.
+ * @param payload Payload.
+ * @param length Payload length.
+ * @returns True if it was sent.
+ */
+bool CFMQTTClient::publish(const char *topic, const uint8_t *payload, size_t length) {
+  return _publish(topic, "", 0, payload, length);
+}
+
+/**
+ * Publish a message with QoS 0 to a topic given in two parts.
+ *
+ * @param prefix Topic prefix.
+ * @param suffix Topic suffix, it doesn't need to be terminated.
+ * @param suffixLength Topic suffix length.
+ * @param payload Payload.
+ * @param length Payload length.
+ * @returns True if it was sent.
+ */
+bool CFMQTTClient::_publish(const char *prefix, const char *suffix, size_t suffixLength, const uint8_t *payload, size_t length) {
+  size_t prefixLength = strlen(prefix);
+  size_t topicLength = prefixLength + suffixLength;
+  size_t remaining = 2 + topicLength + length;
+  if (!_reserve(_headerLength(remaining) + remaining)) return false;
+
+  uint8_t topicPrefix[2] = {(uint8_t)(topicLength >> 8), (uint8_t)topicLength};
+  size_t sent = _writeHeader(CF_MQTT_PUBLISH, remaining);
+  sent += _put(topicPrefix, 2);
+  sent += _put((const uint8_t *)prefix, prefixLength);
+  sent += _put((const uint8_t *)suffix, suffixLength);
+  sent += _put(payload, length);
+  return sent == _headerLength(remaining) + remaining;
+}
+
+/**
+ * Get fixed header length.
+ *
+ * @param remaining Remaining length.
+ * @returns Fixed header length.
+ */
+size_t CFMQTTClient::_headerLength(size_t remaining) {
+  size_t length = 2;
+  while (remaining >= 128 && length < 5) {
+    remaining /= 128;
+    length++;
+  }
+  return length;
+}
+
+/**
+ * Write fixed header, into room already reserved.
+ *
+ * @param type Packet type and flags.
+ * @param remaining Remaining length.
+ * @returns Bytes written.
+ */
+size_t CFMQTTClient::_writeHeader(uint8_t type, size_t remaining) {
+  uint8_t header[5];
+  size_t length = 0;
+  header[length++] = type;
+  do {
+    uint8_t digit = remaining % 128;
+    remaining /= 128;
+    header[length++] = remaining > 0 ? digit | 0x80 : digit;
+  } while (remaining > 0 && length < sizeof(header));
+  return _put(header, length);
+}
+
+/**
+ * Write length-prefixed string, into room already reserved.
+ *
+ * @param value String.
+ * @param length String length.
+ * @returns Bytes written.
+ */
+size_t CFMQTTClient::_writeString(const char *value, size_t length) {
+  uint8_t prefix[2] = {(uint8_t)(length >> 8), (uint8_t)length};
+  return _put(prefix, 2) + _put((const uint8_t *)value, length);
+}
+
+/**
+ * Write to the socket.
+ *
+ * @param data Bytes.
+ * @param length Bytes quantity.
+ * @returns Bytes written.
+ */
+size_t CFMQTTClient::_send(const uint8_t *data, size_t length) {
+  unsigned long start = micros();
+  size_t sent = _client.write(data, length);
+  _writeTime += micros() - start;
+  _bytesSent += sent;
+  return sent;
+}
+
+/**
+ * Bytes that can be written without blocking.
+ * The socket only takes them directly while nothing is queued, otherwise they would be sent out of order.
+ *
+ * @returns Bytes quantity.
+ */
+size_t CFMQTTClient::_room() {
+  if (!_txQueue) return SIZE_MAX;
+  size_t room = CF_MQTT_QUEUE_SIZE - _txLength;
+  if (_txLength == 0) room += _client.availableForWrite();
+  return room;
+}
+
+/**
+ * Write queued bytes the socket has room for.
+ *
+ * @returns Bytes written.
+ */
+size_t CFMQTTClient::_drain() {
+  size_t sent = 0;
+  while (_txLength > 0) {
+    size_t chunk = min(min(_txLength, (size_t)CF_MQTT_QUEUE_SIZE - _txHead), (size_t)_client.availableForWrite());
+    if (chunk == 0) break;
+    size_t written = _send(_txQueue + _txHead, chunk);
+    _txHead = (_txHead + written) % CF_MQTT_QUEUE_SIZE;
+    _txLength -= written;
+    sent += written;
+    if (written < chunk) break;
+  }
+  return sent;
+}
+
+/**
+ * Write CONNECT without the clean session flag.
+ *
+ * @param buf CONNECT packet.
+ * @param size Packet length.
+ * @returns Bytes written.
+ */
+size_t CFMQTTClient::_writeConnect(const uint8_t *buf, size_t size) {
+  // Skip fixed header and protocol name, the flags come after the protocol level.
+  size_t offset = 1;
+  while (offset < size && (buf[offset++] & 0x80))
+    ;
+  if (offset + 2 > size) return _write(buf, size);
+  size_t flagsOffset = offset + 2 + ((buf[offset] << 8) | buf[offset + 1]) + 1;
+  if (flagsOffset >= size) return _write(buf, size);
+
+  uint8_t flags = buf[flagsOffset] & ~0x02;
+  if (!_reserve(size)) return 0;
+  return _put(buf, flagsOffset) + _put(&flags, 1) + _put(buf + flagsOffset + 1, size - flagsOffset - 1);
+}
+
+/**
+ * Write a SUBSCRIBE packet written by ThingsBoard, unless the broker already has the subscription.
+ *
+ * @param buf SUBSCRIBE packet.
+ * @param size Packet length.
+ * @returns Bytes written, or the packet length if it didn't have to be sent.
+ */
+size_t CFMQTTClient::_writeSubscribe(const uint8_t *buf, size_t size) {
+  // Skip fixed header and packet identifier.
+  size_t offset = 1;
+  while (offset < size && (buf[offset++] & 0x80))
+    ;
+  offset += 2;
+  if (offset + 2 > size) return _write(buf, size);
+  size_t topicLength = (buf[offset] << 8) | buf[offset + 1];
+  if (offset + 2 + topicLength + 1 != size) return _write(buf, size);  // Only single topic packets.
+
+  uint32_t hash = _hash((const char *)buf + offset + 2, topicLength);
+  if (_isSubscribed(hash)) return size;
+  size_t sent = _write(buf, size);
+  if (sent == size) _addSubscription(hash);
+  return sent;
+}
+
+/**
+ * Hash a topic filter (FNV-1a).
+ *
+ * @param topic Topic filter.
+ * @param length Topic filter length.
+ * @returns Hash.
+ */
+uint32_t CFMQTTClient::_hash(const char *topic, size_t length) {
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ (uint8_t)topic[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+/**
+ * Check a subscription.
+ *
+ * @param hash Topic filter hash.
+ * @returns True if the broker kept the session and it was already subscribed.
+ */
+bool CFMQTTClient::_isSubscribed(uint32_t hash) {
+  if (!_sessionPresent) return false;
+  for (uint8_t i = 0; i < _subscriptionsQty; i++) {
+    if (_subscriptions[i] != hash) continue;
+    _skippedQty++;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Remember a subscription sent, for the next connections.
+ *
+ * @param hash Topic filter hash.
+ */
+void CFMQTTClient::_addSubscription(uint32_t hash) {
+  for (uint8_t i = 0; i < _subscriptionsQty; i++) {
+    if (_subscriptions[i] == hash) return;
+  }
+  if (_subscriptionsQty < CF_MQTT_MAX_SUBSCRIPTIONS) _subscriptions[_subscriptionsQty++] = hash;
+}
+
+/**
+ * Reset connection state.
+ */
+void CFMQTTClient::_reset() {
+  _sessionPresent = false;
+  _txHead = 0;
+  _txLength = 0;
+  _rxLength = 0;
+  _rxExpected = 0;
+  _rxPosition = 0;
+  _rxPassthrough = 0;
+  _rxReady = false;
+}
+
+/**
+ * Receive available bytes without blocking.
+ * When a whole packet is buffered it's either consumed here or made ready to be read by ThingsBoard.
+ */
+void CFMQTTClient::_receive() {
+  while (!_rxReady && _client.available() > 0) {
+    if (_rxExpected == 0) {
+      // Fixed header is read byte by byte until its length is known.
+      _rxBuffer[_rxLength++] = _client.read();
+      _bytesReceived++;
+      _rxExpected = _packetLength();
+      if (_rxExpected == 0) continue;
+
+      // Packets that don't fit in the buffer are streamed to ThingsBoard.
+      if (_rxExpected > sizeof(_rxBuffer)) {
+        CF_LOG_WARNING("MQTT packet of %u bytes can't be inspected, it goes to ThingsBoard. Increase CF_MQTT_BUFFER_SIZE.", _rxExpected);
+        _oversizedQty++;
+        _rxPassthrough = _rxExpected - _rxLength;
+        _rxExpected = 0;
+        _rxPosition = 0;
+        _rxReady = true;
+        return;
+      }
+    } else {
+      int read = _client.read(_rxBuffer + _rxLength, _rxExpected - _rxLength);
+      if (read <= 0) return;
+      _rxLength += read;
+      _bytesReceived += read;
+    }
+
+    if (_rxLength == _rxExpected) {
+      _rxExpected = 0;
+      if (_handlePacket()) {
+        _rxLength = 0;
+      } else {
+        _rxPosition = 0;
+        _rxReady = true;
+      }
+    }
+  }
+}
+
+/**
+ * Decode packet length from the fixed header.
+ *
+ * @returns Packet length or 0 if the fixed header is incomplete.
+ */
+size_t CFMQTTClient::_packetLength() {
+  size_t remaining = 0;
+  size_t multiplier = 1;
+  for (size_t i = 1; i < _rxLength; i++) {
+    remaining += (_rxBuffer[i] & 0x7F) * multiplier;
+    if ((_rxBuffer[i] & 0x80) == 0 || i == 4) return i + 1 + remaining;
+    multiplier *= 128;
+  }
+  return 0;
+}
+
+/**
+ * Handle a buffered packet.
+ *
+ * @returns True if it was consumed and must not reach ThingsBoard.
+ */
+bool CFMQTTClient::_handlePacket() {
+  // Broker tells if it kept the session, otherwise every subscription must be sent again.
+  if (_rxBuffer[0] == CF_MQTT_CONNACK && _rxLength >= 4) {
+    _sessionPresent = _persistentSession && _rxBuffer[3] == 0 && (_rxBuffer[2] & 0x01);
+    if (!_sessionPresent) _subscriptionsQty = 0;
+    return false;
+  }
+  if ((_rxBuffer[0] & 0xF0) != CF_MQTT_PUBLISH || (!_rpcRouter && !_attributeCache)) return false;
+
+  // Skip fixed header.
+  size_t offset = 1;
+  while (_rxBuffer[offset++] & 0x80)
+    ;
+
+  // Topic.
+  if (offset + 2 > _rxLength) return false;
+  size_t topicLength = (_rxBuffer[offset] << 8) | _rxBuffer[offset + 1];
+  const char *topic = (const char *)_rxBuffer + offset + 2;
+  offset += 2 + topicLength;
+  if (((_rxBuffer[0] >> 1) & 0x03) > 0) offset += 2;  // Packet identifier.
+  if (offset > _rxLength) return false;
+
+  const size_t attributesLength = sizeof(CF_TB_ATTRIBUTES_TOPIC) - 1;
+  if (_attributeCache && topicLength >= attributesLength && strncmp(topic, CF_TB_ATTRIBUTES_TOPIC, attributesLength) == 0) {
+    return _handleAttributes(topic + attributesLength, topicLength - attributesLength,
+                             (const char *)_rxBuffer + offset, _rxLength - offset);
+  }
+  if (!_rpcRouter) return false;
+
+  const size_t prefixLength = sizeof(CF_TB_RPC_REQUEST_TOPIC) - 1;
+  if (topicLength <= prefixLength || strncmp(topic, CF_TB_RPC_REQUEST_TOPIC, prefixLength) != 0) return false;
+
+  _handleRPC(topic + prefixLength, topicLength - prefixLength,
+             (const char *)_rxBuffer + offset, _rxLength - offset);
+  return true;
+}
+
+/**
+ * Handle RPC request and publish its response.
+ *
+ * @param requestId Request identifier, from the topic.
+ * @param requestIdLength Request identifier length.
+ * @param payload Request payload.
+ * @param length Request payload length.
+ */
+void CFMQTTClient::_handleRPC(const char *requestId, size_t requestIdLength, const char *payload, size_t length) {
+  unsigned long start = micros();
+  char response[CF_RPC_ROUTER_DOC_SIZE];
+  size_t responseLength = _rpcRouter->dispatch(payload, length, response, sizeof(response));
+  if (responseLength > 0) {
+    _publish(CF_TB_RPC_RESPONSE_TOPIC, requestId, requestIdLength, (const uint8_t *)response, responseLength);
+  }
+  _rpcTime = micros() - start;
+}
+
+/**
+ * Handle shared attributes.
+ * Changes pushed by ThingsBoard are kept and let through to its callbacks, the responses of the
+ * cache requests are consumed here.
+ *
+ * @param suffix Topic after the attributes topic.
+ * @param suffixLength Topic suffix length.
+ * @param payload Payload.
+ * @param length Payload length.
+ * @returns True if it was consumed.
+ */
+bool CFMQTTClient::_handleAttributes(const char *suffix, size_t suffixLength, const char *payload, size_t length) {
+  const size_t responseLength = sizeof("/response/") - 1;
+  const size_t requestIdLength = sizeof(CF_MQTT_ATTR_VERSION_REQUEST) - 1;
+  bool update = suffixLength == 0;
+  bool response = suffixLength == responseLength + requestIdLength && strncmp(suffix, "/response/", responseLength) == 0;
+  bool version = response && strncmp(suffix + responseLength, CF_MQTT_ATTR_VERSION_REQUEST, requestIdLength) == 0;
+  bool fetch = response && strncmp(suffix + responseLength, CF_MQTT_ATTR_FETCH_REQUEST, requestIdLength) == 0;
+  if (!update && !version && !fetch) return false;
+
+  // The payload is copied, updates are still read by ThingsBoard.
+  CFJsonScratch doc(CF_ATTR_CACHE_SIZE, CFJsonArenaAllocator("mqtt"));
+  DeserializationError error = deserializeJson(doc, payload, length);
+  if (error) {
+    CF_LOG_WARNING("Fail reading shared attributes: %s.", error.c_str());
+    return !update;
+  }
+
+  if (update) {
+    _attributeCache->update(doc.as<JsonObjectConst>());
+    return false;
+  }
+  JsonObjectConst shared = doc.as<JsonObjectConst>()["shared"];
+  if (fetch) {
+    _attributeCache->replace(shared);
+  } else if (_attributeCache->isUpToDate(shared)) {
+    CF_LOG_VERBOSE("Cached attributes are up to date.");
+  } else {
+    _requestAttributes(CF_MQTT_ATTR_FETCH_REQUEST, "{}");
+  }
+  return true;
+}
+
+/**
+ * Define persistent session.
+ * The client id must be the same on every connection for the broker to find the session.
+ *
+ * @param persistentSession True to ask the broker to keep the session, false by default.
+ */
+void CFMQTTClient::setPersistentSession(bool persistentSession) {
+  _persistentSession = persistentSession;
+}
+
+/**
+ * True if the broker kept the session of the last connection.
+ *
+ * @returns True if the session is present.
+ */
+bool CFMQTTClient::isSessionPresent() {
+  return _sessionPresent;
+}
+
+/**
+ * Get subscriptions not sent because the broker kept them.
+ *
+ * @returns Subscriptions skipped since boot.
+ */
+unsigned long CFMQTTClient::getSkippedQty() {
+  return _skippedQty;
+}
+
+/**
+ * Get bytes written to the network.
+ *
+ * @returns Bytes sent since boot.
+ */
+unsigned long CFMQTTClient::getBytesSent() {
+  return _bytesSent;
+}
+
+/**
+ * Get bytes read from the network.
+ *
+ * @returns Bytes received since boot.
+ */
+unsigned long CFMQTTClient::getBytesReceived() {
+  return _bytesReceived;
+}
+
+/**
+ * Get time spent handling the last RPC request, from parsing to publishing the response.
+ *
+ * @returns Time in microseconds.
+ */
+unsigned long CFMQTTClient::getRPCTime() {
+  return _rpcTime;
+}
+
+/**
+ * Get time spent writing to the socket, the time ThingsBoard was blocked by the network.
+ *
+ * @returns Time in microseconds since boot.
+ */
+unsigned long CFMQTTClient::getWriteTime() {
+  return _writeTime;
+}
+
+/**
+ * Get bytes queued.
+ *
+ * @returns Bytes waiting to be written.
+ */
+size_t CFMQTTClient::getQueueDepth() {
+  return _txLength;
+}
+
+/**
+ * Get max bytes queued.
+ *
+ * @returns Max bytes waiting to be written since boot.
+ */
+size_t CFMQTTClient::getQueuePeak() {
+  return _txPeak;
+}
+
+/**
+ * Get packets rejected because the queue was full.
+ *
+ * @returns Packets rejected since boot.
+ */
+unsigned long CFMQTTClient::getQueueRejected() {
+  return _txRejected;
+}
+
+/**
+ * True if the queue is over half full, new data should be held back until it drains.
+ *
+ * @returns True if it's backpressured.
+ */
+bool CFMQTTClient::isBackpressured() {
+  return _txQueue && _txLength > CF_MQTT_QUEUE_SIZE / 2;
+}
+
+/**
+ * Get packets too large to be inspected, RPC requests and attributes in them weren't handled here.
+ *
+ * @returns Packets passed through since boot.
+ */
+unsigned long CFMQTTClient::getOversizedQty() {
+  return _oversizedQty;
+}
+
+/**
+ * Connect.
+ */
+int CFMQTTClient::connect(IPAddress ip, uint16_t port) {
+  _reset();
+  return _client.connect(ip, port);
+}
+
+/**
+ * Connect.
+ */
+int CFMQTTClient::connect(const char *host, uint16_t port) {
+  _reset();
+  return _client.connect(host, port);
+}
+
+/**
+ * Write a byte.
+ */
+size_t CFMQTTClient::write(uint8_t b) {
+  return write(&b, 1);
+}
+
+/**
+ * Write bytes.
+ * ThingsBoard writes each packet at once, so with a persistent session its CONNECT and SUBSCRIBE
+ * packets are recognized here.
+ */
+size_t CFMQTTClient::write(const uint8_t *buf, size_t size) {
+  if (_persistentSession && size > 0) {
+    if (buf[0] == CF_MQTT_CONNECT) return _writeConnect(buf, size);
+    if (buf[0] == CF_MQTT_SUBSCRIBE) return _writeSubscribe(buf, size);
+  }
+  return _write(buf, size);
+}
+
+/**
+ * Write bytes through the transport, as a whole packet.
+ * With the QUEUED transport they are written as far as the socket has room and the rest is queued,
+ * all of them or none if the queue can't take them.
+ *
+ * @param buf Bytes.
+ * @param size Bytes quantity.
+ * @returns Bytes written or queued.
+ */
+size_t CFMQTTClient::_write(const uint8_t *buf, size_t size) {
+  return _reserve(size) ? _put(buf, size) : 0;
+}
+
+/**
+ * Reserve room for a packet.
+ * Packets written in parts reserve their whole length once, so none of the parts can be refused
+ * and a partial packet never reaches the socket.
+ *
+ * @param size Packet length.
+ * @returns True if it fits, false if it was rejected.
+ */
+bool CFMQTTClient::_reserve(size_t size) {
+  if (!_txQueue) return true;
+
+  _drain();
+  if (_room() < size) {
+    _txRejected++;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Write bytes into room already reserved.
+ * The socket only takes bytes directly while nothing is queued, and what it doesn't take is queued.
+ * The socket room only shrinks by what's written to it, so the rest always fits in the queue.
+ *
+ * @param buf Bytes.
+ * @param size Bytes quantity.
+ * @returns Bytes written or queued.
+ */
+size_t CFMQTTClient::_put(const uint8_t *buf, size_t size) {
+  if (!_txQueue) return _send(buf, size);
+
+  size_t sent = 0;
+  if (_txLength == 0) {
+    sent = _send(buf, min(size, (size_t)_client.availableForWrite()));
+  }
+  while (sent < size) {
+    size_t tail = (_txHead + _txLength) % CF_MQTT_QUEUE_SIZE;
+    size_t chunk = min(size - sent, (size_t)CF_MQTT_QUEUE_SIZE - tail);
+    memcpy(_txQueue + tail, buf + sent, chunk);
+    _txLength += chunk;
+    sent += chunk;
+  }
+  if (_txLength > _txPeak) _txPeak = _txLength;
+  return size;
+}
+
+/**
+ * Bytes available to ThingsBoard.
+ * Queued bytes are written here too, ThingsBoard waits for the answers of its packets by polling it.
+ */
+int CFMQTTClient::available() {
+  if (_txQueue) _drain();
+  if (_rxReady) {
+    if (_rxPosition < _rxLength) return _rxLength - _rxPosition;
+    _rxReady = false;
+    _rxLength = 0;
+  }
+  if (_rxPassthrough > 0) {
+    return min((size_t)_client.available(), _rxPassthrough);
+  }
+  _receive();
+  return _rxReady ? _rxLength - _rxPosition : 0;
+}
+
+/**
+ * Read a byte.
+ */
+int CFMQTTClient::read() {
+  if (available() <= 0) return -1;
+  if (_rxReady) return _rxBuffer[_rxPosition++];
+  int b = _client.read();
+  if (b >= 0) {
+    _rxPassthrough--;
+    _bytesReceived++;
+  }
+  return b;
+}
+
+/**
+ * Read bytes.
+ */
+int CFMQTTClient::read(uint8_t *buf, size_t size) {
+  size_t read = 0;
+  while (read < size && available() > 0) {
+    buf[read++] = this->read();
+  }
+  return read;
+}
+
+/**
+ * Peek a byte.
+ */
+int CFMQTTClient::peek() {
+  if (available() <= 0) return -1;
+  if (_rxReady) return _rxBuffer[_rxPosition];
+  return _client.peek();
+}
+
+/**
+ * Flush.
+ */
+void CFMQTTClient::flush() {
+  if (_txQueue) _drain();
+  _client.flush();
+}
+
+/**
+ * Stop.
+ */
+void CFMQTTClient::stop() {
+  _client.stop();
+  _reset();
+}
+
+/**
+ * True if it's connected.
+ */
+uint8_t CFMQTTClient::connected() {
+  return _client.connected() || (_rxReady && _rxPosition < _rxLength);
+}
+
+/**
+ * True if it's connected.
+ */
+CFMQTTClient::operator bool() {
+  return connected();
+}
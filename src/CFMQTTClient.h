@@ -0,0 +1,164 @@
+/**
+ * CFMQTTClient.h
+ *
+ * A network client for Arduino that sits between ThingsBoard and the Wi-Fi connection.
+ *
+ * Every byte ThingsBoard reads or writes goes through this client, which frames the incoming MQTT
+ * packets. RPC requests are handed to a CFRPCRouter and answered from here, shared attributes are
+ * kept by a CFAttributeCache, the other packets are passed through untouched to ThingsBoard. Packets
+ * over CF_MQTT_BUFFER_SIZE can't be inspected, they are passed through too and counted.
+ *
+ * With the QUEUED transport, outgoing bytes are written to the socket only as far as its send buffer
+ * has room and the rest waits in a queue that's drained on every loop, so a slow TCP window or a
+ * retransmission never stalls the sketch inside a publish. Packets are queued whole or not at all,
+ * when the queue can't take one the write fails like a broken connection would, and callers should
+ * hold their data back while isBackpressured() is true.
+ *
+ * With a persistent session the clean session flag of ThingsBoard's CONNECT is cleared, so the broker
+ * keeps the subscriptions across reconnections. When it says it did (session present in CONNACK),
+ * the subscriptions already made since boot aren't sent again.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFMQTTClient_h
+#define CFMQTTClient_h
+
+#include <CFAttributeCache.h>  // CF Attribute Cache.
+#include <CFJsonArena.h>       // CF JSON Arena.
+#include <CFRPCRouter.h>       // CF RPC Router.
+#include <Client.h>            // Arduino client.
+#include <new>                 // Non-throwing new.
+#include <WiFiClient.h>        // Wi-Fi client.
+
+#ifndef CF_MQTT_BUFFER_SIZE
+#define CF_MQTT_BUFFER_SIZE CF_ATTR_CACHE_SIZE  // Max size of packets that can be inspected.
+#endif
+
+#if CF_MQTT_BUFFER_SIZE < CF_ATTR_CACHE_SIZE
+#error "CF_MQTT_BUFFER_SIZE must be at least CF_ATTR_CACHE_SIZE, or shared attributes aren't cached."
+#endif
+
+#ifndef CF_MQTT_MAX_SUBSCRIPTIONS
+#define CF_MQTT_MAX_SUBSCRIPTIONS 8  // Max subscriptions remembered for persistent sessions.
+#endif
+
+#ifndef CF_MQTT_QUEUE_SIZE
+#define CF_MQTT_QUEUE_SIZE 1024  // Outgoing queue size of the QUEUED transport.
+#endif
+
+class CFMQTTClient : public Client {
+ public:
+  // Transports.
+  enum Transport {
+    BLOCKING,  // Written straight to the socket, waiting for room in its send buffer.
+    QUEUED     // Written as far as the send buffer has room, the rest is queued.
+  };
+
+ private:
+  // Connection.
+  WiFiClient _client;  // Wi-Fi client.
+  uint16_t _packetId;  // Last packet identifier sent by this client.
+
+  // Incoming packets.
+  uint8_t _rxBuffer[CF_MQTT_BUFFER_SIZE];  // Packet being received.
+  size_t _rxLength;                        // Bytes in the buffer.
+  size_t _rxExpected;                      // Packet length, 0 while the fixed header is incomplete.
+  size_t _rxPosition;                      // Bytes already read by ThingsBoard.
+  size_t _rxPassthrough;                   // Bytes of an oversized packet not buffered yet.
+  bool _rxReady;                           // Flag that indicates the buffer holds a packet for ThingsBoard.
+
+  // Outgoing queue.
+  Transport _transport;  // Transport.
+  uint8_t *_txQueue;     // Bytes waiting to be written, only with the QUEUED transport.
+  size_t _txHead;        // Position of the next byte to be written.
+  size_t _txLength;      // Bytes in the queue.
+
+  // Session.
+  bool _persistentSession;                             // Flag that indicates the session must be kept by the broker.
+  bool _sessionPresent;                                // Flag that indicates the broker kept the session.
+  uint32_t _subscriptions[CF_MQTT_MAX_SUBSCRIPTIONS];  // Hashes of the topics subscribed since boot.
+  uint8_t _subscriptionsQty;                           // Topics subscribed since boot.
+
+  // Routing.
+  CFRPCRouter *_rpcRouter;            // RPC router.
+  CFAttributeCache *_attributeCache;  // Attribute cache.
+
+  // Metrics.
+  unsigned long _bytesSent;      // Bytes written to the network.
+  unsigned long _bytesReceived;  // Bytes read from the network.
+  unsigned long _rpcTime;        // Time spent handling the last RPC request (us).
+  unsigned long _writeTime;      // Time spent writing to the socket (us).
+  size_t _txPeak;                // Max bytes queued.
+  unsigned long _txRejected;     // Packets rejected because the queue was full.
+  unsigned long _skippedQty;     // Subscriptions not sent because the broker kept them.
+  unsigned long _oversizedQty;   // Packets too large to be inspected.
+
+  // Methods.
+  void _reset();                                                      // Reset connection state.
+  void _receive();                                                    // Receive available bytes.
+  size_t _packetLength();                                             // Decode packet length from the fixed header.
+  bool _handlePacket();                                               // Handle a packet, true if it was consumed.
+  void _handleRPC(const char *requestId, size_t requestIdLength,      // Handle RPC request.
+                  const char *payload, size_t length);
+  bool _handleAttributes(const char *suffix, size_t suffixLength,     // Handle attributes, true if consumed.
+                         const char *payload, size_t length);
+  bool _requestAttributes(const char *requestId, const char *keys);   // Request shared attributes.
+  bool _publish(const char *prefix, const char *suffix,               // Publish a message to a topic given in two parts.
+                size_t suffixLength, const uint8_t *payload, size_t length);
+  static size_t _headerLength(size_t remaining);                      // Get fixed header length.
+  size_t _writeHeader(uint8_t type, size_t remaining);                // Write fixed header, into reserved room.
+  size_t _writeString(const char *value, size_t length);              // Write length-prefixed string, into reserved room.
+  size_t _write(const uint8_t *buf, size_t size);                     // Write bytes through the transport, as a whole packet.
+  bool _reserve(size_t size);                                         // Reserve room for a packet.
+  size_t _put(const uint8_t *buf, size_t size);                       // Write bytes into reserved room.
+  size_t _send(const uint8_t *data, size_t length);                   // Write to the socket.
+  size_t _room();                                                     // Bytes that can be written without blocking.
+  size_t _drain();                                                    // Write queued bytes the socket has room for.
+  size_t _writeConnect(const uint8_t *buf, size_t size);              // Write CONNECT without clean session.
+  size_t _writeSubscribe(const uint8_t *buf, size_t size);            // Write SUBSCRIBE unless the broker has it.
+  static uint32_t _hash(const char *topic, size_t length);            // Hash a topic filter.
+  bool _isSubscribed(uint32_t hash);                                  // Check a subscription, true if the broker has it.
+  void _addSubscription(uint32_t hash);                               // Remember a subscription sent.
+
+ public:
+  CFMQTTClient();                                                          // Constructor.
+  ~CFMQTTClient();                                                         // Destructor.
+  void loop();                                                             // Loop.
+  bool setTransport(Transport transport);                                  // Define transport.
+  void setRPCRouter(CFRPCRouter *rpcRouter);                               // Define RPC router.
+  void setAttributeCache(CFAttributeCache *attributeCache);                // Define attribute cache.
+  bool requestAttributes();                                                // Subscribe to the attributes and sync the cache.
+  void setPersistentSession(bool persistentSession);                       // Define persistent session.
+  bool isSessionPresent();                                                 // True if the broker kept the session.
+  unsigned long getSkippedQty();                                           // Get subscriptions skipped.
+  bool subscribe(const char *topic);                                       // Subscribe to a topic.
+  bool publish(const char *topic, const uint8_t *payload, size_t length);  // Publish a message.
+  unsigned long getBytesSent();                                            // Get bytes written to the network.
+  unsigned long getBytesReceived();                                        // Get bytes read from the network.
+  unsigned long getRPCTime();                                              // Get time spent handling the last RPC request.
+  unsigned long getWriteTime();                                            // Get time spent writing to the socket.
+  size_t getQueueDepth();                                                  // Get bytes queued.
+  size_t getQueuePeak();                                                   // Get max bytes queued.
+  unsigned long getQueueRejected();                                        // Get packets rejected by a full queue.
+  bool isBackpressured();                                                  // True if the queue is over half full.
+  unsigned long getOversizedQty();                                         // Get packets too large to be inspected.
+
+  // Client.
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(const char *host, uint16_t port) override;
+  size_t write(uint8_t b) override;
+  size_t write(const uint8_t *buf, size_t size) override;
+  int available() override;
+  int read() override;
+  int read(uint8_t *buf, size_t size) override;
+  int peek() override;
+  void flush() override;
+  void stop() override;
+  uint8_t connected() override;
+  operator bool() override;
+};
+
+#endif
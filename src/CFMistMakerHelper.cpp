@@ -16,8 +16,10 @@
  */
 CFMistMakerHelper::CFMistMakerHelper(int pinButton) : _button(pinButton, HIGH),
                                                       _pinStatus(-1),
+                                                      _lastChange(0),
                                                       _changeStatus(false),
-                                                      _lastStatus(0) {
+                                                      _lastStatus(0),
+                                                      _onStatusChangeCallback(NULL) {
 }
 
 /**
@@ -25,8 +27,10 @@ CFMistMakerHelper::CFMistMakerHelper(int pinButton) : _button(pinButton, HIGH),
  */
 CFMistMakerHelper::CFMistMakerHelper(int pinButton, int pinStatus) : _button(pinButton, HIGH),
                                                                      _pinStatus(pinStatus),
+                                                                     _lastChange(0),
                                                                      _changeStatus(false),
-                                                                     _lastStatus(0) {
+                                                                     _lastStatus(0),
+                                                      _onStatusChangeCallback(NULL) {
 }
 
 /**
@@ -37,7 +41,7 @@ void CFMistMakerHelper::begin() {
   _button.begin();
 
   // Initialize status pin, if it's defined.
-  if (_pinStatus >= 0) pinMode(_pinStatus, INPUT);
+  if (_pinStatus.isValid()) _pinStatus.setMode(INPUT);
 }
 
 /**
@@ -70,9 +74,10 @@ void CFMistMakerHelper::loop() {
  * @return 1 if it's on.
  */
 int CFMistMakerHelper::_readStatus() {
-  if (_pinStatus >= 0) {
+  CF_WATCHDOG_SECTION("mist_status");
+  if (_pinStatus.isValid()) {
     for (int i = 0; i < 50; i++) {
-      if (digitalRead(_pinStatus) > 0) return 1;
+      if (_pinStatus.read()) return 1;
       delay(10);
     }
   }
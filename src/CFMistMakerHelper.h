@@ -12,7 +12,9 @@
 #define CFMistMakerHelper_h
 
 #include <Arduino.h>          // Arduino library.
+#include <CFFastGPIO.h>       // CF Fast GPIO.
 #include <CFVirtualButton.h>  // CF Virtual Button.
+#include <CFWatchdog.h>       // CF Watchdog.
 
 class CFMistMakerHelper {
  private:
@@ -20,11 +22,11 @@ class CFMistMakerHelper {
   using VoidCallback = void (*)(int status);  // Alias for callback.
 
   // Control attributes.
-  CFVirtualButton _button;  // Virtual Button.
-  int _pinStatus;           // Status pin.
-  int _lastChange;          // Last time status was changed.
-  bool _changeStatus;       // Last status.
-  int _lastStatus;          // Last status.
+  CFVirtualButton _button;    // Virtual Button.
+  CFFastGPIO _pinStatus;      // Status pin.
+  unsigned long _lastChange;  // Last time status was changed.
+  bool _changeStatus;         // Last status.
+  int _lastStatus;            // Last status.
 
   // Methods.
   int _readStatus();  // Read the status.
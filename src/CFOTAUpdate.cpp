@@ -0,0 +1,273 @@
+/**
+ * CFOTAUpdate.cpp
+ *
+ * A library for Arduino that streams firmware images to the ESP8266 update partition.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFOTAUpdate.h>  // CF OTA Update.
+
+/**
+ * Constructor.
+ */
+CFOTAUpdate::CFOTAUpdate() : _encoding(UNKNOWN),
+                             _decoder(NULL),
+                             _running(false),
+                             _success(false),
+                             _received(0),
+                             _written(0),
+                             _tStart(0),
+                             _time(0) {
+}
+
+/**
+ * Destructor.
+ */
+CFOTAUpdate::~CFOTAUpdate() {
+  delete _decoder;
+}
+
+/**
+ * Start an update.
+ * Flash is only touched when the first chunk arrives and the encoding is known.
+ *
+ * @param md5 Expected MD5 of the image written to flash (decompressed for heatshrink images), empty to skip the check.
+ * @returns True if it was started.
+ */
+bool CFOTAUpdate::begin(String md5) {
+  if (_running) abort();
+
+  _encoding = UNKNOWN;
+  _md5 = md5;
+  _running = true;
+  _success = false;
+  _error = "";
+  _received = 0;
+  _written = 0;
+  _tStart = millis();
+  _time = 0;
+  CF_LOG_NOTICE("Starting firmware update.");
+  return true;
+}
+
+/**
+ * Detect encoding and start writing to flash.
+ *
+ * @param first First byte of the image.
+ * @returns True if the update partition is ready.
+ */
+bool CFOTAUpdate::_detect(uint8_t first) {
+  if (first == 0xE9) {
+    _encoding = RAW;
+  } else if (first == 0x1F) {
+    _encoding = GZIP;
+  } else {
+    _encoding = HEATSHRINK;
+    _decoder = new (std::nothrow) CFHeatshrinkDecoder(CF_OTA_HS_WINDOW_BITS, CF_OTA_HS_LOOKAHEAD_BITS);
+    if (!_decoder || !_decoder->isValid()) {
+      _error = "Not enough memory to decompress.";
+      abort();
+      return false;
+    }
+  }
+
+  uint32_t maxSketchSpace = (ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000;
+  if (!Update.begin(maxSketchSpace, U_FLASH)) return _fail();
+  if (_md5.length() > 0 && !Update.setMD5(_md5.c_str())) {
+    _error = "Invalid MD5.";
+    abort();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Receive a chunk of the image.
+ *
+ * @param data Chunk.
+ * @param length Chunk length.
+ * @returns True if it was written.
+ */
+bool CFOTAUpdate::write(uint8_t *data, size_t length) {
+  if (!_running || length == 0) return _running;
+  if (_encoding == UNKNOWN && !_detect(data[0])) return false;
+  _received += length;
+
+  if (_encoding != HEATSHRINK) return _write(data, length);
+
+  // Decompress through a small buffer, the decoder keeps its state between chunks.
+  uint8_t buffer[CF_OTA_BUFFER_SIZE];
+  const uint8_t *input = data;
+  size_t produced;
+  do {
+    produced = _decoder->decode(input, length, buffer, sizeof(buffer));
+    if (produced == 0) continue;
+
+    // Anything that isn't heatshrink decodes to garbage, an image always starts with the magic byte.
+    if (_written == 0 && buffer[0] != 0xE9) {
+      _error = "Unknown image format.";
+      abort();
+      return false;
+    }
+    if (!_write(buffer, produced)) return false;
+  } while (produced == sizeof(buffer));
+  return true;
+}
+
+/**
+ * Write bytes to flash.
+ *
+ * @param data Bytes.
+ * @param length Bytes quantity.
+ * @returns True if all of them were written.
+ */
+bool CFOTAUpdate::_write(uint8_t *data, size_t length) {
+  if (Update.write(data, length) != length) return _fail();
+  _written += length;
+  return true;
+}
+
+/**
+ * Finish the update and check it.
+ * The new firmware is applied on the next restart.
+ *
+ * @returns True if it's ready to be applied.
+ */
+bool CFOTAUpdate::end() {
+  if (!_running) return false;
+  if (_encoding == UNKNOWN) {
+    _error = "Empty image.";
+    abort();
+    return false;
+  }
+  if (!Update.end(true)) return _fail();
+
+  _running = false;
+  _success = true;
+  _time = millis() - _tStart;
+  delete _decoder;
+  _decoder = NULL;
+  CF_LOG_NOTICE("Firmware update finished. Received: %lu bytes Written: %lu bytes Time: %lu ms (%lu bytes/s).",
+                _received, _written, _time, getThroughput());
+  return true;
+}
+
+/**
+ * Abort the update with the Updater error.
+ *
+ * @returns False.
+ */
+bool CFOTAUpdate::_fail() {
+  _error = Update.getErrorString();
+  abort();
+  return false;
+}
+
+/**
+ * Abort the update.
+ */
+void CFOTAUpdate::abort() {
+  if (!_running) return;
+  if (Update.isRunning()) Update.end(false);
+
+  _running = false;
+  _success = false;
+  _time = millis() - _tStart;
+  delete _decoder;
+  _decoder = NULL;
+  if (_error.length() == 0) _error = "Aborted.";
+  CF_LOG_WARNING("Firmware update failed: %s", _error.c_str());
+}
+
+/**
+ * True if an update is running.
+ *
+ * @returns True if it's running.
+ */
+bool CFOTAUpdate::isRunning() {
+  return _running;
+}
+
+/**
+ * True if the last update was successful.
+ *
+ * @returns True if it's ready to be applied.
+ */
+bool CFOTAUpdate::isSuccess() {
+  return _success;
+}
+
+/**
+ * Get image encoding.
+ *
+ * @returns Encoding of the last image.
+ */
+CFOTAUpdate::Encoding CFOTAUpdate::getEncoding() {
+  return _encoding;
+}
+
+/**
+ * Get last update error.
+ *
+ * @returns Error or empty if there is none.
+ */
+String CFOTAUpdate::getError() {
+  return _error;
+}
+
+/**
+ * Get bytes received.
+ *
+ * @returns Bytes of the image received.
+ */
+unsigned long CFOTAUpdate::getReceived() {
+  return _received;
+}
+
+/**
+ * Get bytes written to flash.
+ *
+ * @returns Bytes written, decompressed for heatshrink images.
+ */
+unsigned long CFOTAUpdate::getWritten() {
+  return _written;
+}
+
+/**
+ * Get time spent on the update.
+ *
+ * @returns Time in milliseconds.
+ */
+unsigned long CFOTAUpdate::getTime() {
+  return _running ? millis() - _tStart : _time;
+}
+
+/**
+ * Get bytes received per second.
+ *
+ * @returns Throughput in bytes per second.
+ */
+unsigned long CFOTAUpdate::getThroughput() {
+  unsigned long time = getTime();
+  return time > 0 ? (unsigned long)((uint64_t)_received * 1000 / time) : 0;
+}
+
+/**
+ * Get update result and metrics.
+ *
+ * @param report Object where the report is written.
+ */
+void CFOTAUpdate::getReport(JsonObject report) {
+  static const char *encodings[] = {"unknown", "raw", "gzip", "heatshrink"};
+  report["success"] = _success;
+  if (_error.length() > 0) report["error"] = _error;
+  report["encoding"] = encodings[_encoding];
+  report["received"] = _received;
+  report["written"] = _written;
+  report["time"] = getTime();
+  report["throughput"] = getThroughput();
+  if (_success) report["md5"] = Update.md5String();
+}
@@ -0,0 +1,91 @@
+/**
+ * CFOTAUpdate.h
+ *
+ * A library for Arduino that streams firmware images to the ESP8266 update partition.
+ *
+ * Images can be uploaded as they are, gzip compressed or heatshrink compressed, which cut the upload
+ * to about half over weak links. The encoding is detected from the first byte:
+ *    - 0xE9: uncompressed image, written as it is.
+ *    - 0x1F: gzip image, written as it is, the bootloader decompresses it when it's applied.
+ *    - Anything else: heatshrink image, decompressed on the fly through a 2^CF_OTA_HS_WINDOW_BITS
+ *      bytes window and written to flash CF_OTA_BUFFER_SIZE bytes at a time. It's rejected unless
+ *      it decompresses to an uncompressed image (0xE9), so unknown files never reach flash.
+ * If an MD5 is given, the image written to flash is checked against it before it's applied. That's
+ * the MD5 of the .bin for uncompressed and heatshrink images, and of the .bin.gz for gzip images.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFOTAUpdate_h
+#define CFOTAUpdate_h
+
+#include <Arduino.h>              // Arduino library.
+#include <ArduinoJson.h>          // Arduino JSON.
+#include <CFHeatshrinkDecoder.h>  // CF Heatshrink Decoder.
+#include <CFLog.h>                // CF Log.
+#include <new>                    // Non-throwing new.
+#include <Updater.h>              // ESP8266 Updater.
+
+#ifndef CF_OTA_HS_WINDOW_BITS
+#define CF_OTA_HS_WINDOW_BITS 11  // Heatshrink window bits (heatshrink -w).
+#endif
+
+#ifndef CF_OTA_HS_LOOKAHEAD_BITS
+#define CF_OTA_HS_LOOKAHEAD_BITS 4  // Heatshrink lookahead bits (heatshrink -l).
+#endif
+
+#ifndef CF_OTA_BUFFER_SIZE
+#define CF_OTA_BUFFER_SIZE 256  // Decompressed bytes written to flash at a time.
+#endif
+
+class CFOTAUpdate {
+ public:
+  // Encodings.
+  enum Encoding {
+    UNKNOWN,    // Nothing received yet.
+    RAW,        // Uncompressed image.
+    GZIP,       // Gzip image.
+    HEATSHRINK  // Heatshrink image.
+  };
+
+ private:
+  // Update.
+  Encoding _encoding;             // Image encoding.
+  CFHeatshrinkDecoder *_decoder;  // Heatshrink decoder, only while a heatshrink image is received.
+  String _md5;                    // Expected MD5 of the image written to flash.
+  bool _running;                  // Flag that indicates an update is running.
+  bool _success;                  // Flag that indicates the last update was successful.
+  String _error;                  // Last update error.
+
+  // Metrics.
+  unsigned long _received;  // Bytes received.
+  unsigned long _written;   // Bytes written to flash.
+  unsigned long _tStart;    // Time the update started.
+  unsigned long _time;      // Time spent on the update.
+
+  // Methods.
+  bool _detect(uint8_t first);                // Detect encoding and start writing.
+  bool _write(uint8_t *data, size_t length);  // Write bytes to flash.
+  bool _fail();                               // Abort the update with the Updater error.
+
+ public:
+  CFOTAUpdate();                             // Constructor.
+  ~CFOTAUpdate();                            // Destructor.
+  bool begin(String md5);                    // Start an update.
+  bool write(uint8_t *data, size_t length);  // Receive a chunk of the image.
+  bool end();                                // Finish the update and check it.
+  void abort();                              // Abort the update.
+  bool isRunning();                          // True if an update is running.
+  bool isSuccess();                          // True if the last update was successful.
+  Encoding getEncoding();                    // Get image encoding.
+  String getError();                         // Get last update error.
+  unsigned long getReceived();               // Get bytes received.
+  unsigned long getWritten();                // Get bytes written to flash.
+  unsigned long getTime();                   // Get time spent on the update.
+  unsigned long getThroughput();             // Get bytes received per second.
+  void getReport(JsonObject report);         // Get update result and metrics.
+};
+
+#endif
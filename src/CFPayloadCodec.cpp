@@ -0,0 +1,65 @@
+/**
+ * CFPayloadCodec.cpp
+ *
+ * A library for Arduino that encodes and decodes telemetry payloads as JSON or MessagePack.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFPayloadCodec.h>  // CF Payload Codec.
+
+/**
+ * Encode a document.
+ *
+ * @param doc Document.
+ * @param buffer Buffer where the payload is written.
+ * @param size Buffer size.
+ * @param encoding Encoding.
+ * @returns Payload length or 0 if it doesn't fit in the buffer.
+ */
+size_t CFPayloadCodec::encode(const JsonDocument &doc, uint8_t *buffer, size_t size, Encoding encoding) {
+  size_t length;
+  if (encoding == MSGPACK) {
+    if (measureMsgPack(doc) > size) return 0;
+    length = serializeMsgPack(doc, buffer, size);
+  } else {
+    if (measureJson(doc) >= size) return 0;
+    length = serializeJson(doc, (char *)buffer, size);
+  }
+  return length;
+}
+
+/**
+ * Detect payload encoding.
+ * Telemetry is always an object, which in JSON starts with '{' (ignoring white spaces) and in
+ * MessagePack with a map marker (0x80 to 0x8F, 0xDE or 0xDF).
+ *
+ * @param payload Payload.
+ * @param length Payload length.
+ * @returns Encoding.
+ */
+CFPayloadCodec::Encoding CFPayloadCodec::detect(const uint8_t *payload, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    uint8_t b = payload[i];
+    if (b == ' ' || b == '\t' || b == '\r' || b == '\n') continue;
+    return b == '{' ? JSON : MSGPACK;
+  }
+  return JSON;
+}
+
+/**
+ * Decode a payload, whatever its encoding is.
+ *
+ * @param payload Payload.
+ * @param length Payload length.
+ * @param doc Document where the payload is decoded.
+ * @returns Deserialization result.
+ */
+DeserializationError CFPayloadCodec::decode(const uint8_t *payload, size_t length, JsonDocument &doc) {
+  if (detect(payload, length) == MSGPACK) {
+    return deserializeMsgPack(doc, payload, length);
+  }
+  return deserializeJson(doc, payload, length);
+}
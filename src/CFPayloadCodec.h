@@ -0,0 +1,36 @@
+/**
+ * CFPayloadCodec.h
+ *
+ * A library for Arduino that encodes and decodes telemetry payloads as JSON or MessagePack.
+ *
+ * MessagePack payloads are about a third smaller than JSON for the usual sensor and relay data.
+ * ThingsBoard itself only accepts JSON, so binary payloads are meant for a local broker or gateway
+ * that decodes them back to JSON before forwarding.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFPayloadCodec_h
+#define CFPayloadCodec_h
+
+#include <ArduinoJson.h>  // Arduino JSON.
+
+class CFPayloadCodec {
+ public:
+  // Encodings.
+  enum Encoding {
+    JSON,    // JSON text.
+    MSGPACK  // MessagePack.
+  };
+
+  // Methods.
+  static size_t encode(const JsonDocument &doc, uint8_t *buffer, size_t size,  // Encode a document.
+                       Encoding encoding);
+  static Encoding detect(const uint8_t *payload, size_t length);                // Detect payload encoding.
+  static DeserializationError decode(const uint8_t *payload, size_t length,     // Decode a payload.
+                                     JsonDocument &doc);
+};
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * CFRPCRouter.cpp
+ *
+ * A library for Arduino that routes ThingsBoard RPC requests to their handlers.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFRPCRouter.h>  // CF RPC Router.
+
+/**
+ * Constructor.
+ */
+CFRPCRouter::CFRPCRouter() : _routesQty(0),
+                             _ready(false) {
+  CFJsonArena::addFixed("rpcrouter", sizeof(_request) + sizeof(_response));
+}
+
+/**
+ * Register a method handler.
+ * Must be called before begin().
+ *
+ * @param method Method name. It must live as long as the router does.
+ * @param handler Handler to be called when the method is requested.
+ * @returns True if it was registered.
+ */
+bool CFRPCRouter::addRoute(const char *method, RPCHandler handler) {
+  if (_routesQty >= CF_RPC_ROUTER_MAX_ROUTES) {
+    CF_LOG_WARNING("RPC router is full. Increase CF_RPC_ROUTER_MAX_ROUTES.");
+    return false;
+  }
+  _methods[_routesQty] = method;
+  _handlers[_routesQty] = handler;
+  _routesQty++;
+  _ready = false;
+  return true;
+}
+
+/**
+ * Build the perfect hash.
+ *
+ * Methods are spread in buckets by a first hash, then each bucket, from the largest to the smallest,
+ * gets a seed for a second hash that places all of its methods in free slots.
+ *
+ * @returns True if every method got its own slot.
+ */
+bool CFRPCRouter::begin() {
+  memset(_seeds, 0, sizeof(_seeds));
+  memset(_slots, 0, sizeof(_slots));
+
+  // Count methods per bucket.
+  uint8_t bucketSizes[_bucketsQty] = {0};
+  for (uint8_t i = 0; i < _routesQty; i++) {
+    bucketSizes[_hash(_methods[i], 0) & (_bucketsQty - 1)]++;
+  }
+
+  // Place the largest buckets first, while there are plenty of free slots.
+  for (uint8_t size = _routesQty; size > 0; size--) {
+    for (uint8_t bucket = 0; bucket < _bucketsQty; bucket++) {
+      if (bucketSizes[bucket] == size && !_placeBucket(bucket)) {
+        CF_LOG_ERROR("Fail building RPC router hash. Check for duplicated methods.");
+        return false;
+      }
+    }
+  }
+
+  _ready = true;
+  return true;
+}
+
+/**
+ * Find a seed that places a bucket with no collisions.
+ *
+ * @param bucket Bucket.
+ * @returns True if a seed was found.
+ */
+bool CFRPCRouter::_placeBucket(uint8_t bucket) {
+  uint8_t slots[CF_RPC_ROUTER_MAX_ROUTES];
+  for (uint16_t seed = 1; seed <= 0xFF; seed++) {
+    uint8_t placed = 0;
+    bool collided = false;
+    for (uint8_t i = 0; i < _routesQty && !collided; i++) {
+      if ((_hash(_methods[i], 0) & (_bucketsQty - 1)) != bucket) continue;
+
+      uint8_t slot = _hash(_methods[i], seed) & (_tableSize - 1);
+      collided = _slots[slot] != 0;
+      for (uint8_t j = 0; j < placed && !collided; j++) {
+        collided = slots[j] == slot;
+      }
+      slots[placed++] = slot;
+    }
+    if (collided) continue;
+
+    // Commit bucket.
+    placed = 0;
+    for (uint8_t i = 0; i < _routesQty; i++) {
+      if ((_hash(_methods[i], 0) & (_bucketsQty - 1)) != bucket) continue;
+      _slots[slots[placed++]] = i + 1;
+    }
+    _seeds[bucket] = seed;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * FNV-1a hash.
+ *
+ * @param key Key.
+ * @param seed Seed.
+ * @returns Hash.
+ */
+uint32_t CFRPCRouter::_hash(const char *key, uint32_t seed) {
+  uint32_t hash = 2166136261UL ^ (seed * 16777619UL);
+  while (*key) {
+    hash ^= (uint8_t)*key++;
+    hash *= 16777619UL;
+  }
+  return hash ^ (hash >> 16);  // Fold high bits, only the low ones index the table.
+}
+
+/**
+ * Get the route index of a method.
+ *
+ * @param method Method name.
+ * @returns Route index or -1 if it's not registered.
+ */
+int CFRPCRouter::find(const char *method) {
+  if (!_ready) return -1;
+  uint8_t seed = _seeds[_hash(method, 0) & (_bucketsQty - 1)];
+  uint8_t route = _slots[_hash(method, seed) & (_tableSize - 1)];
+  if (route == 0 || strcmp(_methods[route - 1], method) != 0) return -1;
+  return route - 1;
+}
+
+/**
+ * Handle a request and write the response.
+ * Requests that can't be handled are answered with {"error": "..."}, so the server isn't left waiting.
+ *
+ * @param payload Request payload ({"method": "...", "params": ...}).
+ * @param length Payload length.
+ * @param response Buffer where the serialized response is written.
+ * @param responseSize Response buffer size.
+ * @returns Response length or 0 if it doesn't fit in the buffer.
+ */
+size_t CFRPCRouter::dispatch(const char *payload, size_t length, char *response, size_t responseSize) {
+  DeserializationError error = deserializeJson(_request, payload, length);
+  if (error) {
+    CF_LOG_WARNING("Fail parsing RPC request: %s.", error.c_str());
+    return _error("invalid request", response, responseSize);
+  }
+
+  const char *method = _request["method"];
+  int route = method ? find(method) : -1;
+  if (route < 0) {
+    CF_LOG_WARNING("RPC method not found: %s.", method ? method : "");
+    return _error("method not found", response, responseSize);
+  }
+
+  _response.clear();
+  _handlers[route](_request["params"].as<JsonVariantConst>(), _response.to<JsonVariant>());
+  if (_response.overflowed() || measureJson(_response) >= responseSize) {
+    CF_LOG_WARNING("RPC response of %s is too large. Increase CF_RPC_ROUTER_DOC_SIZE.", method);
+    return _error("response too large", response, responseSize);
+  }
+  return serializeJson(_response, response, responseSize);
+}
+
+/**
+ * Write an error response.
+ *
+ * @param message Error message.
+ * @param response Buffer where the serialized response is written.
+ * @param responseSize Response buffer size.
+ * @returns Response length or 0 if it doesn't fit in the buffer.
+ */
+size_t CFRPCRouter::_error(const char *message, char *response, size_t responseSize) {
+  int responseLength = snprintf(response, responseSize, "{\"error\":\"%s\"}", message);
+  return responseLength > 0 && (size_t)responseLength < responseSize ? responseLength : 0;
+}
+
+/**
+ * True if the hash is built.
+ *
+ * @returns True if it's ready to dispatch.
+ */
+bool CFRPCRouter::isReady() {
+  return _ready;
+}
+
+/**
+ * Get registered routes quantity.
+ *
+ * @returns Routes quantity.
+ */
+uint8_t CFRPCRouter::getRoutesQty() {
+  return _routesQty;
+}
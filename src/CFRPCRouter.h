@@ -0,0 +1,74 @@
+/**
+ * CFRPCRouter.h
+ *
+ * A library for Arduino that routes ThingsBoard RPC requests to their handlers.
+ *
+ * Method names are indexed by a perfect hash built once in begin(), so finding the handler of a
+ * request costs two hashes and a single string compare no matter how many methods are registered.
+ * The request payload is parsed once into a document owned by the router and reused by every call.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFRPCRouter_h
+#define CFRPCRouter_h
+
+#include <ArduinoJson.h>  // Arduino JSON.
+#include <CFJsonArena.h>  // CF JSON Arena.
+#include <CFLog.h>        // CF Log.
+
+#ifndef CF_RPC_ROUTER_MAX_ROUTES
+#define CF_RPC_ROUTER_MAX_ROUTES 32  // Max methods quantity.
+#endif
+
+#ifndef CF_RPC_ROUTER_DOC_SIZE
+#define CF_RPC_ROUTER_DOC_SIZE 512  // Request and response documents size.
+#endif
+
+#if CF_RPC_ROUTER_MAX_ROUTES < 2 || CF_RPC_ROUTER_MAX_ROUTES > 64 || (CF_RPC_ROUTER_MAX_ROUTES & (CF_RPC_ROUTER_MAX_ROUTES - 1)) != 0
+#error "CF_RPC_ROUTER_MAX_ROUTES must be a power of two from 2 to 64."
+#endif
+
+class CFRPCRouter {
+ private:
+  // Aliases.
+  using RPCHandler = void (*)(JsonVariantConst params, JsonVariant response);  // Alias for RPC handler.
+
+  // Perfect hash sizes.
+  static const uint8_t _tableSize = 2 * CF_RPC_ROUTER_MAX_ROUTES;  // Slots quantity (power of two).
+  static const uint8_t _bucketsQty = CF_RPC_ROUTER_MAX_ROUTES / 2;  // Buckets quantity (power of two).
+
+  // Routes.
+  const char *_methods[CF_RPC_ROUTER_MAX_ROUTES];  // Method names.
+  RPCHandler _handlers[CF_RPC_ROUTER_MAX_ROUTES];  // Method handlers.
+  uint8_t _routesQty;                              // Registered routes quantity.
+
+  // Perfect hash.
+  uint8_t _seeds[_bucketsQty];  // Hash seed of each bucket.
+  uint8_t _slots[_tableSize];   // Route index + 1 of each slot, 0 when it's empty.
+  bool _ready;                  // Flag that indicates if the hash was built.
+
+  // Pooled documents.
+  StaticJsonDocument<CF_RPC_ROUTER_DOC_SIZE> _request;   // Request document.
+  StaticJsonDocument<CF_RPC_ROUTER_DOC_SIZE> _response;  // Response document.
+
+  // Methods.
+  static uint32_t _hash(const char *key, uint32_t seed);  // FNV-1a hash.
+  bool _placeBucket(uint8_t bucket);                      // Find a seed that places a bucket with no collisions.
+  static size_t _error(const char *message,               // Write an error response.
+                       char *response, size_t responseSize);
+
+ public:
+  CFRPCRouter();                                              // Constructor.
+  bool addRoute(const char *method, RPCHandler handler);      // Register a method handler.
+  bool begin();                                               // Build the perfect hash.
+  int find(const char *method);                               // Get the route index of a method.
+  size_t dispatch(const char *payload, size_t length,         // Handle a request and write the response.
+                  char *response, size_t responseSize);
+  bool isReady();                                             // True if the hash is built.
+  uint8_t getRoutesQty();                                     // Get registered routes quantity.
+};
+
+#endif
@@ -0,0 +1,293 @@
+/**
+ * CFRelayBankHelper.cpp
+ *
+ * A library for Arduino that drives a bank of relays, wired to GPIOs or to a 74HC595 chain.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFRelayBankHelper.h>  // CF Relay Bank Helper.
+
+/**
+ * Constructor for GPIOs.
+ *
+ * @param pins Pin of each channel. It must live as long as the helper does.
+ * @param channelsQty Channels quantity.
+ */
+CFRelayBankHelper::CFRelayBankHelper(const uint8_t *pins, uint8_t channelsQty) : _wiring(DIRECT),
+                                                                                 _channelsQty(min(channelsQty, (uint8_t)CF_RELAY_BANK_MAX_CHANNELS)),
+                                                                                 _pins(pins),
+                                                                                 _dataPin(-1),
+                                                                                 _clockPin(-1),
+                                                                                 _latchPin(-1),
+                                                                                 _activeLow(false),
+                                                                                 _shadow(0),
+                                                                                 _applied(0),
+                                                                                 _pulsing(0),
+                                                                                 _updatesQty(0),
+                                                                                 _updateTime(0) {
+}
+
+/**
+ * Constructor for a 74HC595 chain.
+ *
+ * @param dataPin Serial data pin (DS).
+ * @param clockPin Shift clock pin (SHCP).
+ * @param latchPin Latch clock pin (STCP).
+ * @param channelsQty Channels quantity (8 per chip).
+ */
+CFRelayBankHelper::CFRelayBankHelper(uint8_t dataPin, uint8_t clockPin, uint8_t latchPin, uint8_t channelsQty) : _wiring(SHIFT_REGISTER),
+                                                                                                                 _channelsQty(min(channelsQty, (uint8_t)CF_RELAY_BANK_MAX_CHANNELS)),
+                                                                                                                 _pins(NULL),
+                                                                                                                 _dataPin(dataPin),
+                                                                                                                 _clockPin(clockPin),
+                                                                                                                 _latchPin(latchPin),
+                                                                                                                 _activeLow(false),
+                                                                                                                 _shadow(0),
+                                                                                                                 _applied(0),
+                                                                                                                 _pulsing(0),
+                                                                                                                 _updatesQty(0),
+                                                                                                                 _updateTime(0) {
+}
+
+/**
+ * Initialize.
+ * Outputs are written right away, with every channel off. Levels are written before the pins are
+ * made outputs, so active-low relays don't click at boot.
+ */
+void CFRelayBankHelper::begin() {
+  if (_wiring == DIRECT) {
+    _write();
+    for (uint8_t i = 0; i < _channelsQty; i++) {
+      CFFastGPIO(_pins[i]).setMode(OUTPUT);
+    }
+  } else {
+    _dataPin.write(false);
+    _clockPin.write(false);
+    _latchPin.write(false);
+    _dataPin.setMode(OUTPUT);
+    _clockPin.setMode(OUTPUT);
+    _latchPin.setMode(OUTPUT);
+    _write();
+  }
+}
+
+/**
+ * End pulses and write changes.
+ * Every change made since the last call is written at once.
+ */
+void CFRelayBankHelper::loop() {
+  if (_pulsing != 0) {
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < _channelsQty; i++) {
+      uint32_t bit = 1UL << i;
+      if ((_pulsing & bit) && now - _pulseStart[i] >= _pulseTime[i]) {
+        _pulsing &= ~bit;
+        _shadow &= ~bit;
+      }
+    }
+  }
+  if (_shadow != _applied) _write();
+}
+
+/**
+ * Write the shadow register to the outputs.
+ */
+void CFRelayBankHelper::_write() {
+  unsigned long start = micros();
+  uint32_t levels = _activeLow ? ~_shadow : _shadow;
+
+  if (_wiring == DIRECT) {
+    // GPIO 0 to 15 share one register and are written at once, GPIO 16 has its own.
+    uint32_t high = 0;
+    uint32_t low = 0;
+    for (uint8_t i = 0; i < _channelsQty; i++) {
+      CFFastGPIO pin(_pins[i]);
+      bool level = levels & (1UL << i);
+      if (!pin.getMask()) {
+        pin.write(level);
+      } else if (level) {
+        high |= pin.getMask();
+      } else {
+        low |= pin.getMask();
+      }
+    }
+    CFFastGPIO::writeMasks(high, low);
+  } else {
+    // The last bit of the chain is shifted first.
+    _latchPin.write(false);
+    for (int8_t bit = ((_channelsQty + 7) & ~7) - 1; bit >= 0; bit--) {
+      _dataPin.write(levels & (1UL << bit));
+      _clockPin.write(true);
+      _clockPin.write(false);
+    }
+    _latchPin.write(true);
+  }
+
+  _applied = _shadow;
+  _updatesQty++;
+  _updateTime = micros() - start;
+}
+
+/**
+ * Set a channel.
+ * It's written on the next loop(), a pulse running on it is cancelled.
+ *
+ * @param channel Channel.
+ * @param value True to turn it on.
+ */
+void CFRelayBankHelper::set(uint8_t channel, bool value) {
+  if (channel >= _channelsQty) return;
+  setAll(value ? 1UL << channel : 0, 1UL << channel);
+}
+
+/**
+ * Set many channels.
+ * They are written on the next loop(), pulses running on them are cancelled.
+ *
+ * @param values Bit of each channel, 1 to turn it on.
+ * @param mask Bits of the channels to be set.
+ */
+void CFRelayBankHelper::setAll(uint32_t values, uint32_t mask) {
+  if (_channelsQty < 32) mask &= (1UL << _channelsQty) - 1;
+  _pulsing &= ~mask;
+  _shadow = (_shadow & ~mask) | (values & mask);
+}
+
+/**
+ * Toggle a channel.
+ *
+ * @param channel Channel.
+ */
+void CFRelayBankHelper::toggle(uint8_t channel) {
+  set(channel, !get(channel));
+}
+
+/**
+ * Turn a channel on for a while.
+ * A pulse restarts if it's called again before it ends.
+ *
+ * @param channel Channel.
+ * @param time Time it stays on (ms).
+ */
+void CFRelayBankHelper::pulse(uint8_t channel, unsigned long time) {
+  if (channel >= _channelsQty) return;
+  _shadow |= 1UL << channel;
+  _pulsing |= 1UL << channel;
+  _pulseStart[channel] = millis();
+  _pulseTime[channel] = time;
+}
+
+/**
+ * Get a channel.
+ *
+ * @param channel Channel.
+ * @returns True if it's on, or will be on the next loop().
+ */
+bool CFRelayBankHelper::get(uint8_t channel) {
+  return channel < _channelsQty && (_shadow & (1UL << channel));
+}
+
+/**
+ * Get all channels.
+ *
+ * @returns Bit of each channel, 1 when it's on.
+ */
+uint32_t CFRelayBankHelper::getAll() {
+  return _shadow;
+}
+
+/**
+ * True if there are changes to be written.
+ *
+ * @returns True if loop() will write the outputs.
+ */
+bool CFRelayBankHelper::isPending() {
+  return _shadow != _applied;
+}
+
+/**
+ * Set channels to be on with LOW.
+ * Most relay modules are. Call it before begin(), so the relays are never turned on at boot.
+ *
+ * @param activeLow True if the channels are on with LOW.
+ */
+void CFRelayBankHelper::setActiveLow(bool activeLow) {
+  _activeLow = activeLow;
+  _applied = ~_shadow;
+}
+
+/**
+ * Get channels quantity.
+ *
+ * @returns Channels quantity.
+ */
+uint8_t CFRelayBankHelper::getChannelsQty() {
+  return _channelsQty;
+}
+
+/**
+ * Handle an RPC that gets the channels.
+ * Response: [true, false, ...].
+ *
+ * @param params RPC params (not used).
+ * @param response Response.
+ */
+void CFRelayBankHelper::getRPC(JsonVariantConst params, JsonVariant response) {
+  JsonArray channels = response.to<JsonArray>();
+  for (uint8_t i = 0; i < _channelsQty; i++) {
+    channels.add(get(i));
+  }
+}
+
+/**
+ * Handle an RPC that sets the channels.
+ * Every channel of the request is written together on the next loop().
+ * Params:
+ *    - [true, false, ...]: channels from 0.
+ *    - {"0": true, "3": false, "5": 500}: the given channels, a number pulses it for that many ms.
+ *      Any other value is skipped.
+ * Response: the channels, as getRPC().
+ *
+ * @param params RPC params.
+ * @param response Response.
+ */
+void CFRelayBankHelper::setRPC(JsonVariantConst params, JsonVariant response) {
+  if (params.is<JsonArrayConst>()) {
+    uint8_t channel = 0;
+    for (JsonVariantConst value : params.as<JsonArrayConst>()) {
+      set(channel++, value.as<bool>());
+    }
+  } else if (params.is<JsonObjectConst>()) {
+    for (JsonPairConst channel : params.as<JsonObjectConst>()) {
+      char *end;
+      long index = strtol(channel.key().c_str(), &end, 10);
+      if (*end != '\0' || index < 0 || index >= _channelsQty) {
+        CF_LOG_WARNING("Invalid relay channel: %s", channel.key().c_str());
+        continue;
+      }
+      JsonVariantConst value = channel.value();
+      if (value.is<bool>()) {
+        set(index, value.as<bool>());
+      } else if (value.is<unsigned long>()) {
+        pulse(index, value.as<unsigned long>());
+      } else {
+        CF_LOG_WARNING("Invalid relay value: %s", channel.key().c_str());
+      }
+    }
+  }
+  getRPC(params, response);
+}
+
+/**
+ * Get metrics.
+ *
+ * @param metrics Object where the metrics are written.
+ */
+void CFRelayBankHelper::getMetrics(JsonObject metrics) {
+  metrics["relays_state"] = _applied;
+  metrics["relays_updates_qty"] = _updatesQty;
+  metrics["relays_update_time"] = _updateTime;
+}
@@ -0,0 +1,90 @@
+/**
+ * CFRelayBankHelper.h
+ *
+ * A library for Arduino that drives a bank of relays, wired to GPIOs or to a 74HC595 chain.
+ *
+ * Channel changes only touch a shadow register. loop() writes all of the changes made since the
+ * last call at once: a single shift-out and latch for 74HC595 chains, or a single write of the GPIO
+ * registers for GPIOs. Channels can also be pulsed, they go back off by themselves in loop().
+ *
+ * From ThingsBoard, the RPC handlers set or pulse any number of channels in one call, e.g. with
+ * CFRPCRouter:
+ *
+ *    _cfRPCRouter.addRoute("setRelays", [](JsonVariantConst params, JsonVariant response) {
+ *      _relays.setRPC(params, response);
+ *    });
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFRelayBankHelper_h
+#define CFRelayBankHelper_h
+
+#include <Arduino.h>      // Arduino library.
+#include <ArduinoJson.h>  // Arduino JSON.
+#include <CFFastGPIO.h>   // CF Fast GPIO.
+#include <CFLog.h>        // CF Log.
+
+#ifndef CF_RELAY_BANK_MAX_CHANNELS
+#define CF_RELAY_BANK_MAX_CHANNELS 32  // Max channels quantity (bits of the shadow register).
+#endif
+
+#if CF_RELAY_BANK_MAX_CHANNELS > 32
+#error "CF_RELAY_BANK_MAX_CHANNELS can't be more than 32."
+#endif
+
+class CFRelayBankHelper {
+ public:
+  // Wirings.
+  enum Wiring {
+    DIRECT,         // A GPIO per channel.
+    SHIFT_REGISTER  // 74HC595 chain, channel 0 is bit 0 of the chip next to the ESP.
+  };
+
+ private:
+  // Wiring.
+  Wiring _wiring;        // Wiring.
+  uint8_t _channelsQty;  // Channels quantity.
+  const uint8_t *_pins;  // Pin of each channel (DIRECT).
+  CFFastGPIO _dataPin;   // Serial data pin (SHIFT_REGISTER).
+  CFFastGPIO _clockPin;  // Shift clock pin (SHIFT_REGISTER).
+  CFFastGPIO _latchPin;  // Latch clock pin (SHIFT_REGISTER).
+  bool _activeLow;       // Flag that indicates channels are on with LOW.
+
+  // Channels.
+  uint32_t _shadow;                                       // Channels state to be written.
+  uint32_t _applied;                                      // Channels state written.
+  uint32_t _pulsing;                                      // Channels being pulsed.
+  unsigned long _pulseStart[CF_RELAY_BANK_MAX_CHANNELS];  // Time each pulse started.
+  unsigned long _pulseTime[CF_RELAY_BANK_MAX_CHANNELS];   // Time each pulse lasts.
+
+  // Metrics.
+  unsigned long _updatesQty;  // Writes to the outputs.
+  unsigned long _updateTime;  // Time of the last write to the outputs (us).
+
+  // Methods.
+  void _write();  // Write the shadow register to the outputs.
+
+ public:
+  CFRelayBankHelper(const uint8_t *pins, uint8_t channelsQty);  // Constructor for GPIOs.
+  CFRelayBankHelper(uint8_t dataPin, uint8_t clockPin,          // Constructor for a 74HC595 chain.
+                    uint8_t latchPin, uint8_t channelsQty);
+  void begin();                                                 // Initialize.
+  void loop();                                                  // End pulses and write changes.
+  void set(uint8_t channel, bool value);                        // Set a channel.
+  void setAll(uint32_t values, uint32_t mask = 0xFFFFFFFF);     // Set many channels.
+  void toggle(uint8_t channel);                                 // Toggle a channel.
+  void pulse(uint8_t channel, unsigned long time);              // Turn a channel on for a while.
+  bool get(uint8_t channel);                                    // Get a channel.
+  uint32_t getAll();                                            // Get all channels.
+  bool isPending();                                             // True if there are changes to be written.
+  void setActiveLow(bool activeLow);                            // Set channels to be on with LOW.
+  uint8_t getChannelsQty();                                     // Get channels quantity.
+  void getRPC(JsonVariantConst params, JsonVariant response);   // Handle an RPC that gets the channels.
+  void setRPC(JsonVariantConst params, JsonVariant response);   // Handle an RPC that sets the channels.
+  void getMetrics(JsonObject metrics);                          // Get metrics.
+};
+
+#endif
@@ -0,0 +1,218 @@
+/**
+ * CFRollingStats.cpp
+ *
+ * Windowed statistics for CF Arduino Devices sensor values.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFRollingStats.h>  // CF Rolling Stats.
+
+#define CF_STATS_MAX_FIXED 10000000L  // Max sample magnitude in tenths, keeps the sum of squares of a full window in 64 bits.
+
+/**
+ * Constructor.
+ *
+ * @param window Window length.
+ */
+CFRollingStats::CFRollingStats(unsigned long window) : _filter(false),
+                                                       _recentQty(0),
+                                                       _recentNext(0),
+                                                       _window(window),
+                                                       _tWindow(0),
+                                                       _count(0),
+                                                       _sum(0),
+                                                       _sumSquares(0),
+                                                       _min(0),
+                                                       _max(0),
+                                                       _available(false),
+                                                       _lastCount(0),
+                                                       _lastMean(0),
+                                                       _lastMin(0),
+                                                       _lastMax(0),
+                                                       _lastVariance(0) {
+}
+
+/**
+ * Close the window if its time has passed, even when samples stop coming.
+ * Call it on every loop, so the aggregates of the last samples aren't held back.
+ */
+void CFRollingStats::loop() {
+  if (_count > 0 && millis() - _tWindow >= _window) _close();
+}
+
+/**
+ * Add a sample.
+ *
+ * @param value Value, rounded to tenths. NaN is ignored.
+ */
+void CFRollingStats::add(float value) {
+  if (isnan(value)) return;
+  addFixed(lroundf(constrain(value * 10, -(float)CF_STATS_MAX_FIXED, (float)CF_STATS_MAX_FIXED)));
+}
+
+/**
+ * Add a sample in tenths.
+ *
+ * @param value Value in tenths, clamped to +-1000000.0.
+ */
+void CFRollingStats::addFixed(int32_t value) {
+  value = constrain(value, -CF_STATS_MAX_FIXED, CF_STATS_MAX_FIXED);
+
+  // Close the window if its time has passed.
+  loop();
+  if (_count == 0) _tWindow = millis();
+
+  // Spike filter.
+  _recent[_recentNext] = value;
+  _recentNext = (_recentNext + 1) % 5;
+  if (_recentQty < 5) _recentQty++;
+  if (_filter) value = _median();
+
+  // Aggregate.
+  if (_count == 0 || value < _min) _min = value;
+  if (_count == 0 || value > _max) _max = value;
+  _sum += value;
+  _sumSquares += (int64_t)value * value;
+  _count++;
+
+  // Avoid overflowing the counter on long windows.
+  if (_count == 0xFFFF) _close();
+}
+
+/**
+ * Median of the last samples.
+ *
+ * @returns Median.
+ */
+int32_t CFRollingStats::_median() {
+  int32_t sorted[5];
+  memcpy(sorted, _recent, sizeof(int32_t) * _recentQty);
+  for (uint8_t i = 1; i < _recentQty; i++) {
+    int32_t value = sorted[i];
+    int8_t j = i - 1;
+    while (j >= 0 && sorted[j] > value) {
+      sorted[j + 1] = sorted[j];
+      j--;
+    }
+    sorted[j + 1] = value;
+  }
+  return sorted[_recentQty / 2];
+}
+
+/**
+ * Close current window, keeping its aggregates until they are taken.
+ */
+void CFRollingStats::_close() {
+  int64_t half = _sum >= 0 ? _count / 2 : -(int64_t)(_count / 2);
+  _lastCount = _count;
+  _lastMean = (_sum + half) / (int64_t)_count;
+  _lastMin = _min;
+  _lastMax = _max;
+
+  // Variance in integers: n * variance = sumSquares - sum^2 / n. The square of the sum doesn't fit in
+  // 64 bits, so sum^2 / n is split as sum * (sum / n) + sum * (sum % n) / n.
+  uint64_t n = _count;
+  uint64_t sum = _sum >= 0 ? _sum : -_sum;
+  uint64_t remainder = sum % n * sum;
+  uint64_t scaled = _sumSquares - sum * (sum / n) - remainder / n;  // n * variance + (remainder % n) / n.
+  _lastVariance = scaled / n + (2 * (scaled % n) * n >= 2 * (remainder % n) + n * n ? 1 : 0);
+  _available = true;
+
+  _count = 0;
+  _sum = 0;
+  _sumSquares = 0;
+}
+
+/**
+ * Enable or disable median of 5 filter.
+ *
+ * @param filter True to filter spikes.
+ */
+void CFRollingStats::setSpikeFilter(bool filter) {
+  _filter = filter;
+}
+
+/**
+ * Define window length.
+ *
+ * @param window Window length.
+ */
+void CFRollingStats::setWindow(unsigned long window) {
+  _window = window;
+}
+
+/**
+ * True if a window was closed and its aggregates were not taken yet.
+ *
+ * @returns True if aggregates are available.
+ */
+bool CFRollingStats::available() {
+  return _available;
+}
+
+/**
+ * Take aggregates of the last window, as <key>_mean, <key>_min, <key>_max and <key>_variance.
+ *
+ * @param snapshot Object where the aggregates are written.
+ * @param key Key prefix.
+ */
+void CFRollingStats::getSnapshot(JsonObject snapshot, const char *key) {
+  char name[32];
+  snprintf(name, sizeof(name), "%s_mean", key);
+  snapshot[name] = getMean();
+  snprintf(name, sizeof(name), "%s_min", key);
+  snapshot[name] = getMin();
+  snprintf(name, sizeof(name), "%s_max", key);
+  snapshot[name] = getMax();
+  snprintf(name, sizeof(name), "%s_variance", key);
+  snapshot[name] = getVariance();
+  _available = false;
+}
+
+/**
+ * Get mean of the last window.
+ *
+ * @returns Mean.
+ */
+float CFRollingStats::getMean() {
+  return _lastMean / 10.0f;
+}
+
+/**
+ * Get min of the last window.
+ *
+ * @returns Min.
+ */
+float CFRollingStats::getMin() {
+  return _lastMin / 10.0f;
+}
+
+/**
+ * Get max of the last window.
+ *
+ * @returns Max.
+ */
+float CFRollingStats::getMax() {
+  return _lastMax / 10.0f;
+}
+
+/**
+ * Get variance of the last window.
+ *
+ * @returns Variance.
+ */
+float CFRollingStats::getVariance() {
+  return _lastVariance / 100.0f;
+}
+
+/**
+ * Get samples of the last window.
+ *
+ * @returns Samples quantity.
+ */
+uint16_t CFRollingStats::getCount() {
+  return _lastCount;
+}
@@ -0,0 +1,68 @@
+/**
+ * CFRollingStats.h
+ *
+ * Windowed statistics for CF Arduino Devices sensor values.
+ *
+ * Samples are kept in fixed point (tenths) and aggregated in O(1) per sample into mean, min, max
+ * and variance of a time window. When the window ends its aggregates are kept until they are taken,
+ * so they can be published instead of every raw sample. Windows are closed by loop() too, so the
+ * last samples before a sensor stops aren't held back. An optional median of 5 filter removes
+ * single-sample spikes before they reach the aggregates.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFRollingStats_h
+#define CFRollingStats_h
+
+#include <Arduino.h>      // Arduino library.
+#include <ArduinoJson.h>  // Arduino JSON.
+
+class CFRollingStats {
+ private:
+  // Spike filter.
+  bool _filter;         // Flag that indicates if the median of 5 filter is enabled.
+  int32_t _recent[5];   // Last samples.
+  uint8_t _recentQty;   // Last samples quantity.
+  uint8_t _recentNext;  // Position of the next sample.
+
+  // Current window.
+  unsigned long _window;   // Window length.
+  unsigned long _tWindow;  // Time the window started.
+  uint16_t _count;         // Samples in the window.
+  int64_t _sum;            // Sum of samples.
+  int64_t _sumSquares;     // Sum of squared samples.
+  int32_t _min;            // Min sample.
+  int32_t _max;            // Max sample.
+
+  // Last closed window.
+  bool _available;         // Flag that indicates there are aggregates not taken yet.
+  uint16_t _lastCount;     // Samples.
+  int32_t _lastMean;       // Mean.
+  int32_t _lastMin;        // Min.
+  int32_t _lastMax;        // Max.
+  uint64_t _lastVariance;  // Variance (hundredths).
+
+  // Methods.
+  int32_t _median();  // Median of the last samples.
+  void _close();      // Close current window.
+
+ public:
+  CFRollingStats(unsigned long window);                    // Constructor.
+  void loop();                                             // Close the window if its time has passed.
+  void add(float value);                                   // Add a sample.
+  void addFixed(int32_t value);                            // Add a sample in tenths.
+  void setSpikeFilter(bool filter);                        // Enable or disable median of 5 filter.
+  void setWindow(unsigned long window);                    // Define window length.
+  bool available();                                        // True if a window was closed and not taken yet.
+  void getSnapshot(JsonObject snapshot, const char *key);  // Take aggregates of the last window.
+  float getMean();                                         // Get mean of the last window.
+  float getMin();                                          // Get min of the last window.
+  float getMax();                                          // Get max of the last window.
+  float getVariance();                                     // Get variance of the last window.
+  uint16_t getCount();                                     // Get samples of the last window.
+};
+
+#endif
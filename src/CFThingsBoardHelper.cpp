@@ -13,54 +13,97 @@
 /**
  * Constructor.
  */
-CFThingsBoardHelper::CFThingsBoardHelper(String appCode, String appVersion) : _wifiClient(),
-                                                                              _thingsBoard(_wifiClient),
+CFThingsBoardHelper::CFThingsBoardHelper(String appCode, String appVersion) : _mqttClient(),
+                                                                              _thingsBoard(_mqttClient),
+                                                                              _serverPort(1883),
+                                                                              _payloadEncoding(CFPayloadCodec::JSON),
+                                                                              _deviceId(0),
                                                                               _ttRetry(60000),
                                                                               _ttSend(60000),
-                                                                              _data(64),
-                                                                              _attributes(1024),
+                                                                              _tLastSent(0),
+                                                                              _tLastAttempt(0),
+                                                                              _sendPending(true),
+                                                                              _connectFailed(false),
+                                                                              _data(CF_TB_TELEMETRY_SIZE),
+                                                                              _attributes(CF_TB_ATTRIBUTES_SIZE),
                                                                               _TBconnected(false),
+                                                                              _watchdogReported(false),
+                                                                              _identityHash(0),
+                                                                              _connectTime(0),
+                                                                              _publishedQty(0),
+                                                                              _droppedQty(0),
+                                                                              _overflowQty(0),
+                                                                              _encodeTime(0),
+                                                                              _deadbandsQty(0),
+                                                                              _lanPublisher(NULL),
+                                                                              _tLanLastSent(0),
+                                                                              _lanPending(true),
+                                                                              _lanFailed(false),
+                                                                              _tLanLastFailed(0),
+                                                                              _attributeCache(NULL),
+                                                                              _onThingsBoardConnectCallback(NULL),
                                                                               _appCode(appCode),
                                                                               _appVersion(appVersion) {
+  CFJsonArena::addFixed("thingsboard", CF_TB_TELEMETRY_SIZE + CF_TB_ATTRIBUTES_SIZE);
 }
 
 /**
  * Loop.
  */
 void CFThingsBoardHelper::loop() {
+  // Write what's queued.
+  _mqttClient.loop();
+
+  // Local network doesn't depend on ThingsBoard, it keeps getting the values while the cloud is down.
+  _publishLan();
+
   // Check if it's disconnected.
   if (!_thingsBoard.connected()) {
     _TBconnected = false;
     // Check the last attempt.
-    if (_tLastSent == 0 || (millis() - _tLastSent) > _ttRetry) {
+    if (!_connectFailed || (millis() - _tLastAttempt) > _ttRetry) {
       // Connect to ThingsBoard.
-      Logger::notice("Connecting to Things Board node.");
-      Logger::verbose("ServerURL: " + _serverURL);
-      Logger::verbose("Token: " + _token);
+      CF_LOG_NOTICE("Connecting to Things Board node.");
+      CF_LOG_VERBOSE("ServerURL: %s", _serverURL.c_str());
+      CF_LOG_VERBOSE("Token: %s", _token.c_str());
 
       char serverURL[50];
       strcpy(serverURL, _serverURL.c_str());
       char token[50];
       strcpy(token, _token.c_str());
-      if (_thingsBoard.connect(serverURL, token)) {
+      char espChipId[9];
+      sprintf(espChipId, "%06X", getDeviceId());
+      char clientId[12];
+      sprintf(clientId, "cf-%s", espChipId);
+      unsigned long tConnect = millis();
+      bool connected;
+      {
+        CF_WATCHDOG_SECTION("tb_connect");
+        connected = _thingsBoard.connect(serverURL, token, _serverPort, clientId);
+      }
+      _connectTime = millis() - tConnect;
+      if (connected) {
         _TBconnected = true;
-        // Get chip id.
-        char espChipId[6];
-        sprintf(espChipId, "%06X", ESP.getChipId());
+        _connectFailed = false;
+        _sendPending = true;
 
         // Send attributes to ThingsBoard.
-        _thingsBoard.sendAttributeString("app_code", _appCode.c_str());
-        _thingsBoard.sendAttributeString("app_version", _appVersion.c_str());
-        _thingsBoard.sendAttributeString("device_chip_id", espChipId);
-        _thingsBoard.sendAttributeString("device_local_ip", _localIP.c_str());
+        _sendIdentity(espChipId);
+        if (!_watchdogReported) _sendWatchdogReport();
+
+        // Check the cached shared attributes.
+        if (_attributeCache && !_mqttClient.requestAttributes()) {
+          CF_LOG_WARNING("Fail requesting shared attributes.");
+        }
 
         // Call on ThingsBoard connect callback.
         if (_onThingsBoardConnectCallback) {
           _onThingsBoardConnectCallback();
         }
       } else {
-        Logger::warning("Fail connecting Things Board. Retrying in " + String(_ttRetry / 1000) + " second(s).");
-        _tLastSent = millis();
+        CF_LOG_WARNING("Fail connecting Things Board. Retrying in %lu second(s).", _ttRetry / 1000);
+        _connectFailed = true;
+        _tLastAttempt = millis();
         return;
       }
     } else {
@@ -69,16 +112,24 @@ void CFThingsBoardHelper::loop() {
     }
   }
 
+  // Hold data back while the network doesn't keep up, it's sent once the queue drains.
+  if (_mqttClient.isBackpressured()) {
+    _thingsBoard.loop();
+    return;
+  }
+
   // Check the last submission.
-  if (_tLastSent == 0 || (millis() - _tLastSent) > _ttSend) {
-    Logger::notice("Sending data to Things Board.");
+  bool periodic = _sendPending || (millis() - _tLastSent) > _ttSend;
+  if (periodic || _isDeadbandDue()) {
+    CF_LOG_NOTICE("Sending data to Things Board.");
 
     // Send telemetry.
-    char serializedJson[64];
-    serializeJson(_data, serializedJson);
-    if (strlen(serializedJson) > 4) {
-      _thingsBoard.sendTelemetryJson(serializedJson);
-    }
+    _sendTelemetry(periodic);
+  }
+
+  if (periodic) {
+    // Retry the watchdog report if it couldn't be sent on connect.
+    if (!_watchdogReported) _sendWatchdogReport();
 
     // Send attributes.
     for (JsonPair p : _attributes.as<JsonObject>()) {
@@ -92,11 +143,225 @@ void CFThingsBoardHelper::loop() {
     }
     // Update last sent time.
     _tLastSent = millis();
+    _sendPending = false;
   }
 
   _thingsBoard.loop();
 }
 
+/**
+ * Send telemetry.
+ * Keys with deadband are only sent when they are due, the others only on periodic submissions.
+ *
+ * @param periodic True if it's the periodic submission.
+ */
+void CFThingsBoardHelper::_sendTelemetry(bool periodic) {
+  unsigned long start = micros();
+  CFJsonScratch telemetry(CF_TB_TELEMETRY_SIZE, CFJsonArenaAllocator("thingsboard"));
+  unsigned long now = millis();
+  bool included[CF_TB_MAX_DEADBANDS] = {false};  // Deadbands in this message.
+  float values[CF_TB_MAX_DEADBANDS];              // Values of the deadbands in this message.
+  for (JsonPair p : _data.as<JsonObject>()) {
+    Deadband *deadband = _findDeadband(p.key().c_str());
+    if (!deadband) {
+      if (periodic) telemetry[p.key()] = p.value();
+      continue;
+    }
+    if (deadband->pending || (deadband->heartbeat > 0 ? (now - deadband->tLastSent) >= deadband->heartbeat : periodic)) {
+      telemetry[p.key()] = p.value();
+      included[deadband - _deadbands] = true;
+      values[deadband - _deadbands] = p.value().is<bool>() ? p.value().as<bool>() : p.value().as<float>();
+    }
+  }
+  if (telemetry.size() == 0) return;
+  if (telemetry.overflowed()) _overflow("telemetry");
+  CF_WATCHDOG_SECTION("tb_publish");
+
+  bool sent = false;
+  if (_payloadEncoding == CFPayloadCodec::MSGPACK) {
+    // Binary payloads don't go through ThingsBoard, that only accepts JSON, but to the bridge topic.
+    uint8_t payload[CF_TB_PAYLOAD_SIZE];
+    size_t length = CFPayloadCodec::encode(telemetry, payload, sizeof(payload), CFPayloadCodec::MSGPACK);
+    _encodeTime = micros() - start;
+    if (length == 0) {
+      CF_LOG_WARNING("Telemetry doesn't fit in a payload, it was dropped. Increase CF_TB_PAYLOAD_SIZE.");
+      _droppedQty++;
+    } else {
+      sent = _mqttClient.publish(_payloadTopic.c_str(), payload, length);
+    }
+  } else {
+    // A truncated JSON would be rejected by ThingsBoard anyway.
+    char serializedJson[CF_TB_PAYLOAD_SIZE];
+    size_t length = serializeJson(telemetry, serializedJson);
+    _encodeTime = micros() - start;
+    if (length == sizeof(serializedJson) - 1) length = measureJson(telemetry);
+    if (length >= sizeof(serializedJson)) {
+      CF_LOG_WARNING("Telemetry doesn't fit in a payload (%u bytes), it was dropped. Increase CF_TB_PAYLOAD_SIZE.", length);
+      _droppedQty++;
+    } else {
+      sent = _thingsBoard.sendTelemetryJson(serializedJson);
+    }
+  }
+
+  // Deadbands only move on once their values are sent, otherwise they are still due on the next loop.
+  if (sent) {
+    _publishedQty++;
+    for (uint8_t i = 0; i < _deadbandsQty; i++) {
+      if (!included[i]) continue;
+      _deadbands[i].lastValue = values[i];
+      _deadbands[i].tLastSent = now;
+      _deadbands[i].pending = false;
+    }
+  }
+}
+
+/**
+ * Broadcast the telemetry values to the local network.
+ * It has its own schedule: every submission interval, and right away when a key with deadband changes
+ * or sendData() is called. Frames carry every value and have their own size limit, so they go out
+ * whether the MQTT message was sent, dropped or not even tried. A frame that can't be sent (e.g.
+ * Wi-Fi is down) is tried again every CF_TB_LAN_RETRY_TIME, and nothing is taken as broadcast until
+ * one is.
+ */
+void CFThingsBoardHelper::_publishLan() {
+  if (!_lanPublisher || _data.size() == 0) return;
+  if (!_lanPending && (millis() - _tLanLastSent) < _ttSend) return;
+  if (_lanFailed && (millis() - _tLanLastFailed) < CF_TB_LAN_RETRY_TIME) return;
+
+  if (!_lanPublisher->publish(_data)) {
+    _lanPending = true;
+    _lanFailed = true;
+    _tLanLastFailed = millis();
+    return;
+  }
+  _tLanLastSent = millis();
+  _lanPending = false;
+  _lanFailed = false;
+  for (uint8_t i = 0; i < _deadbandsQty; i++) {
+    JsonVariantConst value = _data[_deadbands[i].key];
+    _deadbands[i].lanValue = value.isNull() ? NAN : value.is<bool>() ? value.as<bool>() : value.as<float>();
+  }
+}
+
+/**
+ * Send the identity attributes, only if they changed since they were last sent.
+ * ThingsBoard keeps them, so reconnections don't have to send them again.
+ *
+ * @param espChipId Device id as sent in device_chip_id.
+ */
+void CFThingsBoardHelper::_sendIdentity(const char *espChipId) {
+  CFJsonScratch identity(256, CFJsonArenaAllocator("thingsboard"));
+  identity["app_code"] = _appCode;
+  identity["app_version"] = _appVersion;
+  identity["device_chip_id"] = espChipId;
+  identity["device_local_ip"] = _localIP;
+  char serializedJson[CF_TB_PAYLOAD_SIZE];
+  size_t length = serializeJson(identity, serializedJson);
+
+  // FNV-1a hash.
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ (uint8_t)serializedJson[i]) * 16777619UL;
+  }
+  if (hash == _identityHash) {
+    CF_LOG_VERBOSE("Identity attributes didn't change.");
+    return;
+  }
+  if (_thingsBoard.sendAttributeJSON(serializedJson)) _identityHash = hash;
+}
+
+/**
+ * Send the watchdog report of the last boot, once.
+ * If it can't be sent it's tried again on the next periodic submission.
+ */
+void CFThingsBoardHelper::_sendWatchdogReport() {
+  if (!CFWatchdog::hasReport()) {
+    _watchdogReported = true;
+    return;
+  }
+
+  CFJsonScratch report(256, CFJsonArenaAllocator("thingsboard"));
+  CFWatchdog::getReport(report.to<JsonObject>());
+  char serializedJson[CF_TB_PAYLOAD_SIZE];
+  size_t length = serializeJson(report, serializedJson);
+  if (length == sizeof(serializedJson) - 1) length = measureJson(report);
+  if (length >= sizeof(serializedJson)) {
+    CF_LOG_WARNING("Watchdog report doesn't fit in a payload (%u bytes), it was dropped. Increase CF_TB_PAYLOAD_SIZE.", length);
+    _watchdogReported = true;
+    return;
+  }
+  _watchdogReported = _thingsBoard.sendTelemetryJson(serializedJson);
+}
+
+/**
+ * Count a value that didn't fit in a document, warning the first time.
+ *
+ * @param document Document name.
+ */
+void CFThingsBoardHelper::_overflow(const char *document) {
+  if (_overflowQty++ == 0) {
+    CF_LOG_WARNING("Some %s values don't fit and were left out. Increase its document size.", document);
+  }
+}
+
+/**
+ * Find the deadband of a telemetry key.
+ *
+ * @param key Key.
+ * @returns Deadband or NULL if the key has none.
+ */
+CFThingsBoardHelper::Deadband *CFThingsBoardHelper::_findDeadband(const char *key) {
+  for (uint8_t i = 0; i < _deadbandsQty; i++) {
+    if (_deadbands[i].key == key) return &_deadbands[i];
+  }
+  return NULL;
+}
+
+/**
+ * Check a new value against its key deadband.
+ * ThingsBoard and the local network are checked against the last value each of them got.
+ *
+ * @param key Key.
+ * @param value New value.
+ */
+void CFThingsBoardHelper::_updateDeadband(String key, float value) {
+  Deadband *deadband = _findDeadband(key.c_str());
+  if (!deadband) return;
+
+  if (!deadband->pending && _isOutOfDeadband(*deadband, deadband->lastValue, value)) deadband->pending = true;
+  if (_isOutOfDeadband(*deadband, deadband->lanValue, value)) _lanPending = true;
+}
+
+/**
+ * True if a value is out of the deadband around a reference.
+ * Around a reference of 0 the percentual threshold is 0 too, so any change is out of it, but a value
+ * that stays at 0 never is.
+ *
+ * @param deadband Deadband.
+ * @param reference Reference value, NaN if there is none yet.
+ * @param value Value.
+ * @returns True if it must be sent.
+ */
+bool CFThingsBoardHelper::_isOutOfDeadband(const Deadband &deadband, float reference, float value) {
+  float delta = fabs(value - reference);
+  return isnan(reference) ||
+         (deadband.absolute > 0 && delta >= deadband.absolute) ||
+         (deadband.percent > 0 && delta > 0 && delta >= fabs(reference) * deadband.percent / 100);
+}
+
+/**
+ * True if any key with deadband must be sent.
+ */
+bool CFThingsBoardHelper::_isDeadbandDue() {
+  unsigned long now = millis();
+  for (uint8_t i = 0; i < _deadbandsQty; i++) {
+    Deadband &deadband = _deadbands[i];
+    if (deadband.pending) return true;
+    if (deadband.heartbeat > 0 && !isnan(deadband.lastValue) && (now - deadband.tLastSent) >= deadband.heartbeat) return true;
+  }
+  return false;
+}
+
 /**
  * Subscribe to attr.
  *
@@ -105,10 +370,10 @@ void CFThingsBoardHelper::loop() {
  */
 void CFThingsBoardHelper::ATTRSubscribe(const Shared_Attribute_Callback* callbacks, size_t size) {
   if (!_thingsBoard.Shared_Attributes_Subscribe(callbacks, size)) {
-    Logger::warning("Fail subscribing to attributes.");
+    CF_LOG_WARNING("Fail subscribing to attributes.");
     return;
   }
-  Logger::notice("Subscribed to Shared Attributes.");
+  CF_LOG_NOTICE("Subscribed to Shared Attributes.");
 }
 
 /**
@@ -119,10 +384,29 @@ void CFThingsBoardHelper::ATTRSubscribe(const Shared_Attribute_Callback* callbac
  */
 void CFThingsBoardHelper::RPCSubscribe(const RPC_Callback* callbacks, size_t size) {
   if (!_thingsBoard.RPC_Subscribe(callbacks, size)) {
-    Logger::warning("Fail subscribing to RPC.");
+    CF_LOG_WARNING("Fail subscribing to RPC.");
     return;
   }
-  Logger::notice("Subscribed to RPC.");
+  CF_LOG_NOTICE("Subscribed to RPC.");
+}
+
+/**
+ * Subscribe to RPC through a router.
+ * Requests are dispatched by the router instead of ThingsBoard, so there is no limit of callbacks.
+ *
+ * @param router Router with the method handlers. It's built here if it wasn't yet.
+ */
+void CFThingsBoardHelper::RPCSubscribe(CFRPCRouter &router) {
+  if (!router.isReady() && !router.begin()) {
+    CF_LOG_WARNING("Fail building RPC router.");
+    return;
+  }
+  _mqttClient.setRPCRouter(&router);
+  if (!_mqttClient.subscribe("v1/devices/me/rpc/request/+")) {
+    CF_LOG_WARNING("Fail subscribing to RPC.");
+    return;
+  }
+  CF_LOG_NOTICE("Subscribed to RPC.");
 }
 
 /**
@@ -134,6 +418,81 @@ void CFThingsBoardHelper::setServerURL(String serverURL) {
   _serverURL = serverURL;
 }
 
+/**
+ * Define server MQTT port.
+ *
+ * @param serverPort Server port, 1883 by default.
+ */
+void CFThingsBoardHelper::setServerPort(int serverPort) {
+  _serverPort = serverPort;
+}
+
+/**
+ * Define telemetry payload encoding.
+ * ThingsBoard drops anything but JSON on its own topics (v1/...), so MessagePack payloads are published
+ * to a topic of a local broker or gateway that decodes them with CFPayloadCodec and forwards them as
+ * JSON. Without such a topic the encoding isn't changed.
+ *
+ * @param payloadEncoding Payload encoding, JSON by default.
+ * @param payloadTopic Topic of the bridge that decodes MessagePack payloads, ignored for JSON.
+ * @returns True if it was defined, false if MessagePack was asked without a bridge topic.
+ */
+bool CFThingsBoardHelper::setPayloadEncoding(CFPayloadCodec::Encoding payloadEncoding, String payloadTopic) {
+  if (payloadEncoding == CFPayloadCodec::MSGPACK && (payloadTopic.length() == 0 || payloadTopic.startsWith("v1/"))) {
+    CF_LOG_WARNING("MessagePack telemetry needs the topic of a bridge, ThingsBoard only accepts JSON.");
+    return false;
+  }
+  _payloadEncoding = payloadEncoding;
+  _payloadTopic = payloadEncoding == CFPayloadCodec::MSGPACK ? payloadTopic : "";
+  return true;
+}
+
+/**
+ * Define MQTT transport.
+ * With QUEUED, loop() never waits for the network: what the socket can't take is queued and written
+ * on the next loops, and new telemetry is held back while the queue is over half full.
+ *
+ * @param transport Transport, BLOCKING by default.
+ * @returns True if it was defined, false if there isn't memory for the queue.
+ */
+bool CFThingsBoardHelper::setTransport(CFMQTTClient::Transport transport) {
+  if (!_mqttClient.setTransport(transport)) {
+    CF_LOG_WARNING("Not enough memory for the MQTT queue.");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Define persistent session.
+ * The broker keeps the subscriptions across reconnections and they aren't sent again while it does.
+ *
+ * @param persistentSession True to ask the broker to keep the session, false by default.
+ */
+void CFThingsBoardHelper::setPersistentSession(bool persistentSession) {
+  _mqttClient.setPersistentSession(persistentSession);
+}
+
+/**
+ * Define LAN publisher, that broadcasts the telemetry values to the local network too.
+ * Frames go out on the same schedule as the messages to ThingsBoard, even while it's disconnected.
+ *
+ * @param lanPublisher LAN publisher, NULL to stop broadcasting.
+ */
+void CFThingsBoardHelper::setLanPublisher(CFLanPublisher *lanPublisher) {
+  _lanPublisher = lanPublisher;
+}
+
+/**
+ * Define attribute cache, that applies the last shared attributes at boot and syncs them on connect.
+ *
+ * @param attributeCache Attribute cache, NULL to stop caching.
+ */
+void CFThingsBoardHelper::setAttributeCache(CFAttributeCache *attributeCache) {
+  _attributeCache = attributeCache;
+  _mqttClient.setAttributeCache(attributeCache);
+}
+
 /**
  * Define token.
  *
@@ -151,6 +510,25 @@ void CFThingsBoardHelper::setLocalIP(String localIP) {
   _localIP = localIP;
 }
 
+/**
+ * Define device id, sent as device_chip_id and used in the MQTT client id.
+ * Devices simulated on the same host need one each, otherwise they take each other's MQTT session.
+ *
+ * @param deviceId Device id, 0 for the ESP chip id.
+ */
+void CFThingsBoardHelper::setDeviceId(uint32_t deviceId) {
+  _deviceId = deviceId;
+}
+
+/**
+ * Get device id.
+ *
+ * @returns Device id defined or the ESP chip id.
+ */
+uint32_t CFThingsBoardHelper::getDeviceId() {
+  return _deviceId != 0 ? _deviceId : ESP.getChipId();
+}
+
 /**
  * True if ThingsBoard is connected.
  */
@@ -159,23 +537,59 @@ bool CFThingsBoardHelper::isConnected() {
 }
 
 /**
- * Set telemetry int value.
+ * Set telemetry String value.
  *
  * @param key Key.
- * @param value Int value.
+ * @param value String value.
  */
-void CFThingsBoardHelper::setTelemetryValue(String key, int value) {
-  _data[key] = value;
+void CFThingsBoardHelper::setTelemetryValue(String key, String value) {
+  if (!_data[key].set(value)) _overflow("telemetry");
 }
 
 /**
- * Set telemetry String value.
+ * Set several telemetry values, so they are sent in the same message.
+ *
+ * @param values Values by key.
+ */
+void CFThingsBoardHelper::setTelemetryValues(JsonObjectConst values) {
+  for (JsonPairConst p : values) {
+    if (!_data[p.key()].set(p.value())) _overflow("telemetry");
+    if (p.value().is<bool>()) {
+      _updateDeadband(p.key().c_str(), p.value().as<bool>() ? 1 : 0);
+    } else if (p.value().is<float>()) {
+      _updateDeadband(p.key().c_str(), p.value().as<float>());
+    }
+  }
+}
+
+/**
+ * Define telemetry deadband of a numeric key (report by exception).
+ *
+ * The key is sent right away when its value moves at least the absolute or the percentual threshold
+ * from the last value sent, otherwise only when the heartbeat time has passed since then.
  *
  * @param key Key.
- * @param value String value.
+ * @param absolute Absolute change that triggers a submission, 0 to disable.
+ * @param percent Percentual change that triggers a submission, 0 to disable. From a last value of 0 any change does.
+ * @param heartbeat Max time without sending the key, 0 to send it with the periodic submission.
  */
-void CFThingsBoardHelper::setTelemetryValue(String key, String value) {
-  _data[key] = value;
+void CFThingsBoardHelper::setTelemetryDeadband(String key, float absolute, float percent, unsigned long heartbeat) {
+  Deadband *deadband = _findDeadband(key.c_str());
+  if (!deadband) {
+    if (_deadbandsQty >= CF_TB_MAX_DEADBANDS) {
+      CF_LOG_WARNING("Too many deadbands. Increase CF_TB_MAX_DEADBANDS.");
+      return;
+    }
+    deadband = &_deadbands[_deadbandsQty++];
+    deadband->key = key;
+    deadband->lastValue = NAN;
+    deadband->lanValue = NAN;
+    deadband->tLastSent = 0;
+    deadband->pending = false;
+  }
+  deadband->absolute = absolute;
+  deadband->percent = percent;
+  deadband->heartbeat = heartbeat;
 }
 
 /**
@@ -185,7 +599,7 @@ void CFThingsBoardHelper::setTelemetryValue(String key, String value) {
  * @param value Int value.
  */
 void CFThingsBoardHelper::setAttributeValue(String key, int value) {
-  _attributes[key] = value;
+  if (!_attributes[key].set(value)) _overflow("attribute");
 }
 
 /**
@@ -195,7 +609,7 @@ void CFThingsBoardHelper::setAttributeValue(String key, int value) {
  * @param value String value.
  */
 void CFThingsBoardHelper::setAttributeValue(String key, String value) {
-  _attributes[key] = value;
+  if (!_attributes[key].set(value)) _overflow("attribute");
 }
 
 /**
@@ -211,6 +625,113 @@ void CFThingsBoardHelper::setOnThingsBoardConnectCallback(VoidCallback onThingsB
  * Send pending data to ThingsBoard.
  */
 void CFThingsBoardHelper::sendData() {
-  // Reset last sent attribute in order to send what's pending in the next loop call.
-  _tLastSent = 0;
+  // Send what's pending in the next loop call.
+  _sendPending = true;
+  _lanPending = true;
+}
+
+/**
+ * Get time spent on the last connection attempt.
+ *
+ * @returns Time in milliseconds.
+ */
+unsigned long CFThingsBoardHelper::getConnectTime() {
+  return _connectTime;
+}
+
+/**
+ * Get telemetry messages published.
+ *
+ * @returns Messages published since boot.
+ */
+unsigned long CFThingsBoardHelper::getPublishedQty() {
+  return _publishedQty;
+}
+
+/**
+ * Get telemetry messages dropped because they didn't fit in a payload.
+ *
+ * @returns Messages dropped since boot.
+ */
+unsigned long CFThingsBoardHelper::getDroppedQty() {
+  return _droppedQty;
+}
+
+/**
+ * Get bytes written to the network.
+ *
+ * @returns Bytes sent since boot.
+ */
+unsigned long CFThingsBoardHelper::getBytesSent() {
+  return _mqttClient.getBytesSent();
+}
+
+/**
+ * Get bytes read from the network.
+ *
+ * @returns Bytes received since boot.
+ */
+unsigned long CFThingsBoardHelper::getBytesReceived() {
+  return _mqttClient.getBytesReceived();
+}
+
+/**
+ * Get time spent handling the last RPC request dispatched by a router.
+ *
+ * @returns Time in microseconds.
+ */
+unsigned long CFThingsBoardHelper::getRPCTime() {
+  return _mqttClient.getRPCTime();
+}
+
+/**
+ * Get bytes waiting to be written with the QUEUED transport.
+ *
+ * @returns Bytes queued.
+ */
+size_t CFThingsBoardHelper::getQueueDepth() {
+  return _mqttClient.getQueueDepth();
+}
+
+/**
+ * Get current telemetry values.
+ *
+ * @param telemetry Object where the values are copied.
+ */
+void CFThingsBoardHelper::getTelemetry(JsonObject telemetry) {
+  telemetry.set(_data.as<JsonObjectConst>());
+}
+
+/**
+ * Get current attribute values.
+ *
+ * @param attributes Object where the values are copied.
+ */
+void CFThingsBoardHelper::getAttributes(JsonObject attributes) {
+  attributes.set(_attributes.as<JsonObjectConst>());
+}
+
+/**
+ * Get connection metrics.
+ *
+ * @param metrics Object where the metrics are written.
+ */
+void CFThingsBoardHelper::getMetrics(JsonObject metrics) {
+  metrics["connected"] = _TBconnected;
+  metrics["connect_time"] = _connectTime;
+  metrics["published_qty"] = _publishedQty;
+  metrics["dropped_qty"] = _droppedQty;
+  metrics["overflow_qty"] = _overflowQty;
+  metrics["encode_time"] = _encodeTime;
+  metrics["bytes_sent"] = getBytesSent();
+  metrics["bytes_received"] = getBytesReceived();
+  metrics["rpc_time"] = getRPCTime();
+  metrics["write_time"] = _mqttClient.getWriteTime();
+  metrics["queue_depth"] = _mqttClient.getQueueDepth();
+  metrics["queue_peak"] = _mqttClient.getQueuePeak();
+  metrics["queue_rejected"] = _mqttClient.getQueueRejected();
+  metrics["session_present"] = _mqttClient.isSessionPresent();
+  metrics["subscriptions_skipped"] = _mqttClient.getSkippedQty();
+  metrics["oversized_qty"] = _mqttClient.getOversizedQty();
+  if (_attributeCache) _attributeCache->getMetrics(metrics);
 }
@@ -11,35 +11,115 @@
 #ifndef CFThingsBoardHelper_h
 #define CFThingsBoardHelper_h
 
-#include <Logger.h>       // Logger.
-#include <ThingsBoard.h>  // Things Board.
-#include <WiFiManager.h>  // Wi-Fi.
+#include <CFAttributeCache.h>  // CF Attribute Cache.
+#include <CFJsonArena.h>       // CF JSON Arena.
+#include <CFLanPublisher.h>    // CF LAN Publisher.
+#include <CFLog.h>             // CF Log.
+#include <CFMQTTClient.h>      // CF MQTT Client.
+#include <CFPayloadCodec.h>    // CF Payload Codec.
+#include <CFRPCRouter.h>       // CF RPC Router.
+#include <CFWatchdog.h>        // CF Watchdog.
+#include <ThingsBoard.h>       // Things Board.
+#include <type_traits>         // Type traits.
+#include <WiFiManager.h>       // Wi-Fi.
+
+#ifndef CF_TB_TELEMETRY_SIZE
+#define CF_TB_TELEMETRY_SIZE 512  // Telemetry document capacity.
+#endif
+
+#ifndef CF_TB_ATTRIBUTES_SIZE
+#define CF_TB_ATTRIBUTES_SIZE 1024  // Attributes document capacity.
+#endif
+
+#ifndef CF_TB_PAYLOAD_SIZE
+#define CF_TB_PAYLOAD_SIZE 256  // Max MQTT payload size.
+#endif
+
+#ifndef CF_TB_MAX_DEADBANDS
+#define CF_TB_MAX_DEADBANDS 8  // Max telemetry keys with deadband.
+#endif
+
+#ifndef CF_TB_LAN_RETRY_TIME
+#define CF_TB_LAN_RETRY_TIME 1000  // Time between attempts to broadcast a frame that couldn't be sent.
+#endif
 
 class CFThingsBoardHelper {
  private:
   // Aliases.
   using VoidCallback = void (*)();  // Alias for callback.
 
-  // ThingsBoard and WiFiClient attributes.
-  WiFiClient _wifiClient;    // WiFi Client.
-  ThingsBoard _thingsBoard;  // ThingsBoard.
+  // ThingsBoard and MQTT client attributes.
+  CFMQTTClient _mqttClient;                            // MQTT Client.
+  ThingsBoardSized<CF_TB_PAYLOAD_SIZE> _thingsBoard;  // ThingsBoard.
 
   // Config attributes.
-  String _appCode;           // Software code.
-  String _appVersion;        // Software version.
-  String _serverURL;         // Server URL.
-  String _token;             // Device token to connect to ThingsBoard device.
-  String _localIP;           // Local IP.
-  String _deviceName;        // Device name.
-  unsigned long _ttRetry;    // Time between connection attempts.
-  unsigned long _ttSend;     // Time between submissions.
-  unsigned long _tLastSent;  // Last time data was sent.
-  bool _TBconnected;         // Flag that indicates if ThingsBoard is connected.
+  String _appCode;                            // Software code.
+  String _appVersion;                         // Software version.
+  String _serverURL;                          // Server URL.
+  int _serverPort;                            // Server MQTT port.
+  CFPayloadCodec::Encoding _payloadEncoding;  // Telemetry payload encoding.
+  String _payloadTopic;                       // Topic of binary telemetry payloads.
+  String _token;                              // Device token to connect to ThingsBoard device.
+  String _localIP;                            // Local IP.
+  String _deviceName;                         // Device name.
+  uint32_t _deviceId;                         // Device id, 0 for the ESP chip id.
+  unsigned long _ttRetry;                     // Time between connection attempts.
+  unsigned long _ttSend;                      // Time between submissions.
+  unsigned long _tLastSent;                   // Last time data was sent.
+  unsigned long _tLastAttempt;                // Last time a connection attempt failed.
+  bool _sendPending;                          // Flag that indicates data must be sent on the next loop.
+  bool _connectFailed;                        // Flag that indicates the last connection attempt failed.
+  bool _TBconnected;                          // Flag that indicates if ThingsBoard is connected.
+  bool _watchdogReported;                     // Flag that indicates the watchdog report of the last boot was sent.
+  uint32_t _identityHash;                     // Hash of the identity attributes last sent.
+
+  // Metrics.
+  unsigned long _connectTime;   // Time spent on the last connection attempt.
+  unsigned long _publishedQty;  // Telemetry messages published.
+  unsigned long _droppedQty;    // Telemetry messages dropped because they didn't fit in a payload.
+  unsigned long _overflowQty;   // Values that didn't fit in the JSON documents.
+  unsigned long _encodeTime;    // Time spent building and encoding the last telemetry message (us).
 
   // JSON Data.
   DynamicJsonDocument _data;        // JSON telemetry data.
   DynamicJsonDocument _attributes;  // JSON attributes.
 
+  // Deadband.
+  struct Deadband {
+    String key;               // Telemetry key.
+    float absolute;           // Absolute change that triggers a submission.
+    float percent;            // Percentual change that triggers a submission.
+    unsigned long heartbeat;  // Max time without submitting.
+    float lastValue;          // Last value submitted.
+    float lanValue;           // Last value broadcast to the local network.
+    unsigned long tLastSent;  // Last time it was submitted.
+    bool pending;             // Flag that indicates it must be submitted right away.
+  };
+  Deadband _deadbands[CF_TB_MAX_DEADBANDS];  // Telemetry deadbands.
+  uint8_t _deadbandsQty;                     // Telemetry deadbands quantity.
+
+  // Local network.
+  CFLanPublisher *_lanPublisher;  // LAN publisher.
+  unsigned long _tLanLastSent;    // Last time values were broadcast.
+  bool _lanPending;               // Flag that indicates values must be broadcast on the next loop.
+  bool _lanFailed;                // Flag that indicates the last broadcast failed.
+  unsigned long _tLanLastFailed;  // Last time a broadcast failed.
+
+  // Shared attributes.
+  CFAttributeCache *_attributeCache;  // Attribute cache.
+
+  // Methods.
+  void _sendTelemetry(bool periodic);                     // Send telemetry.
+  void _publishLan();                                     // Broadcast the telemetry values to the local network.
+  void _overflow(const char *document);                   // Count a value that didn't fit in a document.
+  void _sendWatchdogReport();                             // Send the watchdog report of the last boot.
+  void _sendIdentity(const char *espChipId);              // Send the identity attributes if they changed.
+  Deadband *_findDeadband(const char *key);               // Find the deadband of a telemetry key.
+  void _updateDeadband(String key, float value);          // Check a new value against its key deadband.
+  static bool _isOutOfDeadband(const Deadband &deadband,  // True if a value is out of the deadband around a reference.
+                               float reference, float value);
+  bool _isDeadbandDue();                                  // True if any key with deadband must be sent.
+
   // Callbacks.
   VoidCallback _onThingsBoardConnectCallback;  // On ThingsBoard connect callback.
 
@@ -48,16 +128,54 @@ class CFThingsBoardHelper {
   void loop();                                                                  // Loop.
   void ATTRSubscribe(const Shared_Attribute_Callback *callbacks, size_t size);  // Subscribe to attr.
   void RPCSubscribe(const RPC_Callback *callbacks, size_t size);                // Subscribe to RPC.
+  void RPCSubscribe(CFRPCRouter &router);                                       // Subscribe to RPC through a router.
   void setServerURL(String serverURL);                                          // Define server URL.
+  void setServerPort(int serverPort);                                           // Define server MQTT port.
+  bool setPayloadEncoding(CFPayloadCodec::Encoding payloadEncoding,             // Define telemetry payload encoding.
+                          String payloadTopic = "");
+  bool setTransport(CFMQTTClient::Transport transport);                         // Define MQTT transport.
+  void setPersistentSession(bool persistentSession);                            // Define persistent MQTT session.
+  void setLanPublisher(CFLanPublisher *lanPublisher);                           // Define LAN publisher.
+  void setAttributeCache(CFAttributeCache *attributeCache);                     // Define attribute cache.
   void setToken(String token);                                                  // Define token.
   void setLocalIP(String localIP);                                              // Define device name.
+  void setDeviceId(uint32_t deviceId);                                          // Define device id.
+  uint32_t getDeviceId();                                                       // Get device id.
   bool isConnected();                                                           // True if ThingsBoard is connected.
-  void setTelemetryValue(String key, int value);                                // Set telemetry int value.
+  template <typename T>                                                         // Set telemetry numeric or bool value.
+  typename std::enable_if<std::is_arithmetic<T>::value>::type setTelemetryValue(String key, T value);
   void setTelemetryValue(String key, String value);                             // Set telemetry String value.
+  void setTelemetryValues(JsonObjectConst values);                              // Set several telemetry values.
+  void setTelemetryDeadband(String key, float absolute, float percent,          // Define telemetry deadband of a key.
+                            unsigned long heartbeat);
   void setAttributeValue(String key, int value);                                // Set attribute int value.
   void setAttributeValue(String key, String value);                             // Set attribute String value.
   void setOnThingsBoardConnectCallback(const VoidCallback);                     // Define on ThingsBoard connect callback.
   void sendData();                                                              // Send pending data to ThingsBoard.
+  unsigned long getConnectTime();                                               // Get time spent on the last connection attempt.
+  unsigned long getPublishedQty();                                              // Get telemetry messages published.
+  unsigned long getDroppedQty();                                                // Get telemetry messages dropped.
+  unsigned long getBytesSent();                                                 // Get bytes written to the network.
+  unsigned long getBytesReceived();                                             // Get bytes read from the network.
+  unsigned long getRPCTime();                                                   // Get time spent handling the last routed RPC.
+  size_t getQueueDepth();                                                       // Get bytes waiting to be written.
+  void getTelemetry(JsonObject telemetry);                                      // Get current telemetry values.
+  void getAttributes(JsonObject attributes);                                    // Get current attribute values.
+  void getMetrics(JsonObject metrics);                                          // Get connection metrics.
 };
 
+/**
+ * Set telemetry numeric or bool value.
+ * Every integer and floating point type is taken as it is, so calls like setTelemetryValue("heap",
+ * ESP.getFreeHeap()) are never ambiguous.
+ *
+ * @param key Key.
+ * @param value Value.
+ */
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type CFThingsBoardHelper::setTelemetryValue(String key, T value) {
+  if (!_data[key].set(value)) _overflow("telemetry");
+  _updateDeadband(key, value);
+}
+
 #endif
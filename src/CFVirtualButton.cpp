@@ -23,8 +23,8 @@ CFVirtualButton::CFVirtualButton(int pinButton, int defaultStatus) : _pinButton(
 }
 
 void CFVirtualButton::begin() {
-  pinMode(_pinButton, OUTPUT);
-  digitalWrite(_pinButton, _defaultStatus);
+  _pinButton.setMode(OUTPUT);
+  _pinButton.write(_defaultStatus == HIGH);
 }
 
 void CFVirtualButton::loop() {
@@ -39,7 +39,7 @@ void CFVirtualButton::push() {
 
 void CFVirtualButton::_setStatus(int status) {
   if ((millis() - _lastChange) > 100) {
-    digitalWrite(_pinButton, status);
+    _pinButton.write(status == HIGH);
     _status = status;
     _lastChange = millis();
   }
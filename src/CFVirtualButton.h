@@ -11,15 +11,16 @@
 #ifndef CFVirtualButton_h
 #define CFVirtualButton_h
 
-#include <Arduino.h>  // Arduino library.
+#include <Arduino.h>     // Arduino library.
+#include <CFFastGPIO.h>  // CF Fast GPIO.
 
 class CFVirtualButton {
  private:
   // Virtual Button attributes.
-  int _pinButton;      // Button pin.
-  int _defaultStatus;  // Default status.
-  int _status;         // Current status.
-  int _lastChange;     // Last time status was changed.
+  CFFastGPIO _pinButton;      // Button pin.
+  int _defaultStatus;         // Default status.
+  int _status;                // Current status.
+  unsigned long _lastChange;  // Last time status was changed.
 
   // Methods.
   void _setStatus(int status);  // Define a new status.
@@ -0,0 +1,154 @@
+/**
+ * CFWatchdog.cpp
+ *
+ * A software watchdog that tells which blocking section stalled the loop or was running when the
+ * device was reset.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#include <CFWatchdog.h>  // CF Watchdog.
+
+#define CF_WATCHDOG_MAGIC 0xCF3D0643  // Record magic.
+
+bool CFWatchdog::_running = false;
+CFWatchdog::Record CFWatchdog::_record;
+CFWatchdog::Record CFWatchdog::_lastRecord;
+bool CFWatchdog::_hasLastRecord = false;
+uint8_t CFWatchdog::_depth = 0;
+unsigned long CFWatchdog::_tEnter = 0;
+unsigned long CFWatchdog::_tLoop = 0;
+
+/**
+ * Initialize, reading the record of the last boot.
+ * After a power on RTC memory holds noise, that doesn't match the checksum.
+ */
+void CFWatchdog::begin() {
+  _hasLastRecord = ESP.rtcUserMemoryRead(CF_WATCHDOG_RTC_OFFSET, (uint32_t *)&_lastRecord, sizeof(_lastRecord)) &&
+                   _lastRecord.magic == _checksum(_lastRecord);
+  if (_hasLastRecord) {
+    _lastRecord.stallSection[CF_WATCHDOG_NAME_SIZE - 1] = '\0';
+    _lastRecord.section[CF_WATCHDOG_NAME_SIZE - 1] = '\0';
+    CF_LOG_NOTICE("Last boot ended by %s. Section running: %s. Longest section: %s (%lu ms).",
+                  ESP.getResetReason().c_str(), _lastRecord.section[0] ? _lastRecord.section : "none",
+                  _lastRecord.stallSection[0] ? _lastRecord.stallSection : "none", (unsigned long)_lastRecord.stallTime);
+  }
+
+  memset(&_record, 0, sizeof(_record));
+  _depth = 0;
+  _tLoop = millis();
+  _running = true;
+  _save();
+}
+
+/**
+ * Loop.
+ * Keeps the longest time between loops, which includes the time of the sketch outside the sections.
+ */
+void CFWatchdog::loop() {
+  if (!_running) return;
+  unsigned long now = millis();
+  unsigned long loopTime = now - _tLoop;
+  _tLoop = now;
+  if (loopTime > _record.loopTime) {
+    _record.loopTime = loopTime;
+    _save();
+  }
+}
+
+/**
+ * Enter a blocking section.
+ * It's written to RTC memory before the section runs, so it's known even if it never returns.
+ *
+ * @param section Section name, up to CF_WATCHDOG_NAME_SIZE - 1 characters are kept.
+ */
+void CFWatchdog::enter(const char *section) {
+  if (!_running || _depth++ > 0) return;
+  strncpy(_record.section, section, CF_WATCHDOG_NAME_SIZE - 1);
+  _record.section[CF_WATCHDOG_NAME_SIZE - 1] = '\0';
+  _tEnter = millis();
+  _save();
+}
+
+/**
+ * Leave the blocking section.
+ */
+void CFWatchdog::leave() {
+  if (!_running || _depth == 0 || --_depth > 0) return;
+  unsigned long time = millis() - _tEnter;
+  if (time >= CF_WATCHDOG_STALL_WARNING) {
+    CF_LOG_WARNING("Section %s blocked the loop for %lu ms.", _record.section, time);
+  }
+  if (time > _record.stallTime) {
+    _record.stallTime = time;
+    memcpy(_record.stallSection, _record.section, CF_WATCHDOG_NAME_SIZE);
+  }
+  _record.section[0] = '\0';
+  _save();
+}
+
+/**
+ * Get the record checksum.
+ *
+ * @param record Record.
+ * @returns Magic xor every other word of the record.
+ */
+uint32_t CFWatchdog::_checksum(const Record &record) {
+  const uint32_t *words = (const uint32_t *)&record;
+  uint32_t checksum = CF_WATCHDOG_MAGIC;
+  for (size_t i = 1; i < sizeof(Record) / 4; i++) {
+    checksum ^= words[i];
+  }
+  return checksum;
+}
+
+/**
+ * Write the record to RTC memory.
+ */
+void CFWatchdog::_save() {
+  _record.magic = _checksum(_record);
+  ESP.rtcUserMemoryWrite(CF_WATCHDOG_RTC_OFFSET, (uint32_t *)&_record, sizeof(_record));
+}
+
+/**
+ * True if the last boot left a record.
+ *
+ * @returns True if there is a report.
+ */
+bool CFWatchdog::hasReport() {
+  return _hasLastRecord;
+}
+
+/**
+ * Get the record of the last boot.
+ *
+ * @param report Object where the report is written.
+ */
+void CFWatchdog::getReport(JsonObject report) {
+  if (!_hasLastRecord) return;
+  report["wd_reset_reason"] = ESP.getResetReason();
+  report["wd_reset_section"] = _lastRecord.section;
+  report["wd_stall_section"] = _lastRecord.stallSection;
+  report["wd_stall_time"] = _lastRecord.stallTime;
+  report["wd_loop_time"] = _lastRecord.loopTime;
+}
+
+/**
+ * Get the longest section time of this boot.
+ *
+ * @returns Time in milliseconds.
+ */
+unsigned long CFWatchdog::getStallTime() {
+  return _record.stallTime;
+}
+
+/**
+ * Get the longest section of this boot.
+ *
+ * @returns Section name, empty if no section has finished yet.
+ */
+const char *CFWatchdog::getStallSection() {
+  return _record.stallSection;
+}
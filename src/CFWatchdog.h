@@ -0,0 +1,92 @@
+/**
+ * CFWatchdog.h
+ *
+ * A software watchdog that tells which blocking section stalled the loop or was running when the
+ * device was reset.
+ *
+ * The sections that may block (connecting, reading sensors, flushing the display, HTTP requests) are
+ * wrapped with CF_WATCHDOG_SECTION, and the longest one is kept in RTC memory together with the one
+ * running at any moment. RTC memory survives a reset, so after a hardware or software watchdog reset
+ * the next boot still knows what the device was doing, and CFThingsBoardHelper sends it as telemetry.
+ *
+ *    void setup() {
+ *      CFWatchdog::begin();
+ *    }
+ *
+ *    void loop() {
+ *      CFWatchdog::loop();
+ *      {
+ *        CF_WATCHDOG_SECTION("https_get");
+ *        https.GET();
+ *      }
+ *    }
+ *
+ * Sections are ignored until begin() is called. Nested sections are attributed to the outermost one.
+ *
+ * @author  Caio Frota <caiofrota@gmail.com>
+ * @version 1.0
+ * @since   Oct, 2026
+ */
+
+#ifndef CFWatchdog_h
+#define CFWatchdog_h
+
+#include <Arduino.h>      // Arduino library.
+#include <ArduinoJson.h>  // Arduino JSON.
+#include <CFLog.h>        // CF Log.
+
+#ifndef CF_WATCHDOG_RTC_OFFSET
+#define CF_WATCHDOG_RTC_OFFSET 64  // RTC user memory block where the record is kept (the first 32 are used by OTA).
+#endif
+
+#ifndef CF_WATCHDOG_STALL_WARNING
+#define CF_WATCHDOG_STALL_WARNING 1000  // Section time that is logged as a stall (ms).
+#endif
+
+#define CF_WATCHDOG_NAME_SIZE 16  // Max section name length stored, terminator included.
+
+class CFWatchdog {
+ private:
+  // Record kept in RTC memory.
+  struct Record {
+    uint32_t magic;                            // Magic, xor the other words, to tell it from noise.
+    uint32_t stallTime;                        // Longest section time (ms).
+    uint32_t loopTime;                         // Longest time between loops (ms).
+    char stallSection[CF_WATCHDOG_NAME_SIZE];  // Longest section.
+    char section[CF_WATCHDOG_NAME_SIZE];       // Section running, empty if none.
+  };
+
+  // State.
+  static bool _running;          // Flag that indicates it was started.
+  static Record _record;         // Record of this boot.
+  static Record _lastRecord;     // Record of the last boot.
+  static bool _hasLastRecord;    // Flag that indicates the last boot left a valid record.
+  static uint8_t _depth;         // Sections nested.
+  static unsigned long _tEnter;  // Time the current section started.
+  static unsigned long _tLoop;   // Time of the last loop.
+
+  // Methods.
+  static uint32_t _checksum(const Record &record);  // Get the record checksum.
+  static void _save();                              // Write the record to RTC memory.
+
+ public:
+  static void begin();                       // Initialize, reading the record of the last boot.
+  static void loop();                        // Loop.
+  static void enter(const char *section);    // Enter a blocking section.
+  static void leave();                       // Leave the blocking section.
+  static bool hasReport();                   // True if the last boot left a record.
+  static void getReport(JsonObject report);  // Get the record of the last boot.
+  static unsigned long getStallTime();       // Get the longest section time of this boot.
+  static const char *getStallSection();      // Get the longest section of this boot.
+};
+
+// Blocking section guard, the section lasts until the end of the scope.
+class CFWatchdogSection {
+ public:
+  CFWatchdogSection(const char *section) { CFWatchdog::enter(section); }  // Enter.
+  ~CFWatchdogSection() { CFWatchdog::leave(); }                           // Leave.
+};
+
+#define CF_WATCHDOG_SECTION(section) CFWatchdogSection _cfWatchdogSection(section)
+
+#endif
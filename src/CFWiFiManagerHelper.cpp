@@ -11,14 +11,63 @@
 // Libraries.
 #include <CFWiFiManagerHelper.h>  // CF Wi-Fi Manager.
 
+// REST resources.
+#define CF_WM_REST_PATH "/api/"            // REST resources path prefix.
+#define CF_WM_API_KEY_HEADER "X-API-Key"  // Header with the API key that allows changing the device state.
+
+/**
+ * Writer that streams a serialized JSON to a client in packets instead of byte by byte.
+ */
+class CFWMClientWriter {
+ private:
+  WiFiClient &_client;   // Client.
+  uint8_t _buffer[128];  // Bytes not sent yet.
+  size_t _length;        // Bytes in the buffer.
+
+ public:
+  CFWMClientWriter(WiFiClient &client) : _client(client),
+                                         _length(0) {
+  }
+  size_t write(uint8_t c) {
+    _buffer[_length++] = c;
+    if (_length == sizeof(_buffer)) flush();
+    return 1;
+  }
+  size_t write(const uint8_t *s, size_t n) {
+    for (size_t i = 0; i < n; i++) write(s[i]);
+    return n;
+  }
+  void flush() {
+    if (_length > 0) _client.write(_buffer, _length);
+    _length = 0;
+  }
+};
+
+// Compressed firmware update.
+#define CF_WM_UPDATE_PATH "/cfupdate"  // Compressed firmware update path.
+static const char CF_WM_UPDATE_MENU_HTML[] = "<form action='" CF_WM_UPDATE_PATH "' method='get'><button>Update (compressed)</button></form><br/>";
+static const char CF_WM_UPDATE_PAGE_HTML[] PROGMEM =
+    "<!DOCTYPE html><html><head><meta name='viewport' content='width=device-width'></head><body>"
+    "<form method='POST' enctype='multipart/form-data' onsubmit=\"this.action='" CF_WM_UPDATE_PATH "?md5='+this.md5.value\">"
+    "<p>Firmware (.bin, .bin.gz or .bin.hs)<br/><input type='file' name='firmware'></p>"
+    "<p>MD5 (optional), of the .bin for .bin and .bin.hs, of the .bin.gz for .bin.gz<br/><input name='md5' maxlength='32'></p>"
+    "<button>Update</button></form></body></html>";
+
 /**
  * Constructor.
  */
-CFWiFiManagerHelper::CFWiFiManagerHelper() : _customPort(80),
+CFWiFiManagerHelper::CFWiFiManagerHelper() : _maxParamsQty(0),
+                                             _wifiManagerParameters(NULL),
+                                             _customPort(80),
                                              _wifiManager(),
-                                             _wifiServer(80),
                                              _fileSystemPath("/cfwmconfig.json"),
-                                             _defaultWifiPassword("12345678") {
+                                             _defaultWifiPassword("12345678"),
+                                             _restResourcesQty(0),
+                                             _deviceState(NULL),
+                                             _stateApiKey(""),
+                                             _wifiConnected(false),
+                                             _onConfigModeCallback(NULL),
+                                             _onSaveParametersCallback(NULL) {
   _defaultWifiSSID = _wifiManager.getDefaultAPName();
 }
 
@@ -27,22 +76,36 @@ CFWiFiManagerHelper::CFWiFiManagerHelper() : _customPort(80),
  *
  * @param defaultWifiPassword Default password that should be used when WiFi on AP mode.
  */
-CFWiFiManagerHelper::CFWiFiManagerHelper(String defaultWifiPassword) : _customPort(80),
+CFWiFiManagerHelper::CFWiFiManagerHelper(String defaultWifiPassword) : _maxParamsQty(0),
+                                                                       _wifiManagerParameters(NULL),
+                                                                       _customPort(80),
                                                                        _wifiManager(),
-                                                                       _wifiServer(80),
                                                                        _fileSystemPath("/cfwmconfig.json"),
-                                                                       _defaultWifiPassword(defaultWifiPassword) {
+                                                                       _defaultWifiPassword(defaultWifiPassword),
+                                                                       _restResourcesQty(0),
+                                                                       _deviceState(NULL),
+                                                                       _stateApiKey(""),
+                                                                       _wifiConnected(false),
+                                                                       _onConfigModeCallback(NULL),
+                                                                       _onSaveParametersCallback(NULL) {
   _defaultWifiSSID = _wifiManager.getDefaultAPName();
 }
 
 /**
  * Constructor with custom port.
  */
-CFWiFiManagerHelper::CFWiFiManagerHelper(int customPort) : _customPort(customPort),
+CFWiFiManagerHelper::CFWiFiManagerHelper(int customPort) : _maxParamsQty(0),
+                                                           _wifiManagerParameters(NULL),
+                                                           _customPort(customPort),
                                                            _wifiManager(),
-                                                           _wifiServer(customPort),
                                                            _fileSystemPath("/cfwmconfig.json"),
-                                                           _defaultWifiPassword("12345678") {
+                                                           _defaultWifiPassword("12345678"),
+                                                           _restResourcesQty(0),
+                                                           _deviceState(NULL),
+                                                           _stateApiKey(""),
+                                                           _wifiConnected(false),
+                                                           _onConfigModeCallback(NULL),
+                                                           _onSaveParametersCallback(NULL) {
   _defaultWifiSSID = _wifiManager.getDefaultAPName();
 }
 
@@ -51,11 +114,18 @@ CFWiFiManagerHelper::CFWiFiManagerHelper(int customPort) : _customPort(customPor
  *
  * @param defaultWifiPassword Default password that should be used when WiFi on AP mode.
  */
-CFWiFiManagerHelper::CFWiFiManagerHelper(String defaultWifiPassword, int customPort) : _customPort(customPort),
+CFWiFiManagerHelper::CFWiFiManagerHelper(String defaultWifiPassword, int customPort) : _maxParamsQty(0),
+                                                                                       _wifiManagerParameters(NULL),
+                                                                                       _customPort(customPort),
                                                                                        _wifiManager(),
-                                                                                       _wifiServer(customPort),
                                                                                        _fileSystemPath("/cfwmconfig.json"),
-                                                                                       _defaultWifiPassword(defaultWifiPassword) {
+                                                                                       _defaultWifiPassword(defaultWifiPassword),
+                                                                                       _restResourcesQty(0),
+                                                                                       _deviceState(NULL),
+                                                                                       _stateApiKey(""),
+                                                                                       _wifiConnected(false),
+                                                                                       _onConfigModeCallback(NULL),
+                                                                                       _onSaveParametersCallback(NULL) {
   _defaultWifiSSID = _wifiManager.getDefaultAPName();
 }
 
@@ -71,16 +141,20 @@ void CFWiFiManagerHelper::begin() {
       std::bind(&CFWiFiManagerHelper::_APCallback, this, std::placeholders::_1));
   _wifiManager.setSaveParamsCallback(  // Define callback when parameters are saved.
       std::bind(&CFWiFiManagerHelper::_saveParameters, this));
+  _wifiManager.setWebServerCallback(  // Define callback when the portal web server is set up.
+      std::bind(&CFWiFiManagerHelper::_webServerCallback, this));
   std::vector<const char *> menu = {"wifi",     // Config Wi-Fi.
                                     "param",    // Config Params.
                                     "info",     // Wi-Fi info.
                                     "update",   // Firmware update.
+                                    "custom",   // Compressed firmware update.
                                     "sep",      // Separator.
                                     "restart",  // Restart device.
                                     "exit",     // Exit portal.
                                     "sep",      // Separator.
                                     "erase"};   // Erase device data.
   _wifiManager.setMenu(menu);
+  _wifiManager.setCustomMenuHTML(CF_WM_UPDATE_MENU_HTML);
   _wifiManager.setConfigPortalTimeout(30);  // Auto close config portal timeout.
   _wifiManager.setClass("invert");          // Dark theme.
 
@@ -93,7 +167,6 @@ void CFWiFiManagerHelper::begin() {
     _wifiIP = WiFi.localIP().toString();
     _wifiManager.setHttpPort(_customPort);
     _wifiManager.startWebPortal();
-    _wifiServer.begin();
     _wifiConnected = true;
   }
 }
@@ -129,15 +202,16 @@ void CFWiFiManagerHelper::_loadParameters() {
       File file = SPIFFS.open(_fileSystemPath, "r");
       if (file) {
         // Create a JSON Object.
-        DynamicJsonDocument jsonParams(1024);
+        CFJsonScratch jsonParams(CF_WM_PARAMS_DOC_SIZE, CFJsonArenaAllocator("wifimanager"));
 
         // Deserialize file into JSON object.
+        unsigned long start = micros();
         DeserializationError error = deserializeJson(jsonParams, file);
-        /*
+        file.close();
         if (error) {
-            // Fail deserializing file. Code: 'error.c_str()'
+          CF_LOG_WARNING("Fail loading parameters: %s. Increase CF_WM_PARAMS_DOC_SIZE if it's NoMemory.", error.c_str());
+          return;
         }
-        */
 
         // Set custom parameters.
         for (int i = 0; i < _maxParamsQty; i++) {
@@ -147,6 +221,7 @@ void CFWiFiManagerHelper::_loadParameters() {
             _wifiManagerParameters[i].setValue(value.c_str(), _wifiManagerParameters[i].getValueLength());
           }
         }
+        CF_LOG_VERBOSE("Parameters loaded in %lu us (%u bytes of JSON memory).", micros() - start, jsonParams.memoryUsage());
       }
     }
   }
@@ -154,23 +229,33 @@ void CFWiFiManagerHelper::_loadParameters() {
 
 /**
  * Save parameters into file from WiFiManager.
+ * The file is kept as it is if they don't fit in the document, a truncated file would lose them.
  */
 void CFWiFiManagerHelper::_saveParameters() {
-  // Open file for writing.
-  File file = SPIFFS.open(_fileSystemPath, "w");
-  if (file) {
-    // Create JSON objects.
-    DynamicJsonDocument doc(1024);
+  // Create JSON objects.
+  unsigned long start = micros();
+  CFJsonScratch doc(CF_WM_PARAMS_DOC_SIZE, CFJsonArenaAllocator("wifimanager"));
 
-    // Set custom parameters.
-    for (int i = 0; i < _maxParamsQty; i++) {
-      doc[_wifiManagerParameters[i].getID()] = _wifiManagerParameters[i].getValue();
-    }
+  // Set custom parameters.
+  for (int i = 0; i < _maxParamsQty; i++) {
+    doc[_wifiManagerParameters[i].getID()] = _wifiManagerParameters[i].getValue();
+  }
 
+  if (_onSaveParametersCallback) {
     _onSaveParametersCallback();
+  }
+
+  if (doc.overflowed()) {
+    CF_LOG_WARNING("Parameters don't fit, they weren't saved. Increase CF_WM_PARAMS_DOC_SIZE.");
+    return;
+  }
 
+  // Open file for writing.
+  File file = SPIFFS.open(_fileSystemPath, "w");
+  if (file) {
     if (serializeJson(doc, file) != 0) {
       // Custom parameters saved.
+      CF_LOG_VERBOSE("Parameters saved in %lu us (%u bytes of JSON memory).", micros() - start, doc.memoryUsage());
     }
 
     // Close file.
@@ -190,6 +275,77 @@ void CFWiFiManagerHelper::_APCallback(WiFiManager *wifiManager) {
   }
 }
 
+/**
+ * Portal web server callback.
+ * Adds the compressed firmware update to the portal, the upload is written to flash as it arrives.
+ *
+ *    curl -F "firmware=@firmware.bin.hs" "http://<ip>:<port>/cfupdate?md5=<firmware.bin md5>"
+ */
+void CFWiFiManagerHelper::_webServerCallback() {
+  _wifiManager.server->on(CF_WM_UPDATE_PATH, HTTP_GET,
+                          std::bind(&CFWiFiManagerHelper::_handleUpdate, this));
+  _wifiManager.server->on(CF_WM_UPDATE_PATH, HTTP_POST,
+                          std::bind(&CFWiFiManagerHelper::_handleUpdate, this),
+                          std::bind(&CFWiFiManagerHelper::_handleUpdateUpload, this));
+
+  // REST resources.
+  for (int i = 0; i < _restResourcesQty; i++) {
+    _wifiManager.server->on(String(CF_WM_REST_PATH) + _restResources[i].name, HTTP_GET,
+                            [this, i]() { _handleREST(i); });
+  }
+  _wifiManager.server->on(CF_WM_REST_PATH "device", HTTP_GET,
+                          std::bind(&CFWiFiManagerHelper::_handleREST, this, -1));
+  if (_deviceState) {
+    static const char *headers[] = {CF_WM_API_KEY_HEADER};
+    _wifiManager.server->collectHeaders(headers, 1);
+    _wifiManager.server->on(CF_WM_REST_PATH "state", std::bind(&CFWiFiManagerHelper::_handleState, this));
+  }
+}
+
+/**
+ * Handle firmware update page, or its result once the upload is done.
+ * The device restarts into the new firmware when it succeeds.
+ */
+void CFWiFiManagerHelper::_handleUpdate() {
+  if (_wifiManager.server->method() == HTTP_GET) {
+    _wifiManager.server->send_P(200, "text/html", CF_WM_UPDATE_PAGE_HTML);
+    return;
+  }
+
+  CFJsonScratch report(256, CFJsonArenaAllocator("wifimanager"));
+  _otaUpdate.getReport(report.to<JsonObject>());
+  char response[256];
+  serializeJson(report, response);
+  _wifiManager.server->send(_otaUpdate.isSuccess() ? 200 : 500, "application/json", response);
+
+  if (_otaUpdate.isSuccess()) {
+    delay(1000);
+    ESP.restart();
+  }
+}
+
+/**
+ * Handle firmware update upload, chunk by chunk.
+ */
+void CFWiFiManagerHelper::_handleUpdateUpload() {
+  HTTPUpload &upload = _wifiManager.server->upload();
+  switch (upload.status) {
+    case UPLOAD_FILE_START:
+      WiFiUDP::stopAll();
+      _otaUpdate.begin(_wifiManager.server->arg("md5"));
+      break;
+    case UPLOAD_FILE_WRITE:
+      _otaUpdate.write(upload.buf, upload.currentSize);
+      break;
+    case UPLOAD_FILE_END:
+      _otaUpdate.end();
+      break;
+    case UPLOAD_FILE_ABORTED:
+      _otaUpdate.abort();
+      break;
+  }
+}
+
 /**
  * Get parameter value from key.
  *
@@ -287,3 +443,119 @@ void CFWiFiManagerHelper::resetSettings() {
   SPIFFS.format();
   _wifiManager.resetSettings();
 }
+
+/**
+ * Serve a JSON resource at /api/<name> on the custom port.
+ * The callback fills the response document right when it's requested. Must be called before begin().
+ *
+ * @param name Resource name. It must live as long as the helper does.
+ * @param callback Callback that fills the resource.
+ * @returns True if it was added.
+ */
+bool CFWiFiManagerHelper::addRESTResource(const char *name, CollectDataCallback callback) {
+  if (_restResourcesQty >= CF_WM_REST_MAX_RESOURCES) {
+    CF_LOG_WARNING("Too many REST resources. Increase CF_WM_REST_MAX_RESOURCES.");
+    return false;
+  }
+  _restResources[_restResourcesQty].name = name;
+  _restResources[_restResourcesQty].callback = callback;
+  _restResourcesQty++;
+  return true;
+}
+
+/**
+ * Serve device state at /api/state on the custom port, and accept changes to it.
+ *
+ *    GET  /api/state                                  {"value": false}
+ *    POST /api/state?value=on  (X-API-Key: <api key>)  {"value": true}
+ *
+ * It's read-only until an API key is defined with setStateApiKey(). Must be called before begin().
+ *
+ * @param deviceState Device state.
+ */
+void CFWiFiManagerHelper::setDeviceState(CFDeviceState *deviceState) {
+  _deviceState = deviceState;
+}
+
+/**
+ * Define the API key that allows changing the device state at /api/state.
+ * Requests must send it in the X-API-Key header, in clear text over HTTP, so it must not be a cloud
+ * credential such as the ThingsBoard token.
+ *
+ * @param apiKey API key, empty to keep the state read-only.
+ */
+void CFWiFiManagerHelper::setStateApiKey(String apiKey) {
+  _stateApiKey = apiKey;
+}
+
+/**
+ * Handle REST resource request.
+ *
+ * @param resource Resource index, -1 for the device resource.
+ */
+void CFWiFiManagerHelper::_handleREST(int resource) {
+  CFJsonScratch doc(CF_WM_REST_DOC_SIZE, CFJsonArenaAllocator("wifimanager"));
+  JsonObject data = doc.to<JsonObject>();
+  if (resource < 0) {
+    data["uptime"] = millis();
+    data["free_heap"] = ESP.getFreeHeap();
+    data["heap_fragmentation"] = ESP.getHeapFragmentation();
+    data["rssi"] = WiFi.RSSI();
+    data["ssid"] = _wifiSSID.c_str();
+    data["ip"] = _wifiIP.c_str();
+  } else {
+    _restResources[resource].callback(data);
+  }
+  _sendJson(200, doc);
+}
+
+/**
+ * Handle device state request.
+ * Every argument of a POST request is set into the property of the same name, if it has the API key.
+ */
+void CFWiFiManagerHelper::_handleState() {
+  CFJsonScratch doc(CF_WM_REST_DOC_SIZE, CFJsonArenaAllocator("wifimanager"));
+  if (_wifiManager.server->method() == HTTP_POST) {
+    if (_stateApiKey.length() == 0) {
+      doc["error"] = "State is read-only.";
+      _sendJson(403, doc);
+      return;
+    }
+    if (_wifiManager.server->header(CF_WM_API_KEY_HEADER) != _stateApiKey) {
+      CF_LOG_WARNING("State change refused, invalid API key.");
+      doc["error"] = "Invalid API key.";
+      _sendJson(401, doc);
+      return;
+    }
+    for (int i = 0; i < _wifiManager.server->args(); i++) {
+      const String &name = _wifiManager.server->argName(i);
+      if (name == "plain") continue;
+      int property = _deviceState->find(name.c_str());
+      if (property < 0 || !_deviceState->setFromString(property, _wifiManager.server->arg(i).c_str())) {
+        doc["error"] = "Invalid property or value.";
+        doc["property"] = name.c_str();
+        _sendJson(400, doc);
+        return;
+      }
+    }
+  }
+  _deviceState->getSnapshot(doc.to<JsonObject>());
+  _sendJson(200, doc);
+}
+
+/**
+ * Send a JSON response, serialized straight to the client.
+ *
+ * @param code HTTP status code.
+ * @param doc Response document.
+ */
+void CFWiFiManagerHelper::_sendJson(int code, JsonDocument &doc) {
+  if (doc.overflowed()) {
+    CF_LOG_WARNING("REST response truncated. Increase CF_WM_REST_DOC_SIZE.");
+  }
+  _wifiManager.server->setContentLength(measureJson(doc));
+  _wifiManager.server->send(code, "application/json", emptyString);
+  CFWMClientWriter writer(_wifiManager.server->client());
+  serializeJson(doc, writer);
+  writer.flush();
+}
@@ -11,21 +11,46 @@
 #ifndef CFWiFiManagerHelper_h
 #define CFWiFiManagerHelper_h
 
-#include <ArduinoJson.h>  // Arduino JSON.
-#include <WiFiManager.h>  // Wi-Fi Manager.
+#include <ArduinoJson.h>    // Arduino JSON.
+#include <CFDeviceState.h>  // CF Device State.
+#include <CFJsonArena.h>    // CF JSON Arena.
+#include <CFOTAUpdate.h>    // CF OTA Update.
+#include <WiFiManager.h>    // Wi-Fi Manager.
+
+#ifndef CF_WM_REST_MAX_RESOURCES
+#define CF_WM_REST_MAX_RESOURCES 8  // Max REST resources quantity.
+#endif
+
+#ifndef CF_WM_PARAMS_DOC_SIZE
+#define CF_WM_PARAMS_DOC_SIZE 1024  // Custom parameters document capacity.
+#endif
+
+#ifndef CF_WM_REST_DOC_SIZE
+#define CF_WM_REST_DOC_SIZE 1024  // REST response document capacity.
+#endif
 
 class CFWiFiManagerHelper {
  private:
   // Aliases.
   using VoidCallback = void (*)();                        // Alias for callback.
-  using CollectDataCallback = DynamicJsonDocument (*)();  // Alias for no input parameter callback returns JSON.
+  using CollectDataCallback = void (*)(JsonObject data);  // Alias for callback that fills a JSON object.
 
-  // WiFiManager and WiFiServer attributes.
+  // WiFiManager attributes.
   int _maxParamsQty;                             // Max parameters quantity.
   WiFiManagerParameter *_wifiManagerParameters;  // WIFiManager parameters.
   WiFiManager _wifiManager;                      // WiFiManager.
-  int _customPort;                               // Custom port.
-  WiFiServer _wifiServer;                        // Wi-Fi Server.
+  int _customPort;                               // Custom port, shared by the portal and the REST resources.
+  CFOTAUpdate _otaUpdate;                        // Compressed firmware update.
+
+  // REST resources.
+  struct RESTResource {
+    const char *name;              // Name, served at /api/<name>.
+    CollectDataCallback callback;  // Callback that fills it.
+  };
+  RESTResource _restResources[CF_WM_REST_MAX_RESOURCES];  // REST resources.
+  uint8_t _restResourcesQty;                              // REST resources quantity.
+  CFDeviceState *_deviceState;                            // Device state served at /api/state.
+  String _stateApiKey;                                    // API key that allows changing the device state, empty for read-only.
 
   // Config attributes.
   String _fileSystemPath;  // Path to store configs.
@@ -43,7 +68,13 @@ class CFWiFiManagerHelper {
   void _saveParameters();  // Save parameters into file from WiFiManager.
 
   // Inner callbacks.
-  void _APCallback(WiFiManager *wifiManager);  // Callback when AP Mode is connected.
+  void _APCallback(WiFiManager *wifiManager);   // Callback when AP Mode is connected.
+  void _webServerCallback();                    // Callback when the portal web server is set up.
+  void _handleUpdate();                         // Handle firmware update page and result.
+  void _handleUpdateUpload();                   // Handle firmware update upload.
+  void _handleREST(int resource);               // Handle REST resource request.
+  void _handleState();                          // Handle device state request.
+  void _sendJson(int code, JsonDocument &doc);  // Send a JSON response.
 
   // Available callbacks.
   VoidCallback _onConfigModeCallback;      // On save parameters callback.
@@ -68,6 +99,9 @@ class CFWiFiManagerHelper {
   void setOnConfigModeCallback(const VoidCallback);                      // Define on config mode callback.
   void setOnSaveParametersCallback(const VoidCallback);                  // Define on save parameters callback.
   void resetSettings();                                                  // Hard reset config.
+  bool addRESTResource(const char *name, CollectDataCallback callback);  // Serve a JSON resource at /api/<name>.
+  void setDeviceState(CFDeviceState *deviceState);                       // Serve and accept device state at /api/state.
+  void setStateApiKey(String apiKey);                                    // Define the API key that allows changing the device state.
 };
 
 #endif